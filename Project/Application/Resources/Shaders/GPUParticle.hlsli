@@ -0,0 +1,260 @@
+//CPU側のGPUParticleKernelsと同じ計算順にするため、計算結果を入れる変数はpreciseにして積和の融合を防ぐ
+
+//ConstantBuffers.hのGPUParticleと同じ並び
+struct GPUParticle
+{
+    float32_t3 translation;
+    float32_t lifeTime;
+    float32_t3 velocity;
+    float32_t currentTime;
+    float32_t3 scale;
+    float32_t alpha;
+    float32_t4 rotation;
+    float32_t4 color;
+};
+
+struct ParticleForGPU
+{
+    float32_t3 translation;
+    float32_t3 scale;
+    float32_t4 rotation;
+    float32_t4 color;
+};
+
+struct Emitter
+{
+    float32_t3 translation;
+    uint32_t popCount;
+    float32_t3 minPopArea;
+    uint32_t seed;
+    float32_t3 maxPopArea;
+    float32_t minPopAzimuth;
+    float32_t3 minPopRotation;
+    float32_t maxPopAzimuth;
+    float32_t3 maxPopRotation;
+    float32_t minPopElevation;
+    float32_t3 minPopScale;
+    float32_t maxPopElevation;
+    float32_t3 maxPopScale;
+    float32_t minPopLifeTime;
+    float32_t3 minPopVelocity;
+    float32_t maxPopLifeTime;
+    float32_t3 maxPopVelocity;
+    float32_t lifeTimeScale;
+    float32_t4 minPopColor;
+    float32_t4 maxPopColor;
+    float32_t4 popQuaternion;
+};
+
+struct Simulation
+{
+    float32_t3 acceleration;
+    int32_t isAccelerationEnable;
+    float32_t3 accelerationMin;
+    float32_t deltaTime;
+    float32_t3 accelerationMax;
+    float32_t timeScale;
+    float32_t3 gravityCenter;
+    int32_t isGravityEnable;
+    float32_t3 gravityMin;
+    float32_t gravityStrength;
+    float32_t3 gravityMax;
+    float32_t gravityStopDistance;
+    uint32_t maxParticleCount;
+    uint32_t vertexCount;
+    float32_t2 padding;
+};
+
+ConstantBuffer<Emitter> gEmitter : register(b0);
+ConstantBuffer<Simulation> gSimulation : register(b1);
+
+//生成したパーティクルを追加して移動させる前のパーティクル
+RWStructuredBuffer<GPUParticle> gSourceParticles : register(u0);
+//移動させて生き残ったパーティクル
+RWStructuredBuffer<GPUParticle> gDestinationParticles : register(u1);
+//描画用のデータ
+RWStructuredBuffer<ParticleForGPU> gInstances : register(u2);
+//[0]が今いる数、[1]が移動後に生き残った数
+RWStructuredBuffer<uint32_t> gCounters : register(u3);
+//D3D12_DRAW_ARGUMENTS
+RWStructuredBuffer<uint32_t> gDrawArguments : register(u4);
+
+static const uint32_t kThreadGroupSize = 256;
+
+//PCGハッシュ
+uint32_t Hash(uint32_t value)
+{
+    uint32_t state = value * 747796405u + 2891336453u;
+    uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+//状態を進めて[0,1)の一様乱数を返す
+float32_t NextRandom(inout uint32_t state)
+{
+    state = Hash(state);
+    precise float32_t result = float32_t(state >> 8) * (1.0f / 16777216.0f);
+    return result;
+}
+
+float32_t GetRandomFloat(float32_t minimum, float32_t maximum, inout uint32_t state)
+{
+    precise float32_t result = minimum + (maximum - minimum) * NextRandom(state);
+    return result;
+}
+
+//Mathf::MakeRotateAxisAngleQuaternionと同じ計算順
+float32_t4 MakeRotateAxisAngleQuaternion(float32_t3 axis, float32_t angle)
+{
+    precise float32_t halfAngle = angle / 2.0f;
+    precise float32_t s = sin(halfAngle);
+    precise float32_t4 result = float32_t4(axis * s, cos(halfAngle));
+    return result;
+}
+
+//Quaternion::operator*と同じ計算順
+float32_t4 MultiplyQuaternion(float32_t4 lhs, float32_t4 rhs)
+{
+    precise float32_t4 result;
+    result.x = lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y;
+    result.y = lhs.w * rhs.y - lhs.x * rhs.z + lhs.y * rhs.w + lhs.z * rhs.x;
+    result.z = lhs.w * rhs.z + lhs.x * rhs.y - lhs.y * rhs.x + lhs.z * rhs.w;
+    result.w = lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z;
+    return result;
+}
+
+//Mathf::MakeRotateQuaternionと同じ計算順
+float32_t4 MakeRotateQuaternion(float32_t3 rotate)
+{
+    float32_t4 rotateX = MakeRotateAxisAngleQuaternion(float32_t3(1.0f, 0.0f, 0.0f), rotate.x);
+    float32_t4 rotateY = MakeRotateAxisAngleQuaternion(float32_t3(0.0f, 1.0f, 0.0f), rotate.y);
+    float32_t4 rotateZ = MakeRotateAxisAngleQuaternion(float32_t3(0.0f, 0.0f, 1.0f), rotate.z);
+    return MultiplyQuaternion(MultiplyQuaternion(rotateZ, rotateY), rotateX);
+}
+
+//index番目のスレッドが生成するパーティクル(ParticleEmitter::Popと同じ順番で乱数を使う)
+GPUParticle MakeParticle(uint32_t index)
+{
+    //スレッドごとに独立した乱数の系列を作る
+    uint32_t state = Hash(index + Hash(gEmitter.seed));
+    GPUParticle particle;
+
+    //座標
+    precise float32_t3 translation;
+    translation.x = gEmitter.translation.x + GetRandomFloat(gEmitter.minPopArea.x, gEmitter.maxPopArea.x, state);
+    translation.y = gEmitter.translation.y + GetRandomFloat(gEmitter.minPopArea.y, gEmitter.maxPopArea.y, state);
+    translation.z = gEmitter.translation.z + GetRandomFloat(gEmitter.minPopArea.z, gEmitter.maxPopArea.z, state);
+    particle.translation = translation;
+
+    //回転
+    float32_t3 rotation;
+    rotation.x = GetRandomFloat(gEmitter.minPopRotation.x, gEmitter.maxPopRotation.x, state);
+    rotation.y = GetRandomFloat(gEmitter.minPopRotation.y, gEmitter.maxPopRotation.y, state);
+    rotation.z = GetRandomFloat(gEmitter.minPopRotation.z, gEmitter.maxPopRotation.z, state);
+
+    //スケール
+    particle.scale.x = GetRandomFloat(gEmitter.minPopScale.x, gEmitter.maxPopScale.x, state);
+    particle.scale.y = GetRandomFloat(gEmitter.minPopScale.y, gEmitter.maxPopScale.y, state);
+    particle.scale.z = GetRandomFloat(gEmitter.minPopScale.z, gEmitter.maxPopScale.z, state);
+
+    //方位角と仰角(CPU側のfloat(pi/180)と同じ値)
+    const float32_t kDegreeToRadian = 0.0174532925f;
+    float32_t azimuth = GetRandomFloat(gEmitter.minPopAzimuth, gEmitter.maxPopAzimuth, state);
+    precise float32_t azimuthRadian = azimuth * kDegreeToRadian;
+    float32_t elevation = GetRandomFloat(gEmitter.minPopElevation, gEmitter.maxPopElevation, state);
+    precise float32_t elevationRadian = elevation * kDegreeToRadian;
+
+    //速度
+    precise float32_t3 velocity;
+    if (azimuth != 0.0f || elevation != 0.0f)
+    {
+        velocity.x = GetRandomFloat(gEmitter.minPopVelocity.x, gEmitter.maxPopVelocity.x, state) * cos(elevationRadian) * cos(azimuthRadian);
+        velocity.y = GetRandomFloat(gEmitter.minPopVelocity.y, gEmitter.maxPopVelocity.y, state) * cos(elevationRadian) * sin(azimuthRadian);
+        velocity.z = GetRandomFloat(gEmitter.minPopVelocity.z, gEmitter.maxPopVelocity.z, state) * sin(elevationRadian);
+    }
+    else
+    {
+        velocity.x = GetRandomFloat(gEmitter.minPopVelocity.x, gEmitter.maxPopVelocity.x, state);
+        velocity.y = GetRandomFloat(gEmitter.minPopVelocity.y, gEmitter.maxPopVelocity.y, state);
+        velocity.z = GetRandomFloat(gEmitter.minPopVelocity.z, gEmitter.maxPopVelocity.z, state);
+    }
+    particle.velocity = velocity;
+
+    //色
+    particle.color.x = GetRandomFloat(gEmitter.minPopColor.x, gEmitter.maxPopColor.x, state);
+    particle.color.y = GetRandomFloat(gEmitter.minPopColor.y, gEmitter.maxPopColor.y, state);
+    particle.color.z = GetRandomFloat(gEmitter.minPopColor.z, gEmitter.maxPopColor.z, state);
+    particle.color.w = GetRandomFloat(gEmitter.minPopColor.w, gEmitter.maxPopColor.w, state);
+    particle.alpha = particle.color.w;
+
+    //寿命
+    precise float32_t lifeTime = GetRandomFloat(gEmitter.minPopLifeTime, gEmitter.maxPopLifeTime, state) * gEmitter.lifeTimeScale;
+    particle.lifeTime = lifeTime;
+    particle.currentTime = 0.0f;
+
+    //角度が指定されていればクォータニオンより優先する
+    particle.rotation = any(rotation != float32_t3(0.0f, 0.0f, 0.0f)) ? MakeRotateQuaternion(rotation) : gEmitter.popQuaternion;
+
+    return particle;
+}
+
+bool IsCollision(float32_t3 minimum, float32_t3 maximum, float32_t3 position)
+{
+    return all(minimum <= position) && all(maximum >= position);
+}
+
+//ParticlePool::UpdateParticleと同じ計算順で移動させて、生きていればtrueを返す
+bool UpdateParticle(inout GPUParticle particle)
+{
+    float32_t timeScale = gSimulation.timeScale;
+    float32_t3 translation = particle.translation;
+    precise float32_t3 velocity = particle.velocity;
+
+    //加速フィールドの判定
+    if (gSimulation.isAccelerationEnable && IsCollision(gSimulation.accelerationMin, gSimulation.accelerationMax, translation))
+    {
+        velocity = velocity + gSimulation.acceleration * timeScale;
+    }
+
+    //重力フィールドの判定
+    if (gSimulation.isGravityEnable && IsCollision(gSimulation.gravityMin, gSimulation.gravityMax, translation))
+    {
+        //距離を計算
+        precise float32_t3 sub = gSimulation.gravityCenter - translation;
+        precise float32_t distance = sqrt(sub.x * sub.x + sub.y * sub.y + sub.z * sub.z);
+
+        //中心に近づいたら速度を0にする
+        if (distance < gSimulation.gravityStopDistance)
+        {
+            velocity = float32_t3(0.0f, 0.0f, 0.0f);
+        }
+        else if (distance != 0.0f)
+        {
+            velocity = velocity + sub / distance * gSimulation.gravityStrength * timeScale;
+        }
+    }
+
+    //移動処理
+    precise float32_t3 newTranslation = translation + velocity * timeScale;
+    particle.translation = newTranslation;
+    particle.velocity = velocity;
+
+    //寿命を減らす
+    precise float32_t currentTime = particle.currentTime + gSimulation.deltaTime;
+    precise float32_t alpha = particle.alpha - (currentTime / particle.lifeTime);
+    particle.currentTime = currentTime;
+    particle.color.w = alpha;
+
+    //寿命が生存時間を上回ったら消す
+    return !(particle.lifeTime < currentTime);
+}
+
+ParticleForGPU MakeInstance(GPUParticle particle)
+{
+    ParticleForGPU instance;
+    instance.translation = particle.translation;
+    instance.scale = particle.scale;
+    instance.rotation = particle.rotation;
+    instance.color = particle.color;
+    return instance;
+}
\ No newline at end of file
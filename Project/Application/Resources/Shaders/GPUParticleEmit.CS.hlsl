@@ -0,0 +1,19 @@
+#include "GPUParticle.hlsli"
+
+//popCount個のパーティクルを今いるパーティクルの後ろに追加する
+[numthreads(kThreadGroupSize, 1, 1)]
+void main(uint32_t3 dispatchThreadId : SV_DispatchThreadID)
+{
+    if (dispatchThreadId.x >= gEmitter.popCount)
+    {
+        return;
+    }
+
+    //加算前の値を書き込む番号にする(最大数を超えた分は書き込まない)
+    uint32_t index;
+    InterlockedAdd(gCounters[0], 1, index);
+    if (index < gSimulation.maxParticleCount)
+    {
+        gSourceParticles[index] = MakeParticle(dispatchThreadId.x);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#include "GPUParticle.hlsli"
+
+//描画の引数を書き込んで次のフレームのためにカウンターを進める
+[numthreads(1, 1, 1)]
+void main(uint32_t3 dispatchThreadId : SV_DispatchThreadID)
+{
+    //頂点数、インスタンス数、開始頂点、開始インスタンスの順
+    gDrawArguments[0] = gSimulation.vertexCount;
+    gDrawArguments[1] = gCounters[1];
+    gDrawArguments[2] = 0;
+    gDrawArguments[3] = 0;
+
+    //生き残った数を次のフレームの今いる数にする
+    gCounters[0] = gCounters[1];
+    gCounters[1] = 0;
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#include "GPUParticle.hlsli"
+
+//パーティクルを移動させて、生き残ったパーティクルと描画用のデータを前に詰めて書き込む
+[numthreads(kThreadGroupSize, 1, 1)]
+void main(uint32_t3 dispatchThreadId : SV_DispatchThreadID)
+{
+    //生成で最大数を超えた分は数えない
+    uint32_t count = min(gCounters[0], gSimulation.maxParticleCount);
+    if (dispatchThreadId.x >= count)
+    {
+        return;
+    }
+
+    GPUParticle particle = gSourceParticles[dispatchThreadId.x];
+    if (UpdateParticle(particle))
+    {
+        uint32_t index;
+        InterlockedAdd(gCounters[1], 1, index);
+        gDestinationParticles[index] = particle;
+        gInstances[index] = MakeInstance(particle);
+    }
+}
\ No newline at end of file
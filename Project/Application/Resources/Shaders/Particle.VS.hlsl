@@ -2,7 +2,9 @@
 
 struct ParticleForGPU
 {
-    float32_t4x4 world;
+    float32_t3 translation;
+    float32_t3 scale;
+    float32_t4 rotation;
     float32_t4 color;
 };
 
@@ -13,7 +15,13 @@ struct Camera
     float32_t4x4 projection;
 };
 
+struct Particle
+{
+    int32_t isBillboard;
+};
+
 StructuredBuffer<ParticleForGPU> gParticle : register(t0);
+ConstantBuffer<Particle> gParticleSettings : register(b0);
 ConstantBuffer<Camera> gCamera : register(b1);
 
 struct VertexShaderInput
@@ -23,13 +31,36 @@ struct VertexShaderInput
     float32_t3 normal : NORMAL0;
 };
 
+//クォータニオンでベクトルを回転させる
+float32_t3 RotateVector(float32_t3 v, float32_t4 q)
+{
+    float32_t3 t = 2.0f * cross(q.xyz, v);
+    return v + q.w * t + cross(q.xyz, t);
+}
+
 VertexShaderOutput main(VertexShaderInput input, uint32_t instanceId : SV_InstanceID)
 {
     VertexShaderOutput output;
-    output.position = mul(input.position, mul(gParticle[instanceId].world, mul(gCamera.view, gCamera.projection)));
+    ParticleForGPU particle = gParticle[instanceId];
+    float32_t3 position = input.position.xyz * particle.scale;
+    float32_t3 normal = input.normal * particle.scale;
+    if (gParticleSettings.isBillboard)
+    {
+        //ビュー行列の回転部分の転置がカメラの回転になる
+        float32_t3x3 billboardMatrix = transpose((float32_t3x3) gCamera.view);
+        position = mul(position, billboardMatrix);
+        normal = mul(normal, billboardMatrix);
+    }
+    else
+    {
+        position = RotateVector(position, particle.rotation);
+        normal = RotateVector(normal, particle.rotation);
+    }
+    float32_t4 worldPosition = float32_t4(position + particle.translation, 1.0f);
+    output.position = mul(worldPosition, mul(gCamera.view, gCamera.projection));
     output.texcoord = input.texcoord;
-    output.normal = normalize(mul(input.normal, (float32_t3x3) gParticle[instanceId].world));
-    output.color = gParticle[instanceId].color;
+    output.normal = normalize(normal);
+    output.color = particle.color;
 
     return output;
-}
\ No newline at end of file
+}
@@ -0,0 +1,59 @@
+#include "BenchmarkFramework.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace Benchmark
+{
+	namespace
+	{
+		//最低でもこの時間とこの回数は繰り返して最短時間を取る
+		const double kMinTotalTime = 0.25;
+		const uint32_t kMinRepeatCount = 3;
+		const uint32_t kMaxRepeatCount = 1000;
+
+		const void* volatile sink = nullptr;
+	}
+
+	std::vector<BenchmarkCase>& GetBenchmarkCases()
+	{
+		//他の翻訳単位の静的変数から登録されるので関数内の静的変数にする
+		static std::vector<BenchmarkCase> benchmarkCases{};
+		return benchmarkCases;
+	}
+
+	Registrar::Registrar(const char* name, void (*function)())
+	{
+		GetBenchmarkCases().push_back({ name,function });
+	}
+
+	double Measure(const char* label, uint64_t elementCount, const std::function<void()>& function)
+	{
+		//1回目はキャッシュやメモリの確保が入るので計測しない
+		function();
+
+		double bestTime = 0.0;
+		double totalTime = 0.0;
+		for (uint32_t repeat = 0; repeat < kMaxRepeatCount; ++repeat)
+		{
+			auto start = std::chrono::steady_clock::now();
+			function();
+			double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			bestTime = repeat == 0 ? time : (std::min)(bestTime, time);
+			totalTime += time;
+			if (repeat + 1 >= kMinRepeatCount && totalTime >= kMinTotalTime)
+			{
+				break;
+			}
+		}
+
+		double elementsPerSecond = bestTime > 0.0 ? double(elementCount) / bestTime : 0.0;
+		std::printf("  %-56s %12.4f ms %12.2f M/s\n", label, bestTime * 1000.0, elementsPerSecond / 1000000.0);
+		return bestTime * 1000.0;
+	}
+
+	void DoNotOptimize(const void* pointer)
+	{
+		sink = pointer;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+//ウィンドウやGPUを使わずにエンジンの処理時間を計測するための最小限の仕組み
+namespace Benchmark
+{
+	struct BenchmarkCase
+	{
+		const char* name;
+		void (*function)();
+	};
+
+	//登録されている全てのベンチマーク
+	std::vector<BenchmarkCase>& GetBenchmarkCases();
+
+	//静的変数の初期化でベンチマークを登録する
+	struct Registrar
+	{
+		Registrar(const char* name, void (*function)());
+	};
+
+	//functionを繰り返し実行して1回あたりの最短時間をミリ秒で返す(結果は表示もする)
+	//elementCountは1回で処理する要素数で、1秒あたりの処理数の表示に使う
+	double Measure(const char* label, uint64_t elementCount, const std::function<void()>& function);
+
+	//計算結果を使ったことにして最適化で処理が消されないようにする
+	void DoNotOptimize(const void* pointer);
+}
+
+#define BENCHMARK_CASE(name) \
+	static void name(); \
+	static Benchmark::Registrar name##Registrar(#name, name); \
+	static void name()
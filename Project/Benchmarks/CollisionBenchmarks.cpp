@@ -0,0 +1,324 @@
+#include "BenchmarkFramework.h"
+#include "ReferenceSAT.h"
+#include "Engine/Components/Collision/CollisionManager.h"
+#include "Engine/Math/MathFunction.h"
+#include "Engine/Utilities/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <thread>
+
+namespace
+{
+	//当たった回数だけ数えるコライダー
+	class BenchmarkCollider : public Collider
+	{
+	public:
+		void OnCollision([[maybe_unused]] Collider* collider) override { ++hitCount_; };
+
+		const Vector3 GetWorldPosition() const override { return worldTransform_.translation_; };
+
+		const WorldTransform& GetWorldTransform() const override { return worldTransform_; };
+
+		void SetTranslation(const Vector3& translation)
+		{
+			worldTransform_.translation_ = translation;
+			worldTransform_.matWorld_.m[3][0] = translation.x;
+			worldTransform_.matWorld_.m[3][1] = translation.y;
+			worldTransform_.matWorld_.m[3][2] = translation.z;
+		};
+
+		WorldTransform worldTransform_{};
+
+		uint32_t hitCount_ = 0;
+	};
+
+	enum Distribution
+	{
+		//立方体の中に一様に置く
+		kDistributionUniform,
+		//いくつかの塊に集める
+		kDistributionClustered,
+	};
+
+	//数が増えても密度が変わらないように範囲を広げて置く
+	std::vector<std::unique_ptr<BenchmarkCollider>> MakeColliders(uint32_t count, Distribution distribution, uint32_t primitive, uint32_t seed)
+	{
+		std::mt19937 randomEngine(seed);
+		float halfExtent = 2.0f * std::cbrt(float(count));
+		std::uniform_real_distribution<float> positionDistribution(-halfExtent, halfExtent);
+		std::uniform_real_distribution<float> sizeDistribution(0.25f, 1.0f);
+		std::uniform_real_distribution<float> angleDistribution(-3.14f, 3.14f);
+		std::normal_distribution<float> clusterDistribution(0.0f, halfExtent * 0.1f);
+		const uint32_t kClusterCount = 8;
+		Vector3 clusterCenters[kClusterCount]{};
+		for (Vector3& center : clusterCenters)
+		{
+			center = { positionDistribution(randomEngine),positionDistribution(randomEngine),positionDistribution(randomEngine) };
+		}
+
+		std::vector<std::unique_ptr<BenchmarkCollider>> colliders{};
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			std::unique_ptr<BenchmarkCollider> collider = std::make_unique<BenchmarkCollider>();
+			Vector3 translation{};
+			if (distribution == kDistributionUniform)
+			{
+				translation = { positionDistribution(randomEngine),positionDistribution(randomEngine),positionDistribution(randomEngine) };
+			}
+			else
+			{
+				const Vector3& center = clusterCenters[i % kClusterCount];
+				translation = { center.x + clusterDistribution(randomEngine),center.y + clusterDistribution(randomEngine),center.z + clusterDistribution(randomEngine) };
+			}
+			Vector3 rotation = { angleDistribution(randomEngine),angleDistribution(randomEngine),angleDistribution(randomEngine) };
+			collider->worldTransform_.matWorld_ = Mathf::MakeAffineMatrix(Vector3{ 1.0f,1.0f,1.0f }, rotation, translation);
+			collider->worldTransform_.translation_ = translation;
+
+			float size = sizeDistribution(randomEngine);
+			AABB aabb = { {-size,-size,-size},{size,size,size} };
+			OBB obb = { {0.0f,0.0f,0.0f},{{1.0f,0.0f,0.0f},{0.0f,1.0f,0.0f},{0.0f,0.0f,1.0f}},{size,size * 0.5f,size} };
+			collider->SetRadius(size);
+			collider->SetAABB(aabb);
+			collider->SetOBB(obb);
+
+			//2種類の形状を指定された場合は1つずつ交互に割り当てる
+			uint32_t firstPrimitive = primitive & (~primitive + 1);
+			uint32_t secondPrimitive = primitive != firstPrimitive ? primitive & ~firstPrimitive : primitive;
+			collider->SetCollisionPrimitive(i % 2 == 0 ? firstPrimitive : secondPrimitive);
+			colliders.push_back(std::move(collider));
+		}
+		return colliders;
+	}
+
+	//毎フレーム登録しなおす使い方で1フレーム分判定する
+	void CheckFrame(CollisionManager& collisionManager, std::vector<std::unique_ptr<BenchmarkCollider>>& colliders)
+	{
+		collisionManager.ClearColliderList();
+		for (std::unique_ptr<BenchmarkCollider>& collider : colliders)
+		{
+			collisionManager.SetColliderList(collider.get());
+		}
+		collisionManager.CheckAllCollisions();
+	}
+
+	const char* GetBroadPhaseName(CollisionManager::BroadPhaseType broadPhaseType)
+	{
+		switch (broadPhaseType)
+		{
+		case CollisionManager::kBroadPhaseBruteForce:
+			return "brute force";
+		case CollisionManager::kBroadPhaseDynamicAABBTree:
+			return "tree";
+		default:
+			return "hash";
+		}
+	}
+}
+
+BENCHMARK_CASE(CollisionBroadPhaseSweep)
+{
+	//総当たりはO(n^2)なので5000個までにする
+	const uint32_t kCounts[] = { 100,1000,5000,20000 };
+	const uint32_t kMaxBruteForceCount = 5000;
+	const CollisionManager::BroadPhaseType kBroadPhaseTypes[] = {
+		CollisionManager::kBroadPhaseBruteForce,
+		CollisionManager::kBroadPhaseDynamicAABBTree,
+		CollisionManager::kBroadPhaseSpatialHash,
+	};
+	const char* kDistributionNames[] = { "uniform","clustered" };
+
+	for (Distribution distribution : { kDistributionUniform,kDistributionClustered })
+	{
+		for (uint32_t count : kCounts)
+		{
+			std::vector<std::unique_ptr<BenchmarkCollider>> colliders = MakeColliders(count, distribution, kCollisionPrimitiveSphere | kCollisionPrimitiveAABB, count);
+			for (CollisionManager::BroadPhaseType broadPhaseType : kBroadPhaseTypes)
+			{
+				if (broadPhaseType == CollisionManager::kBroadPhaseBruteForce && count > kMaxBruteForceCount)
+				{
+					continue;
+				}
+
+				//ブロードフェーズの差だけを見るためにシングルスレッドで計測する
+				CollisionManager collisionManager{};
+				collisionManager.SetIsMultithreaded(false);
+				collisionManager.SetBroadPhaseType(broadPhaseType);
+				char label[128]{};
+				std::snprintf(label, sizeof(label), "%s %s %u colliders", GetBroadPhaseName(broadPhaseType), kDistributionNames[distribution], count);
+				Benchmark::Measure(label, count, [&]() { CheckFrame(collisionManager, colliders); });
+			}
+		}
+	}
+}
+
+BENCHMARK_CASE(CollisionThreadScaling)
+{
+	std::vector<std::unique_ptr<BenchmarkCollider>> colliders = MakeColliders(20000, kDistributionClustered, kCollisionPrimitiveSphere | kCollisionPrimitiveOBB, 1);
+	uint32_t maxThreadCount = (std::max)(std::thread::hardware_concurrency(), 1u);
+	for (uint32_t threadCount = 1; threadCount <= maxThreadCount; ++threadCount)
+	{
+		ThreadPool::GetInstance()->SetThreadCount(threadCount);
+		CollisionManager collisionManager{};
+		collisionManager.SetIsMultithreaded(threadCount > 1);
+		char label[128]{};
+		std::snprintf(label, sizeof(label), "tree clustered 20000 colliders %u threads", threadCount);
+		Benchmark::Measure(label, colliders.size(), [&]() { CheckFrame(collisionManager, colliders); });
+	}
+	ThreadPool::Destroy();
+}
+
+BENCHMARK_CASE(CollisionNarrowPhase)
+{
+	//密集させて総当たりで判定し、ほぼ全てのペアを形状の判定まで進める(+は2種類を半分ずつ混ぜる)
+	const struct
+	{
+		const char* name;
+		uint32_t primitive;
+	} kPrimitiveCases[] = {
+		{ "sphere-sphere",kCollisionPrimitiveSphere },
+		{ "AABB-AABB",kCollisionPrimitiveAABB },
+		{ "sphere+AABB",kCollisionPrimitiveSphere | kCollisionPrimitiveAABB },
+		{ "sphere+OBB",kCollisionPrimitiveSphere | kCollisionPrimitiveOBB },
+		{ "AABB+OBB",kCollisionPrimitiveAABB | kCollisionPrimitiveOBB },
+		{ "OBB-OBB",kCollisionPrimitiveOBB },
+	};
+	const uint32_t kCount = 2000;
+	for (const auto& primitiveCase : kPrimitiveCases)
+	{
+		std::vector<std::unique_ptr<BenchmarkCollider>> colliders = MakeColliders(kCount, kDistributionClustered, primitiveCase.primitive, 2);
+		CollisionManager collisionManager{};
+		collisionManager.SetIsMultithreaded(false);
+		collisionManager.SetBroadPhaseType(CollisionManager::kBroadPhaseBruteForce);
+		char label[128]{};
+		std::snprintf(label, sizeof(label), "%s %u colliders (pairs)", primitiveCase.name, kCount);
+		Benchmark::Measure(label, uint64_t(kCount) * (kCount - 1) / 2, [&]() { CheckFrame(collisionManager, colliders); });
+	}
+}
+
+BENCHMARK_CASE(CollisionSATReference)
+{
+	//ランダムな箱のペアを置き換える前の分離軸判定と今の判定で比べる(半分程度が当たるように置く)
+	const uint32_t kPairCount = 100000;
+	std::mt19937 randomEngine(5);
+	std::uniform_real_distribution<float> positionDistribution(-2.0f, 2.0f);
+	std::uniform_real_distribution<float> sizeDistribution(0.25f, 1.5f);
+	std::uniform_real_distribution<float> quaternionDistribution(-1.0f, 1.0f);
+	auto makeOBB = [&]()
+		{
+			Quaternion quaternion = Mathf::Normalize(Quaternion(quaternionDistribution(randomEngine), quaternionDistribution(randomEngine), quaternionDistribution(randomEngine), quaternionDistribution(randomEngine)));
+			Matrix4x4 rotateMatrix = Mathf::MakeRotateMatrix(quaternion);
+			OBB obb{};
+			obb.center = { positionDistribution(randomEngine),positionDistribution(randomEngine),positionDistribution(randomEngine) };
+			for (uint32_t i = 0; i < 3; ++i)
+			{
+				obb.orientations[i] = { rotateMatrix.m[i][0],rotateMatrix.m[i][1],rotateMatrix.m[i][2] };
+			}
+			obb.size = { sizeDistribution(randomEngine),sizeDistribution(randomEngine),sizeDistribution(randomEngine) };
+			return obb;
+		};
+	std::vector<OBB> obbsA(kPairCount);
+	std::vector<OBB> obbsB(kPairCount);
+	std::vector<AABB> aabbs(kPairCount);
+	for (uint32_t i = 0; i < kPairCount; ++i)
+	{
+		obbsA[i] = makeOBB();
+		obbsB[i] = makeOBB();
+		aabbs[i] = { obbsA[i].center - obbsA[i].size,obbsA[i].center + obbsA[i].size };
+	}
+
+	CollisionManager collisionManager{};
+	std::vector<uint8_t> hits(kPairCount);
+	std::vector<uint8_t> referenceHits(kPairCount);
+	auto measure = [&](const char* label, std::vector<uint8_t>& results, const auto& check)
+		{
+			Benchmark::Measure(label, kPairCount, [&]()
+				{
+					for (uint32_t i = 0; i < kPairCount; ++i)
+					{
+						results[i] = check(i);
+					}
+					Benchmark::DoNotOptimize(results.data());
+				});
+		};
+	auto report = [&](const char* name)
+		{
+			uint32_t hitCount = uint32_t(std::count(hits.begin(), hits.end(), uint8_t(1)));
+			uint32_t mismatchCount = 0;
+			for (uint32_t i = 0; i < kPairCount; ++i)
+			{
+				mismatchCount += hits[i] != referenceHits[i] ? 1 : 0;
+			}
+			std::printf("  %s: %u / %u pairs hit, %u mismatched with the reference\n", name, hitCount, kPairCount, mismatchCount);
+		};
+
+	measure("OBB-OBB CheckCollisionOBB", hits, [&](uint32_t i) { return collisionManager.CheckCollisionOBB(obbsA[i], obbsB[i]); });
+	measure("OBB-OBB reference LenSegOnSeparateAxis", referenceHits, [&](uint32_t i) { return ReferenceSAT::CheckCollisionOBB(obbsA[i], obbsB[i]); });
+	report("OBB-OBB");
+
+	measure("AABB-OBB CheckCollisionAABBOBB", hits, [&](uint32_t i) { return collisionManager.CheckCollisionAABBOBB(aabbs[i], obbsB[i]); });
+	measure("AABB-OBB reference LenSegOnSeparateAxis", referenceHits, [&](uint32_t i) { return ReferenceSAT::CheckCollisionAABBOBB(aabbs[i], obbsB[i]); });
+	report("AABB-OBB");
+}
+
+BENCHMARK_CASE(CollisionPersistentRegistration)
+{
+	//ほとんどが動かない地形で、一部だけが毎フレーム動く
+	const uint32_t kCount = 20000;
+	const uint32_t kMoverCount = 200;
+	const CollisionManager::BroadPhaseType kBroadPhaseTypes[] = {
+		CollisionManager::kBroadPhaseDynamicAABBTree,
+		CollisionManager::kBroadPhaseSpatialHash,
+	};
+	for (CollisionManager::BroadPhaseType broadPhaseType : kBroadPhaseTypes)
+	{
+		std::vector<std::unique_ptr<BenchmarkCollider>> colliders = MakeColliders(kCount, kDistributionUniform, kCollisionPrimitiveSphere | kCollisionPrimitiveAABB, 3);
+		uint32_t frame = 0;
+		auto moveColliders = [&](bool isRegistered)
+			{
+				++frame;
+				for (uint32_t i = 0; i < kMoverCount; ++i)
+				{
+					BenchmarkCollider* collider = colliders[i * (kCount / kMoverCount)].get();
+					Vector3 translation = collider->worldTransform_.translation_;
+					translation.x += (frame % 2 == 0) ? 0.5f : -0.5f;
+					collider->SetTranslation(translation);
+					if (isRegistered)
+					{
+						collider->SetIsDirty(true);
+					}
+				}
+			};
+
+		char label[128]{};
+		CollisionManager rebuildManager{};
+		rebuildManager.SetIsMultithreaded(false);
+		rebuildManager.SetBroadPhaseType(broadPhaseType);
+		std::snprintf(label, sizeof(label), "%s rebuild every frame %u colliders %u movers", GetBroadPhaseName(broadPhaseType), kCount, kMoverCount);
+		Benchmark::Measure(label, kCount, [&]()
+			{
+				moveColliders(false);
+				CheckFrame(rebuildManager, colliders);
+			});
+
+		CollisionManager registeredManager{};
+		registeredManager.SetIsMultithreaded(false);
+		registeredManager.SetBroadPhaseType(broadPhaseType);
+		for (std::unique_ptr<BenchmarkCollider>& collider : colliders)
+		{
+			registeredManager.RegisterCollider(collider.get());
+		}
+		std::snprintf(label, sizeof(label), "%s registered %u colliders %u movers", GetBroadPhaseName(broadPhaseType), kCount, kMoverCount);
+		Benchmark::Measure(label, kCount, [&]()
+			{
+				moveColliders(true);
+				registeredManager.CheckAllCollisions();
+			});
+		for (std::unique_ptr<BenchmarkCollider>& collider : colliders)
+		{
+			registeredManager.UnregisterCollider(collider.get());
+		}
+	}
+}
\ No newline at end of file
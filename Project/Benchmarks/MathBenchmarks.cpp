@@ -0,0 +1,284 @@
+#include "BenchmarkFramework.h"
+#include "Engine/Math/MathFunction.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+	//キャッシュに収まる数にして計算そのものの速さを測る
+	const uint32_t kElementCount = 4096;
+
+	struct MathInputs
+	{
+		std::vector<Matrix4x4> matrices;
+		std::vector<Vector3> scales;
+		std::vector<Quaternion> quaternions;
+		std::vector<Vector3> translations;
+		std::vector<Vector3> vectors;
+	};
+
+	MathInputs MakeMathInputs(uint32_t count)
+	{
+		std::mt19937 randomEngine(count);
+		std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> scaleDistribution(0.5f, 2.0f);
+		std::uniform_real_distribution<float> translationDistribution(-100.0f, 100.0f);
+		MathInputs inputs{};
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			Vector3 scale = { scaleDistribution(randomEngine),scaleDistribution(randomEngine),scaleDistribution(randomEngine) };
+			Quaternion quaternion = Mathf::Normalize(Quaternion(distribution(randomEngine), distribution(randomEngine), distribution(randomEngine), distribution(randomEngine)));
+			Vector3 translation = { translationDistribution(randomEngine),translationDistribution(randomEngine),translationDistribution(randomEngine) };
+			inputs.scales.push_back(scale);
+			inputs.quaternions.push_back(quaternion);
+			inputs.translations.push_back(translation);
+			inputs.matrices.push_back(Mathf::MakeAffineMatrix(scale, quaternion, translation));
+			inputs.vectors.push_back({ translationDistribution(randomEngine),translationDistribution(randomEngine),translationDistribution(randomEngine) });
+		}
+		return inputs;
+	}
+}
+
+BENCHMARK_CASE(MathKernels)
+{
+	MathInputs inputs = MakeMathInputs(kElementCount);
+	std::vector<Matrix4x4> matrices(kElementCount);
+	std::vector<Vector3> vectors(kElementCount);
+	std::vector<Quaternion> quaternions(kElementCount);
+
+	//隣の要素と組み合わせて依存関係のない計算を並べる
+	Benchmark::Measure("Matrix4x4 * Matrix4x4", kElementCount, [&]()
+		{
+			for (uint32_t i = 0; i < kElementCount; ++i)
+			{
+				matrices[i] = inputs.matrices[i] * inputs.matrices[(i + 1) % kElementCount];
+			}
+			Benchmark::DoNotOptimize(matrices.data());
+		});
+	Benchmark::Measure("Inverse", kElementCount, [&]()
+		{
+			for (uint32_t i = 0; i < kElementCount; ++i)
+			{
+				matrices[i] = Mathf::Inverse(inputs.matrices[i]);
+			}
+			Benchmark::DoNotOptimize(matrices.data());
+		});
+	Benchmark::Measure("Transpose", kElementCount, [&]()
+		{
+			for (uint32_t i = 0; i < kElementCount; ++i)
+			{
+				matrices[i] = Mathf::Transpose(inputs.matrices[i]);
+			}
+			Benchmark::DoNotOptimize(matrices.data());
+		});
+	Benchmark::Measure("Transform", kElementCount, [&]()
+		{
+			for (uint32_t i = 0; i < kElementCount; ++i)
+			{
+				vectors[i] = Mathf::Transform(inputs.vectors[i], inputs.matrices[i]);
+			}
+			Benchmark::DoNotOptimize(vectors.data());
+		});
+	Benchmark::Measure("TransformNormal", kElementCount, [&]()
+		{
+			for (uint32_t i = 0; i < kElementCount; ++i)
+			{
+				vectors[i] = Mathf::TransformNormal(inputs.vectors[i], inputs.matrices[i]);
+			}
+			Benchmark::DoNotOptimize(vectors.data());
+		});
+	Benchmark::Measure("Quaternion * Quaternion", kElementCount, [&]()
+		{
+			for (uint32_t i = 0; i < kElementCount; ++i)
+			{
+				quaternions[i] = inputs.quaternions[i] * inputs.quaternions[(i + 1) % kElementCount];
+			}
+			Benchmark::DoNotOptimize(quaternions.data());
+		});
+	Benchmark::Measure("RotateVector", kElementCount, [&]()
+		{
+			for (uint32_t i = 0; i < kElementCount; ++i)
+			{
+				vectors[i] = Mathf::RotateVector(inputs.vectors[i], inputs.quaternions[i]);
+			}
+			Benchmark::DoNotOptimize(vectors.data());
+		});
+	Benchmark::Measure("Slerp", kElementCount, [&]()
+		{
+			for (uint32_t i = 0; i < kElementCount; ++i)
+			{
+				quaternions[i] = Mathf::Slerp(inputs.quaternions[i], inputs.quaternions[(i + 1) % kElementCount], 0.3f);
+			}
+			Benchmark::DoNotOptimize(quaternions.data());
+		});
+	Benchmark::Measure("Nlerp", kElementCount, [&]()
+		{
+			for (uint32_t i = 0; i < kElementCount; ++i)
+			{
+				quaternions[i] = Mathf::Nlerp(inputs.quaternions[i], inputs.quaternions[(i + 1) % kElementCount], 0.3f);
+			}
+			Benchmark::DoNotOptimize(quaternions.data());
+		});
+}
+
+BENCHMARK_CASE(MathAffineInverse)
+{
+	//WorldTransformのように毎フレーム10000個のワールド行列と逆転置行列を作る
+	const uint32_t kTransformCount = 10000;
+	MathInputs inputs = MakeMathInputs(kTransformCount);
+	std::vector<Matrix4x4> worldMatrices(kTransformCount);
+	std::vector<Matrix4x4> inverseTransposeMatrices(kTransformCount);
+	auto measure = [&](const char* label, Matrix4x4(*inverseTranspose)(const Matrix4x4&, const Vector3&))
+		{
+			Benchmark::Measure(label, kTransformCount, [&]()
+				{
+					for (uint32_t i = 0; i < kTransformCount; ++i)
+					{
+						worldMatrices[i] = Mathf::MakeAffineMatrix(inputs.scales[i], inputs.quaternions[i], inputs.translations[i]);
+						inverseTransposeMatrices[i] = inverseTranspose(worldMatrices[i], inputs.scales[i]);
+					}
+					Benchmark::DoNotOptimize(inverseTransposeMatrices.data());
+				});
+		};
+	measure("world + Transpose(Inverse)", [](const Matrix4x4& m, const Vector3&) { return Mathf::Transpose(Mathf::Inverse(m)); });
+	measure("world + InverseTransposeAffine", [](const Matrix4x4& m, const Vector3&) { return Mathf::InverseTransposeAffine(m); });
+	measure("world + InverseTransposeAffine(scale)", [](const Matrix4x4& m, const Vector3& scale) { return Mathf::InverseTransposeAffine(m, scale); });
+
+	//カメラのビュー行列
+	Benchmark::Measure("camera Inverse(world)", kTransformCount, [&]()
+		{
+			for (uint32_t i = 0; i < kTransformCount; ++i)
+			{
+				worldMatrices[i] = Mathf::Inverse(Mathf::MakeAffineMatrix(Vector3{ 1.0f,1.0f,1.0f }, inputs.quaternions[i], inputs.translations[i]));
+			}
+			Benchmark::DoNotOptimize(worldMatrices.data());
+		});
+	Benchmark::Measure("camera MakeViewMatrix", kTransformCount, [&]()
+		{
+			for (uint32_t i = 0; i < kTransformCount; ++i)
+			{
+				worldMatrices[i] = Mathf::MakeViewMatrix(inputs.quaternions[i], inputs.translations[i]);
+			}
+			Benchmark::DoNotOptimize(worldMatrices.data());
+		});
+}
+
+BENCHMARK_CASE(MathBatchTransforms)
+{
+	//キャッシュに収まらない数で1要素ずつの呼び出しとまとめて処理する関数を比べる
+	const uint32_t kBatchCount = 100000;
+	MathInputs inputs = MakeMathInputs(kBatchCount);
+	const Matrix4x4& matrix = inputs.matrices[0];
+	std::vector<Vector3> vectors(kBatchCount);
+	std::vector<float> x(kBatchCount), y(kBatchCount), z(kBatchCount);
+	std::vector<float> outputX(kBatchCount), outputY(kBatchCount), outputZ(kBatchCount);
+	for (uint32_t i = 0; i < kBatchCount; ++i)
+	{
+		x[i] = inputs.vectors[i].x;
+		y[i] = inputs.vectors[i].y;
+		z[i] = inputs.vectors[i].z;
+	}
+	std::vector<Matrix4x4> matrices(kBatchCount);
+	std::vector<Matrix4x4> rhsMatrices(inputs.matrices.rbegin(), inputs.matrices.rend());
+	std::vector<Quaternion> quaternions(kBatchCount);
+	std::vector<Quaternion> targetQuaternions(inputs.quaternions.rbegin(), inputs.quaternions.rend());
+
+	Benchmark::Measure("Transform loop", kBatchCount, [&]()
+		{
+			for (uint32_t i = 0; i < kBatchCount; ++i)
+			{
+				vectors[i] = Mathf::Transform(inputs.vectors[i], matrix);
+			}
+			Benchmark::DoNotOptimize(vectors.data());
+		});
+	Benchmark::Measure("TransformPoints (AoS)", kBatchCount, [&]()
+		{
+			Mathf::TransformPoints(inputs.vectors, matrix, vectors);
+			Benchmark::DoNotOptimize(vectors.data());
+		});
+	Benchmark::Measure("TransformPoints (SoA)", kBatchCount, [&]()
+		{
+			Mathf::TransformPoints(x, y, z, matrix, outputX, outputY, outputZ);
+			Benchmark::DoNotOptimize(outputX.data());
+		});
+	Benchmark::Measure("TransformNormal loop", kBatchCount, [&]()
+		{
+			for (uint32_t i = 0; i < kBatchCount; ++i)
+			{
+				vectors[i] = Mathf::TransformNormal(inputs.vectors[i], matrix);
+			}
+			Benchmark::DoNotOptimize(vectors.data());
+		});
+	Benchmark::Measure("TransformNormals", kBatchCount, [&]()
+		{
+			Mathf::TransformNormals(inputs.vectors, matrix, vectors);
+			Benchmark::DoNotOptimize(vectors.data());
+		});
+
+	Benchmark::Measure("Matrix4x4 * parent loop", kBatchCount, [&]()
+		{
+			for (uint32_t i = 0; i < kBatchCount; ++i)
+			{
+				matrices[i] = inputs.matrices[i] * matrix;
+			}
+			Benchmark::DoNotOptimize(matrices.data());
+		});
+	Benchmark::Measure("MultiplyMatrices (parent)", kBatchCount, [&]()
+		{
+			Mathf::MultiplyMatrices(inputs.matrices, matrix, matrices);
+			Benchmark::DoNotOptimize(matrices.data());
+		});
+	Benchmark::Measure("Matrix4x4 * Matrix4x4 loop", kBatchCount, [&]()
+		{
+			for (uint32_t i = 0; i < kBatchCount; ++i)
+			{
+				matrices[i] = inputs.matrices[i] * rhsMatrices[i];
+			}
+			Benchmark::DoNotOptimize(matrices.data());
+		});
+	Benchmark::Measure("MultiplyMatrices (pairwise)", kBatchCount, [&]()
+		{
+			Mathf::MultiplyMatrices(inputs.matrices, rhsMatrices, matrices);
+			Benchmark::DoNotOptimize(matrices.data());
+		});
+	Benchmark::Measure("MakeAffineMatrix loop", kBatchCount, [&]()
+		{
+			for (uint32_t i = 0; i < kBatchCount; ++i)
+			{
+				matrices[i] = Mathf::MakeAffineMatrix(inputs.scales[i], inputs.quaternions[i], inputs.translations[i]);
+			}
+			Benchmark::DoNotOptimize(matrices.data());
+		});
+	Benchmark::Measure("MakeAffineMatrices", kBatchCount, [&]()
+		{
+			Mathf::MakeAffineMatrices(inputs.scales, inputs.quaternions, inputs.translations, matrices);
+			Benchmark::DoNotOptimize(matrices.data());
+		});
+
+	Benchmark::Measure("Slerp loop", kBatchCount, [&]()
+		{
+			for (uint32_t i = 0; i < kBatchCount; ++i)
+			{
+				quaternions[i] = Mathf::Slerp(inputs.quaternions[i], targetQuaternions[i], 0.3f);
+			}
+			Benchmark::DoNotOptimize(quaternions.data());
+		});
+	Benchmark::Measure("Slerp (batch)", kBatchCount, [&]()
+		{
+			Mathf::Slerp(inputs.quaternions, targetQuaternions, 0.3f, quaternions);
+			Benchmark::DoNotOptimize(quaternions.data());
+		});
+	Benchmark::Measure("Nlerp loop", kBatchCount, [&]()
+		{
+			for (uint32_t i = 0; i < kBatchCount; ++i)
+			{
+				quaternions[i] = Mathf::Nlerp(inputs.quaternions[i], targetQuaternions[i], 0.3f);
+			}
+			Benchmark::DoNotOptimize(quaternions.data());
+		});
+	Benchmark::Measure("Nlerp (batch)", kBatchCount, [&]()
+		{
+			Mathf::Nlerp(inputs.quaternions, targetQuaternions, 0.3f, quaternions);
+			Benchmark::DoNotOptimize(quaternions.data());
+		});
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include "BenchmarkFramework.h"
+#include "Engine/Components/Particle/ParticleEmitter.h"
+#include "Engine/Utilities/RadixSort.h"
+#include "Engine/Utilities/RandomGenerator.h"
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <random>
+
+namespace
+{
+	const uint32_t kParticleCounts[] = { 10000,100000,1000000 };
+
+	//計測中に消えないように寿命を長くしたパーティクルで埋める
+	void FillPool(ParticlePool& pool, uint32_t count)
+	{
+		std::mt19937 randomEngine(count);
+		std::uniform_real_distribution<float> positionDistribution(-50.0f, 50.0f);
+		std::uniform_real_distribution<float> velocityDistribution(-0.1f, 0.1f);
+		pool.Reserve(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			Vector3 translation = { positionDistribution(randomEngine),positionDistribution(randomEngine),positionDistribution(randomEngine) };
+			Vector3 velocity = { velocityDistribution(randomEngine),velocityDistribution(randomEngine),velocityDistribution(randomEngine) };
+			pool.Add(translation, { 0.0f,0.0f,0.0f }, { 0.0f,0.0f,0.0f,1.0f }, { 1.0f,1.0f,1.0f }, velocity, { 1.0f,1.0f,1.0f,1.0f }, 1.0e6f);
+		}
+	}
+}
+
+BENCHMARK_CASE(ParticleSimulate)
+{
+	AccelerationField accelerationField = { .acceleration{0.0f,-0.01f,0.0f},.area{{-50.0f,-50.0f,-50.0f},{50.0f,0.0f,50.0f}},.isEnable{true} };
+	GravityField gravityField = { .center{0.0f,0.0f,0.0f},.area{{-25.0f,-25.0f,-25.0f},{25.0f,25.0f,25.0f}},.strength{0.002f},.stopDistance{1.0f},.isEnable{true} };
+	const float kDeltaTime = 1.0f / 60.0f;
+	for (uint32_t count : kParticleCounts)
+	{
+		ParticlePool pool{};
+		FillPool(pool, count);
+		char label[128]{};
+		std::snprintf(label, sizeof(label), "SoA Simulate %u particles", count);
+		Benchmark::Measure(label, count, [&]()
+			{
+				AABB bounds = pool.Simulate(0, pool.GetCount(), accelerationField, gravityField, kDeltaTime);
+				Benchmark::DoNotOptimize(&bounds);
+			});
+
+		//SIMDを使わずに1つずつ更新した場合
+		std::snprintf(label, sizeof(label), "scalar UpdateParticle %u particles", count);
+		Benchmark::Measure(label, count, [&]()
+			{
+				for (uint32_t i = 0; i < pool.GetCount(); ++i)
+				{
+					pool.UpdateParticle(i, accelerationField, gravityField, kDeltaTime);
+				}
+				Benchmark::DoNotOptimize(&pool);
+			});
+	}
+}
+
+BENCHMARK_CASE(ParticleEmit)
+{
+	//毎フレームpopCount個生成し、同じ数が寿命で消える状態で1フレーム分更新する
+	const uint32_t kPopCounts[] = { 1000,10000,100000 };
+	for (uint32_t popCount : kPopCounts)
+	{
+		ParticleEmitter emitter{};
+		emitter.SetSeed(1);
+		emitter.SetPopArea({ -10.0f,-10.0f,-10.0f }, { 10.0f,10.0f,10.0f });
+		emitter.SetPopRotation({ -1.0f,-1.0f,-1.0f }, { 1.0f,1.0f,1.0f });
+		emitter.SetPopColor({ 0.0f,0.0f,0.0f,1.0f }, { 1.0f,1.0f,1.0f,1.0f });
+		emitter.SetPopLifeTime(0.1f, 0.1f);
+		emitter.SetPopFrequency(1.0f / 60.0f);
+		emitter.SetPopCount(popCount);
+		emitter.SetDeleteTime(1.0e6f);
+		char label[128]{};
+		std::snprintf(label, sizeof(label), "emitter Update %u spawned per frame", popCount);
+		Benchmark::Measure(label, popCount, [&]() { emitter.Update(1.0f / 60.0f); });
+	}
+}
+
+BENCHMARK_CASE(ParticleRandom)
+{
+	//パーティクルの生成に使う乱数の作り方ごとの速さ
+	const uint32_t kCount = 1000000;
+	std::vector<float> values(kCount);
+	RandomStream randomStream(1);
+	RandomGenerator::Initialize(1);
+	Benchmark::Measure("RandomStream::FillUniform", kCount, [&]()
+		{
+			randomStream.FillUniform(values.data(), values.size(), -1.0f, 1.0f);
+			Benchmark::DoNotOptimize(values.data());
+		});
+	Benchmark::Measure("RandomStream::NextFloat", kCount, [&]()
+		{
+			for (float& value : values)
+			{
+				value = randomStream.NextFloat(-1.0f, 1.0f);
+			}
+			Benchmark::DoNotOptimize(values.data());
+		});
+	Benchmark::Measure("RandomGenerator::GetRandomFloat (mt19937)", kCount, [&]()
+		{
+			for (float& value : values)
+			{
+				value = RandomGenerator::GetRandomFloat(-1.0f, 1.0f);
+			}
+			Benchmark::DoNotOptimize(values.data());
+		});
+}
+
+BENCHMARK_CASE(ParticleDepthSort)
+{
+	//奥から順に描画するための深度の並べ替え
+	for (uint32_t count : kParticleCounts)
+	{
+		std::mt19937 randomEngine(count);
+		std::uniform_real_distribution<float> depthDistribution(-100.0f, 100.0f);
+		std::vector<float> keys(count);
+		for (float& key : keys)
+		{
+			key = depthDistribution(randomEngine);
+		}
+
+		char label[128]{};
+		RadixSort radixSort{};
+		std::snprintf(label, sizeof(label), "RadixSort %u keys", count);
+		Benchmark::Measure(label, count, [&]()
+			{
+				const std::vector<uint32_t>& indices = radixSort.SortByFloatKey(keys.data(), count);
+				Benchmark::DoNotOptimize(indices.data());
+			});
+
+		std::vector<uint32_t> indices(count);
+		std::snprintf(label, sizeof(label), "std::stable_sort %u keys", count);
+		Benchmark::Measure(label, count, [&]()
+			{
+				std::iota(indices.begin(), indices.end(), 0);
+				std::stable_sort(indices.begin(), indices.end(), [&keys](uint32_t lhs, uint32_t rhs) { return keys[lhs] < keys[rhs]; });
+				Benchmark::DoNotOptimize(indices.data());
+			});
+		std::snprintf(label, sizeof(label), "std::sort %u keys", count);
+		Benchmark::Measure(label, count, [&]()
+			{
+				std::iota(indices.begin(), indices.end(), 0);
+				std::sort(indices.begin(), indices.end(), [&keys](uint32_t lhs, uint32_t rhs) { return keys[lhs] < keys[rhs]; });
+				Benchmark::DoNotOptimize(indices.data());
+			});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include "ReferenceSAT.h"
+#include "Engine/Math/MathFunction.h"
+#include <cmath>
+
+namespace ReferenceSAT
+{
+	bool CheckCollisionAABBOBB(const AABB& aabb, const OBB& obb)
+	{
+		Vector3 aabbCenter = (aabb.min + aabb.max) * 0.5f;
+
+		OBB aabbOBB = {
+			.center{aabbCenter},
+			.orientations{{1.0f,0.0f,0.0f},{0.0f,1.0f,0.0f},{0.0f,0.0f,1.0f}},
+			.size{0.5f * (aabb.max.x - aabb.min.x),0.5f * (aabb.max.y - aabb.min.y),0.5f * (aabb.max.z - aabb.min.z)},
+		};
+		return CheckCollisionOBB(aabbOBB, obb);
+	}
+
+	bool CheckCollisionOBB(const OBB& obbA, const OBB& obbB)
+	{
+		Vector3 NAe1 = obbA.orientations[0];
+		Vector3 Ae1 = NAe1 * obbA.size.x;
+		Vector3 NAe2 = obbA.orientations[1];
+		Vector3 Ae2 = NAe2 * obbA.size.y;
+		Vector3 NAe3 = obbA.orientations[2];
+		Vector3 Ae3 = NAe3 * obbA.size.z;
+
+		Vector3 NBe1 = obbB.orientations[0];
+		Vector3 Be1 = NBe1 * obbB.size.x;
+		Vector3 NBe2 = obbB.orientations[1];
+		Vector3 Be2 = NBe2 * obbB.size.y;
+		Vector3 NBe3 = obbB.orientations[2];
+		Vector3 Be3 = NBe3 * obbB.size.z;
+
+		Vector3 Interval = obbA.center - obbB.center;
+
+		//文理軸 Ae1
+		float rA = Mathf::Length(Ae1);
+		float rB = LenSegOnSeparateAxis(&NAe1, &Be1, &Be2, &Be3);
+		float L = fabs(Mathf::Dot(Interval, NAe1));
+		if (L > rA + rB)
+		{
+			return false;
+		}
+
+		// 分離軸 : Ae2
+		rA = Mathf::Length(Ae2);
+		rB = LenSegOnSeparateAxis(&NAe2, &Be1, &Be2, &Be3);
+		L = fabs(Mathf::Dot(Interval, NAe2));
+		if (L > rA + rB)
+		{
+			return false;
+		}
+
+		// 分離軸 : Ae3
+		rA = Mathf::Length(Ae3);
+		rB = LenSegOnSeparateAxis(&NAe3, &Be1, &Be2, &Be3);
+		L = fabs(Mathf::Dot(Interval, NAe3));
+		if (L > rA + rB)
+		{
+			return false;
+		}
+
+		// 分離軸 : Be1
+		rA = LenSegOnSeparateAxis(&NBe1, &Ae1, &Ae2, &Ae3);
+		rB = Mathf::Length(Be1);
+		L = fabs(Mathf::Dot(Interval, NBe1));
+		if (L > rA + rB)
+		{
+			return false;
+		}
+
+		// 分離軸 : Be2
+		rA = LenSegOnSeparateAxis(&NBe2, &Ae1, &Ae2, &Ae3);
+		rB = Mathf::Length(Be2);
+		L = fabs(Mathf::Dot(Interval, NBe2));
+		if (L > rA + rB)
+		{
+			return false;
+		}
+
+		// 分離軸 : Be3
+		rA = LenSegOnSeparateAxis(&NBe3, &Ae1, &Ae2, &Ae3);
+		rB = Mathf::Length(Be3);
+		L = fabs(Mathf::Dot(Interval, NBe3));
+		if (L > rA + rB)
+		{
+			return false;
+		}
+
+		// 分離軸 : C11
+		Vector3 Cross = Mathf::Cross(NAe1, NBe1);
+		rA = LenSegOnSeparateAxis(&Cross, &Ae2, &Ae3, 0);
+		rB = LenSegOnSeparateAxis(&Cross, &Be2, &Be3, 0);
+		L = fabs(Mathf::Dot(Interval, Cross));
+		if (L > rA + rB)
+		{
+			return false;
+		}
+
+		// 分離軸 : C12
+		Cross = Mathf::Cross(NAe1, NBe2);
+		rA = LenSegOnSeparateAxis(&Cross, &Ae2, &Ae3, 0);
+		rB = LenSegOnSeparateAxis(&Cross, &Be1, &Be3, 0);
+		L = fabs(Mathf::Dot(Interval, Cross));
+		if (L > rA + rB)
+		{
+			return false;
+		}
+
+		// 分離軸 : C13
+		Cross = Mathf::Cross(NAe1, NBe3);
+		rA = LenSegOnSeparateAxis(&Cross, &Ae2, &Ae3, 0);
+		rB = LenSegOnSeparateAxis(&Cross, &Be1, &Be2, 0);
+		L = fabs(Mathf::Dot(Interval, Cross));
+		if (L > rA + rB)
+		{
+			return false;
+		}
+
+		// 分離軸 : C21
+		Cross = Mathf::Cross(NAe2, NBe1);
+		rA = LenSegOnSeparateAxis(&Cross, &Ae1, &Ae3, 0);
+		rB = LenSegOnSeparateAxis(&Cross, &Be2, &Be3, 0);
+		L = fabs(Mathf::Dot(Interval, Cross));
+		if (L > rA + rB)
+		{
+			return false;
+		}
+
+		// 分離軸 : C22
+		Cross = Mathf::Cross(NAe2, NBe2);
+		rA = LenSegOnSeparateAxis(&Cross, &Ae1, &Ae3, 0);
+		rB = LenSegOnSeparateAxis(&Cross, &Be1, &Be3, 0);
+		L = fabs(Mathf::Dot(Interval, Cross));
+		if (L > rA + rB)
+		{
+			return false;
+		}
+
+		// 分離軸 : C23
+		Cross = Mathf::Cross(NAe2, NBe3);
+		rA = LenSegOnSeparateAxis(&Cross, &Ae1, &Ae3, 0);
+		rB = LenSegOnSeparateAxis(&Cross, &Be1, &Be2, 0);
+		L = fabs(Mathf::Dot(Interval, Cross));
+		if (L > rA + rB)
+		{
+			return false;
+		}
+
+		// 分離軸 : C31
+		Cross = Mathf::Cross(NAe3, NBe1);
+		rA = LenSegOnSeparateAxis(&Cross, &Ae1, &Ae2, 0);
+		rB = LenSegOnSeparateAxis(&Cross, &Be2, &Be3, 0);
+		L = fabs(Mathf::Dot(Interval, Cross));
+		if (L > rA + rB)
+		{
+			return false;
+		}
+
+		// 分離軸 : C32
+		Cross = Mathf::Cross(NAe3, NBe2);
+		rA = LenSegOnSeparateAxis(&Cross, &Ae1, &Ae2, 0);
+		rB = LenSegOnSeparateAxis(&Cross, &Be1, &Be3, 0);
+		L = fabs(Mathf::Dot(Interval, Cross));
+		if (L > rA + rB)
+		{
+			return false;
+		}
+
+		// 分離軸 : C33
+		Cross = Mathf::Cross(NAe3, NBe3);
+		rA = LenSegOnSeparateAxis(&Cross, &Ae1, &Ae2, 0);
+		rB = LenSegOnSeparateAxis(&Cross, &Be1, &Be2, 0);
+		L = fabs(Mathf::Dot(Interval, Cross));
+		if (L > rA + rB)
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+	float LenSegOnSeparateAxis(Vector3* Sep, Vector3* e1, Vector3* e2, Vector3* e3)
+	{
+		float r1 = fabs(Mathf::Dot(*Sep, *e1));
+		float r2 = fabs(Mathf::Dot(*Sep, *e2));
+		float r3 = e3 ? (fabs(Mathf::Dot(*Sep, *e3))) : 0;
+		return r1 + r2 + r3;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+#include "Engine/Math/AABB.h"
+#include "Engine/Math/OBB.h"
+
+//CollisionManagerの分離軸判定を置き換える前の実装(ベンチマークで速さと結果を比べるために残している)
+namespace ReferenceSAT
+{
+	//AABBを軸が座標軸のOBBとしてCheckCollisionOBBで判定する(置き換える前のCheckCollisionAABBOBBと同じ計算)
+	bool CheckCollisionAABBOBB(const AABB& aabb, const OBB& obb);
+
+	//15本の分離軸それぞれに両方の箱を投影して判定する
+	bool CheckCollisionOBB(const OBB& obbA, const OBB& obbB);
+
+	//分離軸に投影した線分の長さ(e3はnullptrでもよい)
+	float LenSegOnSeparateAxis(Vector3* Sep, Vector3* e1, Vector3* e2, Vector3* e3);
+}
@@ -0,0 +1,20 @@
+#include "BenchmarkFramework.h"
+#include <cstdio>
+#include <cstring>
+
+//引数を渡すと名前にその文字列を含むベンチマークだけ実行する
+int main(int argc, char* argv[])
+{
+	const char* filter = argc > 1 ? argv[1] : nullptr;
+	for (const Benchmark::BenchmarkCase& benchmarkCase : Benchmark::GetBenchmarkCases())
+	{
+		if (filter && std::strstr(benchmarkCase.name, filter) == nullptr)
+		{
+			continue;
+		}
+
+		std::printf("[%s]\n", benchmarkCase.name);
+		benchmarkCase.function();
+	}
+	return 0;
+}
\ No newline at end of file
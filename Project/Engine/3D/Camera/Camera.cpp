@@ -10,12 +10,13 @@ void Camera::Initialize()
 
 void Camera::UpdateViewMatrix()
 {
-	Matrix4x4 translateMatrix = Mathf::MakeTranslateMatrix(translation_);
-	Matrix4x4 rotateXMatrix = Mathf::MakeRotateXMatrix(rotation_.x);
-	Matrix4x4 rotateYMatrix = Mathf::MakeRotateYMatrix(rotation_.y);
-	Matrix4x4 rotateZMatrix = Mathf::MakeRotateZMatrix(rotation_.z);
-	Matrix4x4 rotateMatrix = rotateXMatrix * rotateYMatrix * rotateZMatrix;
-	matView_ = Mathf::Inverse(translateMatrix) * Mathf::Inverse(rotateMatrix);
+	//オイラー角は編集用なので、変わった時だけクォータニオンに変換する
+	if (rotation_ != cachedRotation_)
+	{
+		quaternion_ = Mathf::MakeRotateQuaternion(rotation_);
+		cachedRotation_ = rotation_;
+	}
+	matView_ = Mathf::MakeViewMatrix(quaternion_, translation_);
 }
 
 void Camera::UpdateProjectionMatrix()
@@ -1,6 +1,7 @@
 #pragma once
 #include "Engine/Base/UploadBuffer.h"
 #include "Engine/Base/ConstantBuffers.h"
+#include "Engine/Math/Quaternion.h"
 #include <memory>
 
 class Camera
@@ -37,6 +38,11 @@ public:
 private:
 	std::unique_ptr<UploadBuffer> constBuff_ = nullptr;
 
+	//quaternion_を作った時のオイラー角
+	Vector3 cachedRotation_ = { 0.0f,0.0f,0.0f };
+
+	Quaternion quaternion_ = { 0.0f,0.0f,0.0f,1.0f };
+
 public:
 	Vector3 rotation_ = { 0.0f,0.0f,0.0f };
 
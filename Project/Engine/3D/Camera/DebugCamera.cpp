@@ -31,7 +31,7 @@ void DebugCamera::Update() {
 	//ワールド行列を計算
 	worldTransform_.matWorld_ = matRot_ * translateMatrix;
 	//ビュー行列の計算
-	viewProjection_.matView_ = Mathf::Inverse(translateMatrix) * Mathf::Inverse(matRot_);
+	viewProjection_.matView_ = Mathf::InverseAffine(worldTransform_.matWorld_);
 	//プロジェクション行列の計算
 	viewProjection_.matProjection_ = Mathf::MakePerspectiveFovMatrix(viewProjection_.fov_, viewProjection_.aspectRatio_, viewProjection_.nearClip_, viewProjection_.farClip_);
 
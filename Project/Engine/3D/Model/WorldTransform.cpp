@@ -9,23 +9,39 @@ void WorldTransform::Initialize()
 }
 
 void WorldTransform::TransferMatrix()
+{
+	//親の拡縮でせん断が入ることもあるので行列から求める
+	TransferMatrix(Mathf::InverseTransposeAffine(matWorld_));
+}
+
+void WorldTransform::TransferMatrix(const Matrix4x4& worldInverseTranspose)
 {
 	ConstBuffDataWorldTransform* worldTransformData = static_cast<ConstBuffDataWorldTransform*>(constBuff_->Map());
 	worldTransformData->world = matWorld_;
-	worldTransformData->worldInverseTranspse = Mathf::Transpose(Mathf::Inverse(matWorld_));
+	worldTransformData->worldInverseTranspse = worldInverseTranspose;
 	constBuff_->Unmap();
 }
 
 void WorldTransform::UpdateMatrixFromEuler()
 {
-	matWorld_ = Mathf::MakeAffineMatrix(scale_, rotation_, translation_);
+	//オイラー角は変わった時だけクォータニオンに変換する
+	if (rotation_ != cachedRotation_)
+	{
+		rotationQuaternion_ = Mathf::MakeRotateQuaternion(rotation_);
+		cachedRotation_ = rotation_;
+	}
+	matWorld_ = Mathf::MakeAffineMatrix(scale_, rotationQuaternion_, translation_);
 
 	if (parent_) 
 	{
 		matWorld_ = matWorld_ * parent_->matWorld_;
+		TransferMatrix();
+	}
+	else
+	{
+		//親がいなければ拡縮*回転*平行移動の行列なので拡縮から逆転置行列を求める
+		TransferMatrix(Mathf::InverseTransposeAffine(matWorld_, scale_));
 	}
-
-	TransferMatrix();
 }
 
 void WorldTransform::UpdateMatrixFromQuaternion()
@@ -37,6 +53,7 @@ void WorldTransform::UpdateMatrixFromQuaternion()
 		matWorld_ = matWorld_ * parent_->matWorld_;
 	}
 
+	//quaternion_は外から直接書き換えられて単位クォータニオンとは限らないので行列から求める
 	TransferMatrix();
 }
 
@@ -35,9 +35,18 @@ public:
 		return *this;
 	}
 
+private:
+	void TransferMatrix(const Matrix4x4& worldInverseTranspose);
+
 private:
 	std::unique_ptr<UploadBuffer> constBuff_ = nullptr;
 
+	//rotationQuaternion_を作った時のオイラー角
+	Vector3 cachedRotation_ = { 0.0f,0.0f,0.0f };
+
+	//rotation_から作ったクォータニオン(quaternion_とは別に持つ)
+	Quaternion rotationQuaternion_ = { 0.0f,0.0f,0.0f,1.0f };
+
 public:
 	Vector3 scale_ = { 1.0f,1.0f,1.0f };
 
@@ -113,11 +113,63 @@ void CommandContext::SetPipelineState(const PipelineState& pipelineState)
 	commandList_->SetPipelineState(currentPipelineState_ = pipelineState.GetPipelineState());
 }
 
+void CommandContext::SetComputeRootSignature(const RootSignature& rootSignature)
+{
+	if (rootSignature.GetRootSignature() == currentComputeRootSignature_)
+	{
+		return;
+	}
+	commandList_->SetComputeRootSignature(currentComputeRootSignature_ = rootSignature.GetRootSignature());
+}
+
+void CommandContext::SetPipelineState(const ComputePipelineState& pipelineState)
+{
+	if (pipelineState.GetPipelineState() == currentPipelineState_)
+	{
+		return;
+	}
+	commandList_->SetPipelineState(currentPipelineState_ = pipelineState.GetPipelineState());
+}
+
+void CommandContext::SetComputeConstantBuffer(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS cbv)
+{
+	commandList_->SetComputeRootConstantBufferView(rootParameterIndex, cbv);
+}
+
+void CommandContext::SetComputeUnorderedAccessView(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS uav)
+{
+	commandList_->SetComputeRootUnorderedAccessView(rootParameterIndex, uav);
+}
+
 void CommandContext::DrawInstanced(UINT vertexCount, UINT instanceCount)
 {
 	commandList_->DrawInstanced(vertexCount, instanceCount, 0, 0);
 }
 
+void CommandContext::Dispatch(UINT threadGroupCountX, UINT threadGroupCountY, UINT threadGroupCountZ)
+{
+	commandList_->Dispatch(threadGroupCountX, threadGroupCountY, threadGroupCountZ);
+}
+
+void CommandContext::CopyBufferRegion(GpuResource& dest, size_t destOffset, GpuResource& src, size_t srcOffset, size_t numBytes)
+{
+	commandList_->CopyBufferRegion(dest.GetResource(), destOffset, src.GetResource(), srcOffset, numBytes);
+}
+
+void CommandContext::InsertUAVBarrier(GpuResource& resource)
+{
+	D3D12_RESOURCE_BARRIER barrier{};
+	barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+	barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+	barrier.UAV.pResource = resource.GetResource();
+	commandList_->ResourceBarrier(1, &barrier);
+}
+
+void CommandContext::ExecuteIndirect(ID3D12CommandSignature* commandSignature, GpuResource& argumentBuffer)
+{
+	commandList_->ExecuteIndirect(commandSignature, 1, argumentBuffer.GetResource(), 0, nullptr, 0);
+}
+
 void CommandContext::Close()
 {
 	HRESULT hr = commandList_->Close();
@@ -136,6 +188,11 @@ void CommandContext::Reset()
 		commandList_->SetGraphicsRootSignature(currentRootSignature_);
 	}
 
+	if (currentComputeRootSignature_)
+	{
+		commandList_->SetComputeRootSignature(currentComputeRootSignature_);
+	}
+
 	if (currentPipelineState_)
 	{
 		commandList_->SetPipelineState(currentPipelineState_);
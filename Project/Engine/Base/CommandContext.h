@@ -3,6 +3,7 @@
 #include "DepthBuffer.h"
 #include "RootSignature.h"
 #include "PipelineState.h"
+#include "ComputePipelineState.h"
 
 class CommandContext
 {
@@ -37,8 +38,26 @@ public:
 
 	void SetPipelineState(const PipelineState& pipelineState);
 
+	void SetComputeRootSignature(const RootSignature& rootSignature);
+
+	void SetPipelineState(const ComputePipelineState& pipelineState);
+
+	void SetComputeConstantBuffer(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS cbv);
+
+	void SetComputeUnorderedAccessView(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS uav);
+
 	void DrawInstanced(UINT vertexCount, UINT instanceCount);
 
+	void Dispatch(UINT threadGroupCountX, UINT threadGroupCountY, UINT threadGroupCountZ);
+
+	void CopyBufferRegion(GpuResource& dest, size_t destOffset, GpuResource& src, size_t srcOffset, size_t numBytes);
+
+	//UAVへの書き込みが終わるまで次の処理を待たせる
+	void InsertUAVBarrier(GpuResource& resource);
+
+	//引数をGPU上のバッファから読んで描画やディスパッチを行う
+	void ExecuteIndirect(ID3D12CommandSignature* commandSignature, GpuResource& argumentBuffer);
+
 	void Close();
 
 	void Reset();
@@ -55,6 +74,8 @@ protected:
 
 	ID3D12RootSignature* currentRootSignature_ = nullptr;
 
+	ID3D12RootSignature* currentComputeRootSignature_ = nullptr;
+
 	ID3D12PipelineState* currentPipelineState_ = nullptr;
 
 	ID3D12DescriptorHeap* currentDescriptorHeaps_[D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES];
@@ -0,0 +1,21 @@
+#include "ComputePipelineState.h"
+#include "GraphicsCore.h"
+#include <cassert>
+
+void ComputePipelineState::SetRootSignature(const RootSignature* rootSignature)
+{
+	rootSignature_ = rootSignature;
+}
+
+void ComputePipelineState::SetComputeShader(const void* binary, size_t size)
+{
+	pipelineStateDesc_.CS = { binary,size };
+}
+
+void ComputePipelineState::Finalize()
+{
+	pipelineStateDesc_.pRootSignature = rootSignature_->GetRootSignature();
+	ID3D12Device* device = GraphicsCore::GetInstance()->GetDevice();
+	HRESULT hr = device->CreateComputePipelineState(&pipelineStateDesc_, IID_PPV_ARGS(&pipelineState_));
+	assert(SUCCEEDED(hr));
+}
\ No newline at end of file
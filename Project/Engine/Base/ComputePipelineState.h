@@ -0,0 +1,21 @@
+#pragma once
+#include "RootSignature.h"
+
+class ComputePipelineState
+{
+public:
+	void SetRootSignature(const RootSignature* rootSignature);
+
+	void SetComputeShader(const void* binary, size_t size);
+
+	void Finalize();
+
+	ID3D12PipelineState* GetPipelineState() const { return pipelineState_.Get(); };
+
+private:
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState_ = nullptr;
+
+	D3D12_COMPUTE_PIPELINE_STATE_DESC pipelineStateDesc_{};
+
+	const RootSignature* rootSignature_ = nullptr;
+};
@@ -3,6 +3,7 @@
 #include "Engine/Math/Vector3.h"
 #include "Engine/Math/Vector4.h"
 #include "Engine/Math/Matrix4x4.h"
+#include "Engine/Math/Quaternion.h"
 #include <cstdint>
 
 struct VertexDataPosUVNormal 
@@ -78,10 +79,75 @@ struct ConstBuffDataSpotLight
 
 struct ParticleForGPU
 {
-	Matrix4x4 world;
+	Vector3 translation;
+	Vector3 scale;
+	Quaternion rotation;
 	Vector4 color;
 };
 
+struct ConstBuffDataParticle
+{
+	int32_t isBillboard;
+	float padding[3];
+};
+
+//GPUで移動させるパーティクル(GPUParticle.hlsliと同じ並び)
+struct GPUParticle
+{
+	Vector3 translation;
+	float lifeTime;
+	Vector3 velocity;
+	float currentTime;
+	Vector3 scale;
+	float alpha;
+	Quaternion rotation;
+	Vector4 color;
+};
+
+struct ConstBuffDataGPUParticleEmitter
+{
+	Vector3 translation;
+	uint32_t popCount;
+	Vector3 minPopArea;
+	uint32_t seed;
+	Vector3 maxPopArea;
+	float minPopAzimuth;
+	Vector3 minPopRotation;
+	float maxPopAzimuth;
+	Vector3 maxPopRotation;
+	float minPopElevation;
+	Vector3 minPopScale;
+	float maxPopElevation;
+	Vector3 maxPopScale;
+	float minPopLifeTime;
+	Vector3 minPopVelocity;
+	float maxPopLifeTime;
+	Vector3 maxPopVelocity;
+	float lifeTimeScale;
+	Vector4 minPopColor;
+	Vector4 maxPopColor;
+	Quaternion popQuaternion;
+};
+
+struct ConstBuffDataGPUParticleSimulation
+{
+	Vector3 acceleration;
+	int32_t isAccelerationEnable;
+	Vector3 accelerationMin;
+	float deltaTime;
+	Vector3 accelerationMax;
+	float timeScale;
+	Vector3 gravityCenter;
+	int32_t isGravityEnable;
+	Vector3 gravityMin;
+	float gravityStrength;
+	Vector3 gravityMax;
+	float gravityStopDistance;
+	uint32_t maxParticleCount;
+	uint32_t vertexCount;
+	float padding[2];
+};
+
 struct ConstBuffDataGaussianBlur
 {
 	int32_t textureWidth;
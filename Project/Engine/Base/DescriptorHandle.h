@@ -22,6 +22,8 @@ public:
 
 	operator D3D12_GPU_DESCRIPTOR_HANDLE() const { return gpuHandle_; };
 
+	bool IsNull() const { return cpuHandle_.ptr == 0; };
+
 private:
 	D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle_{};
 
@@ -26,6 +26,8 @@ void FrameRateController::Update()
 			std::this_thread::sleep_for(std::chrono::microseconds(1));
 		}
 	}
-	//現在の時間を記録する
-	reference_ = std::chrono::steady_clock::now();
+	//前回記録からの実際の経過時間を記録して現在の時間を記録する
+	now = std::chrono::steady_clock::now();
+	deltaTime_ = std::chrono::duration<float>(now - reference_).count();
+	reference_ = now;
 }
\ No newline at end of file
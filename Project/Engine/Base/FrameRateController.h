@@ -9,7 +9,12 @@ public:
 
 	void Update();
 
+	//前のフレームからの経過時間(秒)
+	const float GetDeltaTime() const { return deltaTime_; };
+
 private:
 	std::chrono::steady_clock::time_point reference_{};
+
+	float deltaTime_ = 1.0f / 60.0f;
 };
 
@@ -39,6 +39,8 @@ public:
 
 	CommandQueue* GetCommandQueue() const { return commandQueue_.get(); };
 
+	const float GetDeltaTime() const { return frameRateController_->GetDeltaTime(); };
+
 private:
 	GraphicsCore() = default;
 	~GraphicsCore() = default;
@@ -0,0 +1,70 @@
+#include "RWStructuredBuffer.h"
+#include "GraphicsCore.h"
+#include <cassert>
+
+void RWStructuredBuffer::Create(uint32_t numElements, uint32_t elementSize)
+{
+	Create(numElements, elementSize, false);
+}
+
+void RWStructuredBuffer::Create(uint32_t numElements, uint32_t elementSize, bool isShaderResource)
+{
+	ID3D12Device* device = GraphicsCore::GetInstance()->GetDevice();
+
+	elementCount_ = numElements;
+	elementSize_ = elementSize;
+	bufferSize_ = size_t(numElements) * elementSize;
+
+	currentState_ = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+
+	//リソース用のヒープの設定(GPUだけが触るのでDefaultHeapを使う)
+	D3D12_HEAP_PROPERTIES heapProperties{};
+	heapProperties.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+	//リソースの設定
+	D3D12_RESOURCE_DESC resourceDesc{};
+	resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+	resourceDesc.Width = bufferSize_;
+	//バッファの場合はこれらは1にする決まり
+	resourceDesc.Height = 1;
+	resourceDesc.DepthOrArraySize = 1;
+	resourceDesc.MipLevels = 1;
+	resourceDesc.SampleDesc.Count = 1;
+	//バッファの場合はこれにする決まり
+	resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+	//UAVとして書き込めるようにする
+	resourceDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+
+	//作成(CommittedResourceは0で初期化されている)
+	HRESULT hr = device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE,
+		&resourceDesc, currentState_, nullptr,
+		IID_PPV_ARGS(&resource_));
+	assert(SUCCEEDED(hr));
+
+	//GpuVirtualAddressの初期化
+	gpuVirtualAddress_ = resource_->GetGPUVirtualAddress();
+
+	if (isShaderResource)
+	{
+		CreateDerivedViews(device, numElements, elementSize);
+	}
+}
+
+void RWStructuredBuffer::CreateDerivedViews(ID3D12Device* device, uint32_t numElements, uint32_t elementSize)
+{
+	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+	srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
+	srvDesc.Buffer.FirstElement = 0;
+	srvDesc.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
+	srvDesc.Buffer.NumElements = numElements;
+	srvDesc.Buffer.StructureByteStride = UINT(elementSize);
+
+	//作り直す場合は同じディスクリプタに上書きする
+	if (srvHandle_.IsNull())
+	{
+		srvHandle_ = GraphicsCore::GetInstance()->AllocateDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	}
+	device->CreateShaderResourceView(resource_.Get(), &srvDesc, srvHandle_);
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+#include "GpuResource.h"
+#include "DescriptorHandle.h"
+#include <cstdint>
+
+//GPUだけが読み書きするStructuredBuffer(UAVはルートパラメーターに直接アドレスを設定して使う)
+class RWStructuredBuffer : public GpuResource
+{
+public:
+	void Create(uint32_t numElements, uint32_t elementSize);
+
+	//isShaderResourceがtrueの場合は描画で読むためのSRVも作る(カウンターなどはディスクリプタを使わない)
+	void Create(uint32_t numElements, uint32_t elementSize, bool isShaderResource);
+
+	const DescriptorHandle& GetSRVHandle() const { return srvHandle_; };
+
+	size_t GetBufferSize() const { return bufferSize_; };
+
+	const uint32_t GetElementCount() const { return elementCount_; };
+
+private:
+	void CreateDerivedViews(ID3D12Device* device, uint32_t numElements, uint32_t elementSize);
+
+private:
+	DescriptorHandle srvHandle_{};
+
+	size_t bufferSize_ = 0;
+
+	uint32_t elementCount_ = 0;
+
+	uint32_t elementSize_ = 0;
+};
@@ -51,6 +51,9 @@ void Renderer::Initialize()
 
 	//パーティクル用のPSOの作成
 	CreateParticlePipelineState();
+
+	//GPUパーティクル用のPSOの作成
+	CreateGPUParticlePipelineState();
 }
 
 void Renderer::AddObject(D3D12_VERTEX_BUFFER_VIEW vertexBufferView, D3D12_GPU_VIRTUAL_ADDRESS materialCBV, D3D12_GPU_VIRTUAL_ADDRESS worldTransformCBV,
@@ -203,6 +206,16 @@ void Renderer::PostDrawParticles() {
 
 }
 
+void Renderer::SetGPUParticlePipelineState(GPUParticleKernel kernel)
+{
+	//コマンドリストを取得
+	CommandContext* commandContext = GraphicsCore::GetInstance()->GetCommandContext();
+	//RootSignatureを設定
+	commandContext->SetComputeRootSignature(gpuParticleRootSignature_);
+	//PipelineStateを設定
+	commandContext->SetPipelineState(gpuParticlePipelineStates_[kernel]);
+}
+
 void Renderer::CreateModelPipelineState()
 {
 	//RootSignatureの作成
@@ -433,11 +446,12 @@ void Renderer::CreateSpritePipelineState()
 
 void Renderer::CreateParticlePipelineState()
 {
-	particleRootSignature_.Create(4, 1);
+	particleRootSignature_.Create(5, 1);
 	particleRootSignature_[0].InitAsConstantBuffer(0, D3D12_SHADER_VISIBILITY_PIXEL);
 	particleRootSignature_[1].InitAsDescriptorRange(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 0, 1, D3D12_SHADER_VISIBILITY_VERTEX);
 	particleRootSignature_[2].InitAsConstantBuffer(1, D3D12_SHADER_VISIBILITY_VERTEX);
 	particleRootSignature_[3].InitAsDescriptorRange(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 0, 1, D3D12_SHADER_VISIBILITY_PIXEL);
+	particleRootSignature_[4].InitAsConstantBuffer(0, D3D12_SHADER_VISIBILITY_VERTEX);
 
 	//StaticSamplerを設定
 	D3D12_STATIC_SAMPLER_DESC staticSamplers[1]{};
@@ -519,6 +533,50 @@ void Renderer::CreateParticlePipelineState()
 	particlePipelineStates_.push_back(newPipelineState);
 }
 
+void Renderer::CreateGPUParticlePipelineState()
+{
+	//UAVはディスクリプタを使わずにアドレスを直接設定する
+	gpuParticleRootSignature_.Create(7, 0);
+	gpuParticleRootSignature_[0].InitAsConstantBuffer(0, D3D12_SHADER_VISIBILITY_ALL);
+	gpuParticleRootSignature_[1].InitAsConstantBuffer(1, D3D12_SHADER_VISIBILITY_ALL);
+	gpuParticleRootSignature_[2].InitAsUnorderedAccessView(0, D3D12_SHADER_VISIBILITY_ALL);
+	gpuParticleRootSignature_[3].InitAsUnorderedAccessView(1, D3D12_SHADER_VISIBILITY_ALL);
+	gpuParticleRootSignature_[4].InitAsUnorderedAccessView(2, D3D12_SHADER_VISIBILITY_ALL);
+	gpuParticleRootSignature_[5].InitAsUnorderedAccessView(3, D3D12_SHADER_VISIBILITY_ALL);
+	gpuParticleRootSignature_[6].InitAsUnorderedAccessView(4, D3D12_SHADER_VISIBILITY_ALL);
+	gpuParticleRootSignature_.Finalize();
+
+	//GPUParticleKernelの順番に作る
+	const wchar_t* shaderNames[kCountOfGPUParticleKernel] = {
+		L"GPUParticleEmit.CS.hlsl",
+		L"GPUParticleSimulate.CS.hlsl",
+		L"GPUParticleFinish.CS.hlsl",
+	};
+	for (uint32_t i = 0; i < kCountOfGPUParticleKernel; ++i)
+	{
+		//Shaderをコンパイルする
+		Microsoft::WRL::ComPtr<IDxcBlob> computeShaderBlob = ShaderCompiler::CompileShader(shaderNames[i], L"cs_6_0");
+		assert(computeShaderBlob != nullptr);
+
+		ComputePipelineState newPipelineState;
+		newPipelineState.SetRootSignature(&gpuParticleRootSignature_);
+		newPipelineState.SetComputeShader(computeShaderBlob->GetBufferPointer(), computeShaderBlob->GetBufferSize());
+		newPipelineState.Finalize();
+		gpuParticlePipelineStates_.push_back(newPipelineState);
+	}
+
+	//引数がD3D12_DRAW_ARGUMENTSだけのコマンドシグネチャ
+	D3D12_INDIRECT_ARGUMENT_DESC argumentDesc{};
+	argumentDesc.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW;
+	D3D12_COMMAND_SIGNATURE_DESC commandSignatureDesc{};
+	commandSignatureDesc.ByteStride = sizeof(D3D12_DRAW_ARGUMENTS);
+	commandSignatureDesc.NumArgumentDescs = 1;
+	commandSignatureDesc.pArgumentDescs = &argumentDesc;
+	ID3D12Device* device = GraphicsCore::GetInstance()->GetDevice();
+	HRESULT hr = device->CreateCommandSignature(&commandSignatureDesc, nullptr, IID_PPV_ARGS(&particleCommandSignature_));
+	assert(SUCCEEDED(hr));
+}
+
 void Renderer::Sort()
 {
 	struct { bool operator()(const SortObject& a, const SortObject& b)const { return a.type < b.type; } } Cmp;
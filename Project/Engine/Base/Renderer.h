@@ -3,6 +3,7 @@
 #include "ColorBuffer.h"
 #include "DepthBuffer.h"
 #include "PipelineState.h"
+#include "ComputePipelineState.h"
 #include <vector>
 
 enum DrawPass
@@ -47,6 +48,18 @@ public:
 		kDirectionalLight,
 	};
 
+	enum GPUParticleKernel
+	{
+		//パーティクルの生成
+		kGPUParticleEmit,
+		//移動と死亡したパーティクルの削除
+		kGPUParticleSimulate,
+		//描画の引数の書き込み
+		kGPUParticleFinish,
+		//利用してはいけない
+		kCountOfGPUParticleKernel,
+	};
+
 	static Renderer* GetInstance();
 
 	static void Destroy();
@@ -79,6 +92,12 @@ public:
 
 	void PostDrawParticles();
 
+	//GPUでパーティクルを移動させるコンピュートシェーダーを設定する
+	void SetGPUParticlePipelineState(GPUParticleKernel kernel);
+
+	//GPUが書き込んだ引数で描画するためのコマンドシグネチャ
+	ID3D12CommandSignature* GetParticleCommandSignature() const { return particleCommandSignature_.Get(); };
+
 	const DescriptorHandle& GetSceneColorDescriptorHandle() const { return sceneColorBuffer_->GetSRVHandle(); };
 
 	const DescriptorHandle& GetLinearDepthDescriptorHandle() const { return linearDepthColorBuffer_->GetSRVHandle(); };
@@ -95,6 +114,8 @@ private:
 
 	void CreateParticlePipelineState();
 
+	void CreateGPUParticlePipelineState();
+
 	void Sort();
 
 private:
@@ -131,5 +152,11 @@ private:
 	std::vector<PipelineState> spritePipelineStates_{};
 
 	std::vector<PipelineState> particlePipelineStates_{};
+
+	RootSignature gpuParticleRootSignature_{};
+
+	std::vector<ComputePipelineState> gpuParticlePipelineStates_{};
+
+	Microsoft::WRL::ComPtr<ID3D12CommandSignature> particleCommandSignature_ = nullptr;
 };
 
@@ -7,6 +7,13 @@ void RootParameter::InitAsConstantBuffer(UINT registerNum, D3D12_SHADER_VISIBILI
 	rootParameter_.Descriptor.ShaderRegister = registerNum;
 }
 
+void RootParameter::InitAsUnorderedAccessView(UINT registerNum, D3D12_SHADER_VISIBILITY shaderVisibility)
+{
+	rootParameter_.ParameterType = D3D12_ROOT_PARAMETER_TYPE_UAV;
+	rootParameter_.ShaderVisibility = shaderVisibility;
+	rootParameter_.Descriptor.ShaderRegister = registerNum;
+}
+
 void RootParameter::InitAsDescriptorRange(D3D12_DESCRIPTOR_RANGE_TYPE type, UINT registerNum, UINT count, D3D12_SHADER_VISIBILITY shaderVisibility)
 {
 	InitAsDescriptorTable(1, shaderVisibility);
@@ -8,6 +8,8 @@ class RootParameter
 public:
 	void InitAsConstantBuffer(UINT registerNum, D3D12_SHADER_VISIBILITY shaderVisibility);
 
+	void InitAsUnorderedAccessView(UINT registerNum, D3D12_SHADER_VISIBILITY shaderVisibility);
+
 	void InitAsDescriptorRange(D3D12_DESCRIPTOR_RANGE_TYPE type, UINT registerNum, UINT count, D3D12_SHADER_VISIBILITY shaderVisibility);
 
 	void InitAsDescriptorTable(UINT rangeCount, D3D12_SHADER_VISIBILITY shaderVisibility);
@@ -47,7 +47,11 @@ void StructuredBuffer::CreateDerivedViews(ID3D12Device* device, uint32_t numElem
 	srvDesc.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
 	srvDesc.Buffer.NumElements = numElements;
 	srvDesc.Buffer.StructureByteStride = UINT(elementSize);
-	srvHandle_ = GraphicsCore::GetInstance()->AllocateDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	//作り直す場合は同じディスクリプタに上書きする
+	if (srvHandle_.IsNull())
+	{
+		srvHandle_ = GraphicsCore::GetInstance()->AllocateDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	}
 	device->CreateShaderResourceView(resource_.Get(), &srvDesc, srvHandle_);
 }
 
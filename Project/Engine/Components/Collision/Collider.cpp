@@ -0,0 +1,65 @@
+#include "Collider.h"
+#include "Engine/Math/MathFunction.h"
+
+std::atomic<uint32_t> Collider::nextColliderId_ = 0;
+
+Collider::Collider()
+{
+	//作成した順に番号を割り当てる
+	colliderId_ = nextColliderId_++;
+}
+
+Collider::Collider(const Collider& collider)
+{
+	colliderId_ = nextColliderId_++;
+	*this = collider;
+}
+
+Collider& Collider::operator=(const Collider& collider)
+{
+	//番号以外をコピーする
+	radius_ = collider.radius_;
+	aabb_ = collider.aabb_;
+	obb_ = collider.obb_;
+	collisionAttribute_ = collider.collisionAttribute_;
+	collisionMask_ = collider.collisionMask_;
+	collisionPrimitive_ = collider.collisionPrimitive_;
+	isContinuous_ = collider.isContinuous_;
+	hasPreviousWorldPosition_ = collider.hasPreviousWorldPosition_;
+	previousWorldPosition_ = collider.previousWorldPosition_;
+	timeOfImpact_ = collider.timeOfImpact_;
+	isDirty_ = true;
+	return *this;
+}
+
+const OBB Collider::GetWorldOBB() const
+{
+	const Matrix4x4& matWorld = GetWorldTransform().matWorld_;
+
+	OBB result = obb_;
+	result.center = GetWorldPosition() + Mathf::TransformNormal(obb_.center, matWorld);
+
+	//ワールド行列で軸を変換し、スケールは大きさに移す
+	Vector3 axes[3]{};
+	float lengths[3]{};
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		axes[i] = Mathf::TransformNormal(obb_.orientations[i], matWorld);
+		lengths[i] = Mathf::Length(axes[i]);
+	}
+
+	//行列が設定されていない場合はそのままの軸を使う
+	if (lengths[0] == 0.0f || lengths[1] == 0.0f || lengths[2] == 0.0f)
+	{
+		return result;
+	}
+
+	//非一様スケールで軸が直交しなくなることがあるので直交化する
+	result.orientations[0] = axes[0] / lengths[0];
+	Vector3 axisY = axes[1] - result.orientations[0] * Mathf::Dot(axes[1], result.orientations[0]);
+	result.orientations[1] = Mathf::Normalize(axisY);
+	result.orientations[2] = Mathf::Cross(result.orientations[0], result.orientations[1]);
+	result.size = { obb_.size.x * lengths[0],obb_.size.y * lengths[1],obb_.size.z * lengths[2] };
+
+	return result;
+}
@@ -3,45 +3,100 @@
 #include "Engine/Math/Sphere.h"
 #include "Engine/Math/AABB.h"
 #include "Engine/Math/OBB.h"
+#include <atomic>
 
 class Collider
 {
 public:
+	Collider();
+
+	//コピーしたコライダーは別のコライダーとして扱うので番号は新しく割り当てる
+	Collider(const Collider& collider);
+
+	Collider& operator=(const Collider& collider);
+
 	virtual void OnCollision(Collider* collider) = 0;
 
+	//当たり始めたフレームに呼ばれる
+	virtual void OnCollisionEnter([[maybe_unused]] Collider* collider) {};
+
+	//当たり続けている間、2フレーム目から毎フレーム呼ばれる
+	virtual void OnCollisionStay([[maybe_unused]] Collider* collider) {};
+
+	//離れたフレームに呼ばれる(相手が登録されなくなった場合は呼ばれない)
+	virtual void OnCollisionExit([[maybe_unused]] Collider* collider) {};
+
 	virtual const Vector3 GetWorldPosition() const = 0;
 
 	virtual const WorldTransform& GetWorldTransform() const = 0;
 
 	const float GetRadius() const { return radius_; };
 
-	void SetRadius(float radius) { radius_ = radius; };
+	void SetRadius(float radius) { radius_ = radius; isDirty_ = true; };
 
 	const AABB& GetAABB() const { return aabb_; };
 
-	void SetAABB(AABB& aabb) { aabb_ = aabb; };
+	void SetAABB(AABB& aabb) { aabb_ = aabb; isDirty_ = true; };
 
+	//SetOBBで設定したWorldTransformのローカル空間のOBB(ワールド空間のOBBはGetWorldOBBで取得する)
 	const OBB& GetOBB() const { return obb_; };
 
-	void SetOBB(OBB& obb) { obb_ = obb; };
+	//obbはWorldTransformのローカル空間で設定する。centerは回転・スケールを掛けてからGetWorldPositionに足すオフセット、orientationsとsizeは回転・スケールを掛ける前の値
+	//ワールド空間で計算したOBBを毎フレーム設定すると回転とスケールが二重に掛かるので、設定は一度だけにしてWorldTransformを動かすこと
+	void SetOBB(OBB& obb) { obb_ = obb; isDirty_ = true; };
+
+	//WorldTransformの回転・スケールを掛けたワールド空間のOBB
+	const OBB GetWorldOBB() const;
 
 	const uint32_t GetCollisionAttribute() const { return collisionAttribute_; };
 
-	void SetCollisionAttribute(uint32_t collisionAttribute) { collisionAttribute_ = collisionAttribute; };
+	void SetCollisionAttribute(uint32_t collisionAttribute) { collisionAttribute_ = collisionAttribute; isDirty_ = true; };
 
 	const uint32_t GetCollisionMask() const { return collisionMask_; };
 
-	void SetCollisionMask(uint32_t collisionMask) { collisionMask_ = collisionMask; };
+	void SetCollisionMask(uint32_t collisionMask) { collisionMask_ = collisionMask; isDirty_ = true; };
 
 	const uint32_t GetCollisionPrimitive() const { return collisionPrimitive_; };
 
-	void SetCollisionPrimitive(uint32_t collisionPrimitive) { collisionPrimitive_ = collisionPrimitive; };
+	void SetCollisionPrimitive(uint32_t collisionPrimitive) { collisionPrimitive_ = collisionPrimitive; isDirty_ = true; };
+
+	const bool GetIsContinuous() const { return isContinuous_; };
+
+	//有効にすると前フレームの位置から今フレームの位置までの球の移動も判定する
+	void SetIsContinuous(bool isContinuous) { isContinuous_ = isContinuous; isDirty_ = true; };
+
+	const Vector3& GetPreviousWorldPosition() const { return previousWorldPosition_; };
+
+	void SetPreviousWorldPosition(const Vector3& previousWorldPosition) { previousWorldPosition_ = previousWorldPosition; hasPreviousWorldPosition_ = true; };
+
+	const bool GetHasPreviousWorldPosition() const { return hasPreviousWorldPosition_; };
+
+	//ワープした時などに呼ぶと次のフレームは移動を判定しない
+	void ResetPreviousWorldPosition() { hasPreviousWorldPosition_ = false; };
+
+	//移動中に当たった時刻(0が前フレームの位置、1が今フレームの位置)。OnCollisionの中で有効
+	const float GetTimeOfImpact() const { return timeOfImpact_; };
+
+	void SetTimeOfImpact(float timeOfImpact) { timeOfImpact_ = timeOfImpact; };
+
+	//コライダーごとに割り当てられる番号(削除したコライダーと同じアドレスに作られても別の番号になる)
+	const uint32_t GetColliderId() const { return colliderId_; };
+
+	const bool GetIsDirty() const { return isDirty_; };
+
+	//CollisionManager::RegisterColliderで登録した場合、移動・回転・拡縮したフレームにtrueにする
+	void SetIsDirty(bool isDirty) { isDirty_ = isDirty; };
 
 private:
+	static std::atomic<uint32_t> nextColliderId_;
+
+	uint32_t colliderId_ = 0;
+
 	float radius_ = 1.0f;
 
 	AABB aabb_{ {-1.0f,-1.0f,-1.0f},{1.0f,1.0f,1.0f} };
 
+	//中心はワールド座標からのオフセット、軸と大きさはWorldTransformのローカル空間
 	OBB obb_{ {0.0f,0.0f,0.0f},{{1.0f,0.0f,0.0f},{0.0f,1.0f,0.0f},{0.0f,0.0f,1.0f}},{1.0f,1.0f,1.0f} };
 
 	uint32_t collisionAttribute_ = 0xffffffff;
@@ -49,5 +104,16 @@ private:
 	uint32_t collisionMask_ = 0xffffffff;
 
 	uint32_t collisionPrimitive_ = 0b1;
+
+	bool isContinuous_ = false;
+
+	bool hasPreviousWorldPosition_ = false;
+
+	Vector3 previousWorldPosition_{};
+
+	float timeOfImpact_ = 1.0f;
+
+	//前回CollisionManagerが情報を取得してから変化したかどうか
+	bool isDirty_ = true;
 };
 
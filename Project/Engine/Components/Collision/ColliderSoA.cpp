@@ -0,0 +1,237 @@
+#include "ColliderSoA.h"
+#include "CollisionConfig.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define COLLIDER_SOA_USE_SSE
+#endif
+
+void ColliderSoA::Resize(size_t count)
+{
+	centerX_.resize(count);
+	centerY_.resize(count);
+	centerZ_.resize(count);
+	radius_.resize(count);
+	minX_.resize(count);
+	minY_.resize(count);
+	minZ_.resize(count);
+	maxX_.resize(count);
+	maxY_.resize(count);
+	maxZ_.resize(count);
+	obbs_.resize(count);
+	previousCenters_.resize(count);
+	isContinuous_.resize(count);
+	attribute_.resize(count);
+	mask_.resize(count);
+	primitive_.resize(count);
+}
+
+void ColliderSoA::Set(size_t index, const Collider* collider)
+{
+	//ワールド座標は1フレームに1回だけ取得する
+	Vector3 position = collider->GetWorldPosition();
+	centerX_[index] = position.x;
+	centerY_[index] = position.y;
+	centerZ_[index] = position.z;
+	radius_[index] = collider->GetRadius();
+
+	//ワールド空間のAABB
+	const AABB& aabb = collider->GetAABB();
+	minX_[index] = position.x + aabb.min.x;
+	minY_[index] = position.y + aabb.min.y;
+	minZ_[index] = position.z + aabb.min.z;
+	maxX_[index] = position.x + aabb.max.x;
+	maxY_[index] = position.y + aabb.max.y;
+	maxZ_[index] = position.z + aabb.max.z;
+
+	attribute_[index] = collider->GetCollisionAttribute();
+	mask_[index] = collider->GetCollisionMask();
+	primitive_[index] = collider->GetCollisionPrimitive();
+
+	//OBBの軸はWorldTransformから1フレームに1回だけ計算する
+	if (primitive_[index] & kCollisionPrimitiveOBB)
+	{
+		obbs_[index] = collider->GetWorldOBB();
+	}
+
+	//連続衝突判定は球の形状で前フレームの位置がある場合だけ行う
+	bool isContinuous = collider->GetIsContinuous() && collider->GetHasPreviousWorldPosition() && (primitive_[index] & kCollisionPrimitiveSphere);
+	isContinuous_[index] = isContinuous ? 1 : 0;
+	previousCenters_[index] = isContinuous ? collider->GetPreviousWorldPosition() : position;
+}
+
+void ColliderSoA::TestSphereSphere(const CollisionPair* pairs, size_t count, uint8_t* results) const
+{
+	size_t i = 0;
+#ifdef COLLIDER_SOA_USE_SSE
+	for (; i + 4 <= count; i += 4)
+	{
+		const CollisionPair* p = pairs + i;
+
+		//4ペア分の中心と半径を集める
+		__m128 ax = _mm_setr_ps(centerX_[p[0].indexA], centerX_[p[1].indexA], centerX_[p[2].indexA], centerX_[p[3].indexA]);
+		__m128 ay = _mm_setr_ps(centerY_[p[0].indexA], centerY_[p[1].indexA], centerY_[p[2].indexA], centerY_[p[3].indexA]);
+		__m128 az = _mm_setr_ps(centerZ_[p[0].indexA], centerZ_[p[1].indexA], centerZ_[p[2].indexA], centerZ_[p[3].indexA]);
+		__m128 ar = _mm_setr_ps(radius_[p[0].indexA], radius_[p[1].indexA], radius_[p[2].indexA], radius_[p[3].indexA]);
+		__m128 bx = _mm_setr_ps(centerX_[p[0].indexB], centerX_[p[1].indexB], centerX_[p[2].indexB], centerX_[p[3].indexB]);
+		__m128 by = _mm_setr_ps(centerY_[p[0].indexB], centerY_[p[1].indexB], centerY_[p[2].indexB], centerY_[p[3].indexB]);
+		__m128 bz = _mm_setr_ps(centerZ_[p[0].indexB], centerZ_[p[1].indexB], centerZ_[p[2].indexB], centerZ_[p[3].indexB]);
+		__m128 br = _mm_setr_ps(radius_[p[0].indexB], radius_[p[1].indexB], radius_[p[2].indexB], radius_[p[3].indexB]);
+
+		//距離の2乗と半径の和の2乗を比べる
+		__m128 dx = _mm_sub_ps(ax, bx);
+		__m128 dy = _mm_sub_ps(ay, by);
+		__m128 dz = _mm_sub_ps(az, bz);
+		__m128 distanceSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+		__m128 radius = _mm_add_ps(ar, br);
+		__m128 radiusSquared = _mm_mul_ps(radius, radius);
+		int hit = _mm_movemask_ps(_mm_cmple_ps(distanceSquared, radiusSquared));
+
+		results[i + 0] = uint8_t(hit & 1);
+		results[i + 1] = uint8_t((hit >> 1) & 1);
+		results[i + 2] = uint8_t((hit >> 2) & 1);
+		results[i + 3] = uint8_t((hit >> 3) & 1);
+	}
+#endif
+	//残りはスカラーで判定
+	for (; i < count; ++i)
+	{
+		results[i] = TestSphereSphere(pairs[i].indexA, pairs[i].indexB) ? 1 : 0;
+	}
+}
+
+void ColliderSoA::TestAABBAABB(const CollisionPair* pairs, size_t count, uint8_t* results) const
+{
+	size_t i = 0;
+#ifdef COLLIDER_SOA_USE_SSE
+	for (; i + 4 <= count; i += 4)
+	{
+		const CollisionPair* p = pairs + i;
+
+		//4ペア分のAABBを集める
+		__m128 aMinX = _mm_setr_ps(minX_[p[0].indexA], minX_[p[1].indexA], minX_[p[2].indexA], minX_[p[3].indexA]);
+		__m128 aMinY = _mm_setr_ps(minY_[p[0].indexA], minY_[p[1].indexA], minY_[p[2].indexA], minY_[p[3].indexA]);
+		__m128 aMinZ = _mm_setr_ps(minZ_[p[0].indexA], minZ_[p[1].indexA], minZ_[p[2].indexA], minZ_[p[3].indexA]);
+		__m128 aMaxX = _mm_setr_ps(maxX_[p[0].indexA], maxX_[p[1].indexA], maxX_[p[2].indexA], maxX_[p[3].indexA]);
+		__m128 aMaxY = _mm_setr_ps(maxY_[p[0].indexA], maxY_[p[1].indexA], maxY_[p[2].indexA], maxY_[p[3].indexA]);
+		__m128 aMaxZ = _mm_setr_ps(maxZ_[p[0].indexA], maxZ_[p[1].indexA], maxZ_[p[2].indexA], maxZ_[p[3].indexA]);
+		__m128 bMinX = _mm_setr_ps(minX_[p[0].indexB], minX_[p[1].indexB], minX_[p[2].indexB], minX_[p[3].indexB]);
+		__m128 bMinY = _mm_setr_ps(minY_[p[0].indexB], minY_[p[1].indexB], minY_[p[2].indexB], minY_[p[3].indexB]);
+		__m128 bMinZ = _mm_setr_ps(minZ_[p[0].indexB], minZ_[p[1].indexB], minZ_[p[2].indexB], minZ_[p[3].indexB]);
+		__m128 bMaxX = _mm_setr_ps(maxX_[p[0].indexB], maxX_[p[1].indexB], maxX_[p[2].indexB], maxX_[p[3].indexB]);
+		__m128 bMaxY = _mm_setr_ps(maxY_[p[0].indexB], maxY_[p[1].indexB], maxY_[p[2].indexB], maxY_[p[3].indexB]);
+		__m128 bMaxZ = _mm_setr_ps(maxZ_[p[0].indexB], maxZ_[p[1].indexB], maxZ_[p[2].indexB], maxZ_[p[3].indexB]);
+
+		//全ての軸で重なっていれば衝突
+		__m128 overlap = _mm_and_ps(_mm_cmple_ps(aMinX, bMaxX), _mm_cmpge_ps(aMaxX, bMinX));
+		overlap = _mm_and_ps(overlap, _mm_and_ps(_mm_cmple_ps(aMinY, bMaxY), _mm_cmpge_ps(aMaxY, bMinY)));
+		overlap = _mm_and_ps(overlap, _mm_and_ps(_mm_cmple_ps(aMinZ, bMaxZ), _mm_cmpge_ps(aMaxZ, bMinZ)));
+		int hit = _mm_movemask_ps(overlap);
+
+		results[i + 0] = uint8_t(hit & 1);
+		results[i + 1] = uint8_t((hit >> 1) & 1);
+		results[i + 2] = uint8_t((hit >> 2) & 1);
+		results[i + 3] = uint8_t((hit >> 3) & 1);
+	}
+#endif
+	//残りはスカラーで判定
+	for (; i < count; ++i)
+	{
+		results[i] = TestAABBAABB(pairs[i].indexA, pairs[i].indexB) ? 1 : 0;
+	}
+}
+
+void ColliderSoA::TestSphereAABB(const CollisionPair* pairs, size_t count, uint8_t* results) const
+{
+	size_t i = 0;
+#ifdef COLLIDER_SOA_USE_SSE
+	for (; i + 4 <= count; i += 4)
+	{
+		//コライダーAが球でBがAABBならAが球、そうでなければBが球
+		uint32_t s[4]{};
+		uint32_t a[4]{};
+		for (size_t k = 0; k < 4; ++k)
+		{
+			const CollisionPair& pair = pairs[i + k];
+			bool sphereIsA = IsSphereA(pair);
+			s[k] = sphereIsA ? pair.indexA : pair.indexB;
+			a[k] = sphereIsA ? pair.indexB : pair.indexA;
+		}
+
+		__m128 cx = _mm_setr_ps(centerX_[s[0]], centerX_[s[1]], centerX_[s[2]], centerX_[s[3]]);
+		__m128 cy = _mm_setr_ps(centerY_[s[0]], centerY_[s[1]], centerY_[s[2]], centerY_[s[3]]);
+		__m128 cz = _mm_setr_ps(centerZ_[s[0]], centerZ_[s[1]], centerZ_[s[2]], centerZ_[s[3]]);
+		__m128 r = _mm_setr_ps(radius_[s[0]], radius_[s[1]], radius_[s[2]], radius_[s[3]]);
+		__m128 minX = _mm_setr_ps(minX_[a[0]], minX_[a[1]], minX_[a[2]], minX_[a[3]]);
+		__m128 minY = _mm_setr_ps(minY_[a[0]], minY_[a[1]], minY_[a[2]], minY_[a[3]]);
+		__m128 minZ = _mm_setr_ps(minZ_[a[0]], minZ_[a[1]], minZ_[a[2]], minZ_[a[3]]);
+		__m128 maxX = _mm_setr_ps(maxX_[a[0]], maxX_[a[1]], maxX_[a[2]], maxX_[a[3]]);
+		__m128 maxY = _mm_setr_ps(maxY_[a[0]], maxY_[a[1]], maxY_[a[2]], maxY_[a[3]]);
+		__m128 maxZ = _mm_setr_ps(maxZ_[a[0]], maxZ_[a[1]], maxZ_[a[2]], maxZ_[a[3]]);
+
+		//std::clampと同じ選び方で最近接点を求める
+		auto clamp = [](__m128 v, __m128 lo, __m128 hi)
+			{
+				__m128 aboveHi = _mm_cmplt_ps(hi, v);
+				__m128 t = _mm_or_ps(_mm_and_ps(aboveHi, hi), _mm_andnot_ps(aboveHi, v));
+				__m128 belowLo = _mm_cmplt_ps(v, lo);
+				return _mm_or_ps(_mm_and_ps(belowLo, lo), _mm_andnot_ps(belowLo, t));
+			};
+		__m128 dx = _mm_sub_ps(clamp(cx, minX, maxX), cx);
+		__m128 dy = _mm_sub_ps(clamp(cy, minY, maxY), cy);
+		__m128 dz = _mm_sub_ps(clamp(cz, minZ, maxZ), cz);
+
+		//最近接点までの距離の2乗と半径の2乗を比べる
+		__m128 distanceSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+		int hit = _mm_movemask_ps(_mm_cmple_ps(distanceSquared, _mm_mul_ps(r, r)));
+
+		results[i + 0] = uint8_t(hit & 1);
+		results[i + 1] = uint8_t((hit >> 1) & 1);
+		results[i + 2] = uint8_t((hit >> 2) & 1);
+		results[i + 3] = uint8_t((hit >> 3) & 1);
+	}
+#endif
+	//残りはスカラーで判定
+	for (; i < count; ++i)
+	{
+		const CollisionPair& pair = pairs[i];
+		bool sphereIsA = IsSphereA(pair);
+		results[i] = (sphereIsA ? TestSphereAABB(pair.indexA, pair.indexB) : TestSphereAABB(pair.indexB, pair.indexA)) ? 1 : 0;
+	}
+}
+
+bool ColliderSoA::TestSphereSphere(uint32_t indexA, uint32_t indexB) const
+{
+	float dx = centerX_[indexA] - centerX_[indexB];
+	float dy = centerY_[indexA] - centerY_[indexB];
+	float dz = centerZ_[indexA] - centerZ_[indexB];
+	float distanceSquared = dx * dx + dy * dy + dz * dz;
+	float radius = radius_[indexA] + radius_[indexB];
+	return distanceSquared <= radius * radius;
+}
+
+bool ColliderSoA::TestAABBAABB(uint32_t indexA, uint32_t indexB) const
+{
+	return minX_[indexA] <= maxX_[indexB] && maxX_[indexA] >= minX_[indexB] &&
+		minY_[indexA] <= maxY_[indexB] && maxY_[indexA] >= minY_[indexB] &&
+		minZ_[indexA] <= maxZ_[indexB] && maxZ_[indexA] >= minZ_[indexB];
+}
+
+bool ColliderSoA::TestSphereAABB(uint32_t sphereIndex, uint32_t aabbIndex) const
+{
+	//最近接点を求める
+	float cx = centerX_[sphereIndex];
+	float cy = centerY_[sphereIndex];
+	float cz = centerZ_[sphereIndex];
+	float closestX = cx < minX_[aabbIndex] ? minX_[aabbIndex] : (maxX_[aabbIndex] < cx ? maxX_[aabbIndex] : cx);
+	float closestY = cy < minY_[aabbIndex] ? minY_[aabbIndex] : (maxY_[aabbIndex] < cy ? maxY_[aabbIndex] : cy);
+	float closestZ = cz < minZ_[aabbIndex] ? minZ_[aabbIndex] : (maxZ_[aabbIndex] < cz ? maxZ_[aabbIndex] : cz);
+
+	//最近接点までの距離の2乗と半径の2乗を比べる
+	float dx = closestX - cx;
+	float dy = closestY - cy;
+	float dz = closestZ - cz;
+	float distanceSquared = dx * dx + dy * dy + dz * dz;
+	float radius = radius_[sphereIndex];
+	return distanceSquared <= radius * radius;
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include "Collider.h"
+#include "CollisionConfig.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct CollisionPair
+{
+	uint32_t indexA;
+	uint32_t indexB;
+};
+
+class ColliderSoA
+{
+public:
+	void Resize(size_t count);
+
+	void Set(size_t index, const Collider* collider);
+
+	//4ペアずつまとめて判定し、当たっていれば1を書き込む
+	void TestSphereSphere(const CollisionPair* pairs, size_t count, uint8_t* results) const;
+
+	void TestAABBAABB(const CollisionPair* pairs, size_t count, uint8_t* results) const;
+
+	void TestSphereAABB(const CollisionPair* pairs, size_t count, uint8_t* results) const;
+
+	const size_t GetCount() const { return centerX_.size(); };
+
+	const Vector3 GetCenter(size_t index) const { return { centerX_[index],centerY_[index],centerZ_[index] }; };
+
+	const float GetRadius(size_t index) const { return radius_[index]; };
+
+	const AABB GetAABB(size_t index) const { return { {minX_[index],minY_[index],minZ_[index]},{maxX_[index],maxY_[index],maxZ_[index]} }; };
+
+	const OBB& GetOBB(size_t index) const { return obbs_[index]; };
+
+	const Vector3& GetPreviousCenter(size_t index) const { return previousCenters_[index]; };
+
+	const bool GetIsContinuous(size_t index) const { return isContinuous_[index] != 0; };
+
+	const uint32_t GetCollisionAttribute(size_t index) const { return attribute_[index]; };
+
+	const uint32_t GetCollisionMask(size_t index) const { return mask_[index]; };
+
+	const uint32_t GetCollisionPrimitive(size_t index) const { return primitive_[index]; };
+
+	//SIMDと同じ演算順で判定するスカラー版
+	bool TestSphereSphere(uint32_t indexA, uint32_t indexB) const;
+
+	bool TestAABBAABB(uint32_t indexA, uint32_t indexB) const;
+
+	bool TestSphereAABB(uint32_t sphereIndex, uint32_t aabbIndex) const;
+
+private:
+	//球とAABBの判定でコライダーAを球として使うかどうか(相手が持っていない形状とは判定しない)
+	bool IsSphereA(const CollisionPair& pair) const { return (primitive_[pair.indexA] & kCollisionPrimitiveSphere) && (primitive_[pair.indexB] & kCollisionPrimitiveAABB); };
+
+	//中心座標
+	std::vector<float> centerX_{};
+	std::vector<float> centerY_{};
+	std::vector<float> centerZ_{};
+
+	//半径
+	std::vector<float> radius_{};
+
+	//ワールド空間のAABB
+	std::vector<float> minX_{};
+	std::vector<float> minY_{};
+	std::vector<float> minZ_{};
+	std::vector<float> maxX_{};
+	std::vector<float> maxY_{};
+	std::vector<float> maxZ_{};
+
+	//ワールド空間のOBB(形状にOBBを持つコライダーのみ)
+	std::vector<OBB> obbs_{};
+
+	//連続衝突判定用の前フレームの中心座標(判定しない場合は今フレームと同じ)
+	std::vector<Vector3> previousCenters_{};
+
+	//連続衝突判定を行うかどうか
+	std::vector<uint8_t> isContinuous_{};
+
+	//衝突属性
+	std::vector<uint32_t> attribute_{};
+
+	//衝突マスク
+	std::vector<uint32_t> mask_{};
+
+	//形状
+	std::vector<uint32_t> primitive_{};
+};
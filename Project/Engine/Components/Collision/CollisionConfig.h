@@ -9,6 +9,9 @@ const uint32_t kCollisionAttributeEnemy = 0b0010;
 const uint32_t kCollisionMaskPlayer = 0b1110;
 const uint32_t kCollisionMaskEnemy = 0b1101;
 
+//衝突属性のビットの数(1ビットを1つのレイヤーとして扱う)
+const uint32_t kCollisionLayerCount = 32;
+
 //形状
 const uint32_t kCollisionPrimitiveSphere = 0b1;
 const uint32_t kCollisionPrimitiveAABB = kCollisionPrimitiveSphere << 1;
@@ -1,7 +1,12 @@
 #include "CollisionManager.h"
 #include "CollisionConfig.h"
 #include "Engine/Math/MathFunction.h"
+#include "Engine/Utilities/ThreadPool.h"
 #include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <numeric>
 
 void CollisionManager::ClearColliderList()
 {
@@ -15,36 +20,772 @@ void CollisionManager::SetColliderList(Collider* collider)
 	colliders_.push_back(collider);
 }
 
+void CollisionManager::RegisterCollider(Collider* collider)
+{
+	//末尾に追加するので既に登録されているコライダーの番号は変わらない
+	firstChangedIndex_ = (std::min)(firstChangedIndex_, registeredColliders_.size());
+	registeredColliders_.push_back(collider);
+}
+
+void CollisionManager::UnregisterCollider(Collider* collider)
+{
+	std::vector<Collider*>::iterator it = std::find(registeredColliders_.begin(), registeredColliders_.end(), collider);
+	if (it == registeredColliders_.end())
+	{
+		return;
+	}
+
+	//後ろのコライダーは番号が1つずつずれる
+	firstChangedIndex_ = (std::min)(firstChangedIndex_, size_t(it - registeredColliders_.begin()));
+	registeredColliders_.erase(it);
+
+	//コライダーの情報とプロキシを削除する
+	colliderStates_.erase(collider);
+	DestroyProxy(collider);
+}
+
+void CollisionManager::SetBroadPhaseType(BroadPhaseType broadPhaseType)
+{
+	//切り替えた場合は次のフレームでブロードフェーズを作り直す
+	if (broadPhaseType_ != broadPhaseType)
+	{
+		broadPhaseType_ = broadPhaseType;
+		isFullUpdateRequired_ = true;
+	}
+}
+
+void CollisionManager::SetCellSize(float cellSize)
+{
+	//変更した場合は次のフレームでセルに登録しなおす
+	if (cellSize_ != cellSize)
+	{
+		cellSize_ = cellSize;
+		isFullUpdateRequired_ = true;
+	}
+}
+
 void CollisionManager::CheckAllCollisions()
 {
-	//リスト内のペアを総当たり
-	std::list<Collider*>::iterator itrA = colliders_.begin();
-	for (; itrA != colliders_.end(); ++itrA)
+	//フレーム番号を進める
+	++frame_;
+
+	//コライダーを配列に並べて、今フレームに情報を取得しなおすコライダーを決める
+	UpdateColliderArray();
+
+	//コライダーのワールド空間のAABBを計算(総当たりの場合もクエリで使う)
+	UpdateBounds();
+
+	//前フレームから変化したコライダーを調べる
+	UpdateColliderStates();
+
+	//登録されなくなったコライダーの情報を削除
+	RemoveStaleColliders();
+
+	//総当たりの場合
+	if (broadPhaseType_ == kBroadPhaseBruteForce)
+	{
+		CheckAllCollisionsBruteForce();
+		NotifyCollisionExits();
+		return;
+	}
+
+	//判定するレイヤーの組み合わせを決める
+	UpdateLayerMatrix();
+
+	//ブロードフェーズで候補ペアを探す
+	if (broadPhaseType_ == kBroadPhaseSpatialHash)
+	{
+		FindPairsSpatialHash();
+	}
+	else
+	{
+		UpdateDynamicAABBTree();
+		FindPairsDynamicAABBTree();
+	}
+
+	//候補ペアだけ当たり判定を行う(総当たりと同じ順番になるように並んでいる)
+	CheckCandidatePairs();
+
+	//離れたペアのコールバックを呼ぶ
+	NotifyCollisionExits();
+}
+
+void CollisionManager::CheckAllCollisionsBruteForce()
+{
+	//登録されている全てのペアを総当たり
+	for (size_t indexA = 0; indexA < colliderArray_.size(); ++indexA)
+	{
+		Collider* colliderA = colliderArray_[indexA];
+		//コライダーBはコライダーAの次の要素から回す(重複判定を回避)
+		for (size_t indexB = indexA + 1; indexB < colliderArray_.size(); ++indexB)
+		{
+			Collider* colliderB = colliderArray_[indexB];
+			//ベアの当たり判定
+			uint32_t hitCount = CheckCollisionPair(colliderA, colliderB);
+			if (hitCount > 0)
+			{
+				UpdatePersistentPair(colliderA, colliderB, hitCount, 1.0f);
+				continue;
+			}
+			//今フレームの位置で当たっていなければ移動中に当たっていないか調べる
+			float timeOfImpact = 1.0f;
+			if (CheckContinuousCollision(indexA, indexB, timeOfImpact))
+			{
+				NotifyContinuousCollision(colliderA, colliderB, timeOfImpact);
+				UpdatePersistentPair(colliderA, colliderB, 1, timeOfImpact);
+			}
+		}
+	}
+}
+
+void CollisionManager::UpdateColliderArray()
+{
+	//登録が変わった場合だけ配列を作り直す(RegisterColliderのコライダーが先、SetColliderListのコライダーが後)
+	size_t registeredCount = registeredColliders_.size();
+	if (firstChangedIndex_ < registeredCount || colliderArray_.size() != registeredCount || !colliders_.empty())
+	{
+		colliderArray_.assign(registeredColliders_.begin(), registeredColliders_.end());
+		colliderArray_.insert(colliderArray_.end(), colliders_.begin(), colliders_.end());
+	}
+
+	//SetColliderListのコライダーは毎フレーム番号が変わったものとして扱う
+	size_t firstChangedIndex = (std::min)(firstChangedIndex_, registeredCount);
+	firstChangedIndex_ = registeredCount;
+
+	//番号が変わった、変化した、連続衝突判定を行うコライダーは情報を取得しなおす
+	isFullUpdate_ = isFullUpdateRequired_;
+	isFullUpdateRequired_ = false;
+	isMoved_.resize(colliderArray_.size());
+	movedIndices_.clear();
+	for (size_t i = 0; i < colliderArray_.size(); ++i)
+	{
+		const Collider* collider = colliderArray_[i];
+		bool isMoved = i >= firstChangedIndex || collider->GetIsDirty() || collider->GetIsContinuous();
+		isMoved_[i] = isMoved ? 1 : 0;
+		if (isMoved)
+		{
+			movedIndices_.push_back(uint32_t(i));
+		}
+	}
+
+	//半分以上動いていれば差分で更新するより作り直した方が速い
+	if (movedIndices_.size() * 2 > colliderArray_.size())
+	{
+		isFullUpdate_ = true;
+	}
+	if (isFullUpdate_)
+	{
+		std::fill(isMoved_.begin(), isMoved_.end(), uint8_t(1));
+		movedIndices_.resize(colliderArray_.size());
+		std::iota(movedIndices_.begin(), movedIndices_.end(), 0u);
+	}
+}
+
+void CollisionManager::UpdateBounds()
+{
+	colliderSoA_.Resize(colliderArray_.size());
+	bounds_.resize(colliderArray_.size());
+	hasBounds_.resize(colliderArray_.size());
+	layers_.resize(colliderArray_.size());
+
+	//動いたコライダーだけ情報を取得してワールド空間のAABBを計算する
+	for (uint32_t i : movedIndices_)
+	{
+		colliderSoA_.Set(i, colliderArray_[i]);
+		colliderArray_[i]->SetIsDirty(false);
+		//連続衝突判定を行うコライダーは次のフレームのために今の位置を記録する
+		if (colliderArray_[i]->GetIsContinuous())
+		{
+			colliderArray_[i]->SetPreviousWorldPosition(colliderSoA_.GetCenter(i));
+		}
+		hasBounds_[i] = (colliderSoA_.GetCollisionPrimitive(i) & (kCollisionPrimitiveSphere | kCollisionPrimitiveAABB | kCollisionPrimitiveOBB)) != 0;
+		if (hasBounds_[i])
+		{
+			bounds_[i] = ComputeWorldAABB(i);
+		}
+
+		//形状を持たないコライダーはどのレイヤーにも入れない
+		layers_[i] = uint8_t(hasBounds_[i] ? GetLayer(colliderSoA_.GetCollisionAttribute(i)) : kCollisionLayerCount);
+	}
+}
+
+void CollisionManager::UpdateColliderStates()
+{
+	//情報を取得しなおさなかったコライダーは前フレームから変化していない
+	isUnchanged_.assign(colliderArray_.size(), 1);
+	for (uint32_t i : movedIndices_)
+	{
+		//前フレームも登録されていて情報が全く同じなら変化していない
+		ColliderSnapshot snapshot = MakeSnapshot(i);
+		std::pair<std::unordered_map<const Collider*, ColliderState>::iterator, bool> result = colliderStates_.try_emplace(colliderArray_[i]);
+		ColliderState& state = result.first->second;
+		uint32_t colliderId = colliderArray_[i]->GetColliderId();
+		isUnchanged_[i] = !result.second && state.colliderId == colliderId && std::memcmp(&state.snapshot, &snapshot, sizeof(ColliderSnapshot)) == 0;
+		state = { frame_,i,colliderId,snapshot };
+	}
+}
+
+CollisionManager::ColliderSnapshot CollisionManager::MakeSnapshot(size_t index) const
+{
+	//使っていない形状の値は0にしておく(memcmpで比べるため)
+	ColliderSnapshot snapshot{};
+	snapshot.center = colliderSoA_.GetCenter(index);
+	snapshot.previousCenter = colliderSoA_.GetPreviousCenter(index);
+	snapshot.radius = colliderSoA_.GetRadius(index);
+	snapshot.aabb = colliderSoA_.GetAABB(index);
+	snapshot.attribute = colliderSoA_.GetCollisionAttribute(index);
+	snapshot.mask = colliderSoA_.GetCollisionMask(index);
+	snapshot.primitive = colliderSoA_.GetCollisionPrimitive(index);
+	if (snapshot.primitive & kCollisionPrimitiveOBB)
+	{
+		snapshot.obb = colliderSoA_.GetOBB(index);
+	}
+	return snapshot;
+}
+
+void CollisionManager::RemoveStaleColliders()
+{
+	//前フレームにSetColliderListで登録されていて今フレームは登録されなかったコライダーの情報を削除
+	for (const Collider* collider : previousListedColliders_)
+	{
+		std::unordered_map<const Collider*, ColliderState>::iterator state = colliderStates_.find(collider);
+		if (state == colliderStates_.end() || state->second.frame == frame_)
+		{
+			continue;
+		}
+		colliderStates_.erase(state);
+		DestroyProxy(collider);
+	}
+	previousListedColliders_.assign(colliders_.begin(), colliders_.end());
+}
+
+uint32_t CollisionManager::GetLayer(uint32_t collisionAttribute)
+{
+	return collisionAttribute != 0 ? uint32_t(std::countr_zero(collisionAttribute)) : kCollisionLayerCount;
+}
+
+void CollisionManager::UpdateLayerMatrix()
+{
+	//レイヤーごとに衝突属性と衝突マスクを合わせる(複数ビットの属性でも判定漏れが無いように)
+	layerAttributes_.fill(0);
+	layerMasks_.fill(0);
+	for (size_t i = 0; i < colliderArray_.size(); ++i)
+	{
+		uint32_t layer = layers_[i];
+		if (layer < kCollisionLayerCount)
+		{
+			layerAttributes_[layer] |= colliderSoA_.GetCollisionAttribute(i);
+			layerMasks_[layer] |= colliderSoA_.GetCollisionMask(i);
+		}
+	}
+
+	//両方向で属性とマスクが重なるレイヤーの組み合わせだけ判定する
+	for (uint32_t layerA = 0; layerA < kCollisionLayerCount; ++layerA)
+	{
+		layerMatrix_[layerA] = 0;
+		for (uint32_t layerB = 0; layerB < kCollisionLayerCount; ++layerB)
+		{
+			if ((layerAttributes_[layerA] & layerMasks_[layerB]) != 0 && (layerAttributes_[layerB] & layerMasks_[layerA]) != 0)
+			{
+				layerMatrix_[layerA] |= 1u << layerB;
+			}
+		}
+	}
+}
+
+void CollisionManager::DestroyProxy(const Collider* collider)
+{
+	std::unordered_map<const Collider*, Proxy>::iterator it = proxies_.find(collider);
+	if (it != proxies_.end())
+	{
+		dynamicAABBTrees_[it->second.layer].DestroyProxy(it->second.proxyId);
+		proxies_.erase(it);
+	}
+}
+
+void CollisionManager::UpdateDynamicAABBTree()
+{
+	//動いたコライダーのプロキシだけ更新する
+	for (uint32_t i : movedIndices_)
+	{
+		const Collider* collider = colliderArray_[i];
+		uint32_t layer = layers_[i];
+		std::unordered_map<const Collider*, Proxy>::iterator it = proxies_.find(collider);
+
+		//レイヤーが変わった場合は別の木に入れなおす
+		if (it != proxies_.end() && it->second.layer != layer)
+		{
+			dynamicAABBTrees_[it->second.layer].DestroyProxy(it->second.proxyId);
+			proxies_.erase(it);
+			it = proxies_.end();
+		}
+
+		//形状や衝突属性を持たないコライダーは木に入れない
+		if (layer >= kCollisionLayerCount)
+		{
+			continue;
+		}
+
+		//既にプロキシがあれば移動、なければ作成
+		DynamicAABBTree& dynamicAABBTree = dynamicAABBTrees_[layer];
+		if (it != proxies_.end())
+		{
+			dynamicAABBTree.MoveProxy(it->second.proxyId, bounds_[i]);
+			dynamicAABBTree.SetUserData(it->second.proxyId, int32_t(i));
+		}
+		else
+		{
+			proxies_[collider] = { dynamicAABBTree.CreateProxy(bounds_[i], int32_t(i)),layer };
+		}
+	}
+}
+
+void CollisionManager::FindPairsDynamicAABBTree()
+{
+	//動いたコライダーが少なければ動いたコライダーの周りだけ探す
+	if (!isFullUpdate_)
+	{
+		RetainStaticPairs();
+		for (uint32_t indexA : movedIndices_)
+		{
+			if (layers_[indexA] >= kCollisionLayerCount)
+			{
+				continue;
+			}
+
+			//判定するレイヤーの木だけ探す
+			for (uint32_t layerBits = layerMatrix_[layers_[indexA]]; layerBits != 0; layerBits &= layerBits - 1)
+			{
+				const DynamicAABBTree& dynamicAABBTree = dynamicAABBTrees_[std::countr_zero(layerBits)];
+				dynamicAABBTree.Query(bounds_[indexA], [&](int32_t proxyId)
+					{
+						//両方とも動いた場合は番号の小さい方から見つけた時だけ追加する(重複判定を回避)
+						uint32_t indexB = uint32_t(dynamicAABBTree.GetUserData(proxyId));
+						if (indexB != indexA && (!isMoved_[indexB] || indexB > indexA))
+						{
+							pairs_.push_back({ (std::min)(indexA,indexB),(std::max)(indexA,indexB) });
+						}
+						return true;
+					}
+				);
+			}
+		}
+		SortPairs();
+		return;
+	}
+
+	pairs_.clear();
+
+	for (size_t i = 0; i < colliderArray_.size(); ++i)
+	{
+		if (layers_[i] >= kCollisionLayerCount)
+		{
+			continue;
+		}
+
+		//判定するレイヤーの木から自分より後ろのコライダーとだけペアを作る(重複判定を回避)
+		size_t begin = pairs_.size();
+		uint32_t indexA = uint32_t(i);
+		for (uint32_t layerBits = layerMatrix_[layers_[i]]; layerBits != 0; layerBits &= layerBits - 1)
+		{
+			const DynamicAABBTree& dynamicAABBTree = dynamicAABBTrees_[std::countr_zero(layerBits)];
+			dynamicAABBTree.Query(bounds_[i], [&](int32_t proxyId)
+				{
+					uint32_t indexB = uint32_t(dynamicAABBTree.GetUserData(proxyId));
+					if (indexB > indexA)
+					{
+						pairs_.push_back({ indexA,indexB });
+					}
+					return true;
+				}
+			);
+		}
+
+		//総当たりと同じ順番でコールバックが呼ばれるように並べ替える
+		std::sort(pairs_.begin() + begin, pairs_.end(), [](const CollisionPair& lhs, const CollisionPair& rhs)
+			{
+				return lhs.indexB < rhs.indexB;
+			}
+		);
+	}
+}
+
+void CollisionManager::FindPairsSpatialHash()
+{
+	//動いたコライダーが少なければ動いたコライダーだけセルに登録しなおして周りを探す
+	if (!isFullUpdate_)
+	{
+		spatialHashGrid_.RemoveIf([&](uint32_t index) { return index >= isMoved_.size() || isMoved_[index]; });
+		for (uint32_t i : movedIndices_)
+		{
+			if (layers_[i] < kCollisionLayerCount)
+			{
+				spatialHashGrid_.Insert(i, layers_[i], bounds_[i]);
+			}
+		}
+		spatialHashGrid_.Build();
+
+		RetainStaticPairs();
+		for (uint32_t indexA : movedIndices_)
+		{
+			if (layers_[indexA] >= kCollisionLayerCount)
+			{
+				continue;
+			}
+
+			spatialHashGrid_.Query(bounds_[indexA], layerMatrix_[layers_[indexA]], bounds_, [&](uint32_t indexB)
+				{
+					//両方とも動いた場合は番号の小さい方から見つけた時だけ追加する(重複判定を回避)
+					if (indexB != indexA && (!isMoved_[indexB] || indexB > indexA))
+					{
+						pairs_.push_back({ (std::min)(indexA,indexB),(std::max)(indexA,indexB) });
+					}
+				}
+			);
+		}
+		SortPairs();
+		return;
+	}
+
+	pairs_.clear();
+
+	//セルの大きさを決める
+	float cellSize = cellSize_ > 0.0f ? cellSize_ : ComputeAutoCellSize();
+	spatialHashGrid_.SetCellSize(cellSize);
+
+	//コライダーをセルに登録
+	spatialHashGrid_.Clear();
+	for (size_t i = 0; i < colliderArray_.size(); ++i)
+	{
+		if (layers_[i] < kCollisionLayerCount)
+		{
+			spatialHashGrid_.Insert(uint32_t(i), layers_[i], bounds_[i]);
+		}
+	}
+	spatialHashGrid_.Build();
+
+	//同じセルの判定するレイヤーのコライダー同士でペアを作る
+	spatialHashGrid_.FindPairs(bounds_, layerMatrix_, [&](uint32_t indexA, uint32_t indexB)
+		{
+			pairs_.push_back({ (std::min)(indexA,indexB),(std::max)(indexA,indexB) });
+		}
+	);
+	SortPairs();
+}
+
+void CollisionManager::RetainStaticPairs()
+{
+	//両方とも動いていないペアは前フレームに当たっていたものだけが今フレームも当たる
+	//contacts_はペアの番号順に並んでいるので前に詰めていける
+	size_t count = colliderArray_.size();
+	size_t retainedCount = 0;
+	for (const Contact& contact : contacts_)
+	{
+		CollisionPair pair = pairs_[contact.pairIndex];
+		if (pair.indexA < count && pair.indexB < count && !isMoved_[pair.indexA] && !isMoved_[pair.indexB])
+		{
+			pairs_[retainedCount++] = pair;
+		}
+	}
+	pairs_.resize(retainedCount);
+}
+
+void CollisionManager::SortPairs()
+{
+	//総当たりと同じ順番でコールバックが呼ばれるように並べ替える
+	std::sort(pairs_.begin(), pairs_.end(), [](const CollisionPair& lhs, const CollisionPair& rhs)
+		{
+			return lhs.indexA != rhs.indexA ? lhs.indexA < rhs.indexA : lhs.indexB < rhs.indexB;
+		}
+	);
+}
+
+float CollisionManager::ComputeAutoCellSize() const
+{
+	//コライダーの一番長い辺の平均の2倍にする
+	float totalSize = 0.0f;
+	uint32_t count = 0;
+	for (size_t i = 0; i < bounds_.size(); ++i)
+	{
+		if (hasBounds_[i])
+		{
+			const AABB& aabb = bounds_[i];
+			totalSize += (std::max)({ aabb.max.x - aabb.min.x,aabb.max.y - aabb.min.y,aabb.max.z - aabb.min.z });
+			++count;
+		}
+	}
+
+	if (count == 0 || totalSize <= 0.0f)
+	{
+		return 1.0f;
+	}
+
+	return 2.0f * totalSize / float(count);
+}
+
+AABB CollisionManager::ComputeWorldAABB(size_t index) const
+{
+	Vector3 min = { std::numeric_limits<float>::max(),std::numeric_limits<float>::max(),std::numeric_limits<float>::max() };
+	Vector3 max = { -std::numeric_limits<float>::max(),-std::numeric_limits<float>::max(),-std::numeric_limits<float>::max() };
+	uint32_t collisionPrimitive = colliderSoA_.GetCollisionPrimitive(index);
+
+	//球のAABB
+	if (collisionPrimitive & kCollisionPrimitiveSphere)
+	{
+		Vector3 center = colliderSoA_.GetCenter(index);
+		float radius = colliderSoA_.GetRadius(index);
+		min = { (std::min)(min.x,center.x - radius),(std::min)(min.y,center.y - radius),(std::min)(min.z,center.z - radius) };
+		max = { (std::max)(max.x,center.x + radius),(std::max)(max.y,center.y + radius),(std::max)(max.z,center.z + radius) };
+
+		//連続衝突判定を行う場合は前フレームの位置からの移動範囲を含める
+		if (colliderSoA_.GetIsContinuous(index))
+		{
+			Vector3 previousCenter = colliderSoA_.GetPreviousCenter(index);
+			min = { (std::min)(min.x,previousCenter.x - radius),(std::min)(min.y,previousCenter.y - radius),(std::min)(min.z,previousCenter.z - radius) };
+			max = { (std::max)(max.x,previousCenter.x + radius),(std::max)(max.y,previousCenter.y + radius),(std::max)(max.z,previousCenter.z + radius) };
+		}
+	}
+
+	//AABB
+	if (collisionPrimitive & kCollisionPrimitiveAABB)
+	{
+		AABB aabb = colliderSoA_.GetAABB(index);
+		min = { (std::min)({ min.x,aabb.min.x,aabb.max.x }),(std::min)({ min.y,aabb.min.y,aabb.max.y }),(std::min)({ min.z,aabb.min.z,aabb.max.z }) };
+		max = { (std::max)({ max.x,aabb.min.x,aabb.max.x }),(std::max)({ max.y,aabb.min.y,aabb.max.y }),(std::max)({ max.z,aabb.min.z,aabb.max.z }) };
+	}
+
+	//OBBを囲むAABB
+	if (collisionPrimitive & kCollisionPrimitiveOBB)
+	{
+		const OBB& obb = colliderSoA_.GetOBB(index);
+		Vector3 extent = {
+			std::abs(obb.orientations[0].x) * obb.size.x + std::abs(obb.orientations[1].x) * obb.size.y + std::abs(obb.orientations[2].x) * obb.size.z,
+			std::abs(obb.orientations[0].y) * obb.size.x + std::abs(obb.orientations[1].y) * obb.size.y + std::abs(obb.orientations[2].y) * obb.size.z,
+			std::abs(obb.orientations[0].z) * obb.size.x + std::abs(obb.orientations[1].z) * obb.size.y + std::abs(obb.orientations[2].z) * obb.size.z,
+		};
+		Vector3 obbMin = obb.center - extent;
+		Vector3 obbMax = obb.center + extent;
+		min = { (std::min)(min.x,obbMin.x),(std::min)(min.y,obbMin.y),(std::min)(min.z,obbMin.z) };
+		max = { (std::max)(max.x,obbMax.x),(std::max)(max.y,obbMax.y),(std::max)(max.z,obbMax.z) };
+	}
+
+	return AABB{ min,max };
+}
+
+void CollisionManager::CheckCandidatePairs()
+{
+	//判定結果の領域を確保
+	size_t pairCount = pairs_.size();
+	sphereSphereResults_.resize(pairCount);
+	aabbAABBResults_.resize(pairCount);
+	sphereAABBResults_.resize(pairCount);
+
+	//スレッドごとの衝突結果をクリア
+	//マルチスレッドを使わないときはスレッドプールを生成しない
+	ThreadPool* threadPool = nullptr;
+	uint32_t threadCount = 1;
+	if (isMultithreaded_)
+	{
+		threadPool = ThreadPool::GetInstance();
+		threadCount = threadPool->GetThreadCount();
+	}
+	contactBuffers_.resize(threadCount);
+	for (std::vector<Contact>& contactBuffer : contactBuffers_)
 	{
-		//イテレータAからコライダーAを取得する
-		Collider* colliderA = *itrA;
-		//イテレータBはイテレータAの次の要素から回す(重複判定を回避)
-		std::list<Collider*>::iterator itrB = itrA;
-		itrB++;
-		for (; itrB != colliders_.end(); ++itrB)
+		contactBuffer.clear();
+	}
+
+	//ナローフェーズはペアごとに独立しているのでワーカースレッドで分担する
+	if (threadCount > 1 && pairCount > kPairsPerChunk)
+	{
+		threadPool->ParallelFor(uint32_t(pairCount), kPairsPerChunk, [this](uint32_t begin, uint32_t end, uint32_t threadIndex)
+			{
+				EvaluatePairs(begin, end, contactBuffers_[threadIndex]);
+			}
+		);
+	}
+	else
+	{
+		EvaluatePairs(0, uint32_t(pairCount), contactBuffers_[0]);
+	}
+
+	//スレッドごとの結果をまとめてペアの順に並べる(シングルスレッドと同じ順番になる)
+	contacts_.clear();
+	for (const std::vector<Contact>& contactBuffer : contactBuffers_)
+	{
+		contacts_.insert(contacts_.end(), contactBuffer.begin(), contactBuffer.end());
+	}
+	if (contactBuffers_.size() > 1)
+	{
+		std::sort(contacts_.begin(), contacts_.end(), [](const Contact& lhs, const Contact& rhs)
+			{
+				return lhs.pairIndex < rhs.pairIndex;
+			}
+		);
+	}
+
+	//ゲーム側の処理はスレッドセーフではないのでコールバックはメインスレッドで順番に呼ぶ
+	for (const Contact& contact : contacts_)
+	{
+		Collider* colliderA = colliderArray_[pairs_[contact.pairIndex].indexA];
+		Collider* colliderB = colliderArray_[pairs_[contact.pairIndex].indexB];
+
+		//移動中に当たった場合
+		if (contact.timeOfImpact < 1.0f)
+		{
+			NotifyContinuousCollision(colliderA, colliderB, contact.timeOfImpact);
+		}
+		else
+		{
+			for (uint32_t hit = 0; hit < contact.hitCount; ++hit)
+			{
+				//コライダーAの衝突時コールバックを呼び出す
+				colliderA->OnCollision(colliderB);
+				//コライダーBの衝突時コールバックを呼び出す
+				colliderB->OnCollision(colliderA);
+			}
+		}
+
+		//当たり始めたか当たり続けているかのコールバックを呼ぶ
+		UpdatePersistentPair(colliderA, colliderB, contact.hitCount, contact.timeOfImpact);
+	}
+}
+
+void CollisionManager::EvaluatePairs(uint32_t begin, uint32_t end, std::vector<Contact>& contacts)
+{
+	//球と球、AABBとAABB、球とAABBはSIMDでまとめて判定する
+	const CollisionPair* pairs = pairs_.data() + begin;
+	size_t pairCount = end - begin;
+	colliderSoA_.TestSphereSphere(pairs, pairCount, sphereSphereResults_.data() + begin);
+	colliderSoA_.TestAABBAABB(pairs, pairCount, aabbAABBResults_.data() + begin);
+	colliderSoA_.TestSphereAABB(pairs, pairCount, sphereAABBResults_.data() + begin);
+
+	for (uint32_t i = begin; i < end; ++i)
+	{
+		uint32_t indexA = pairs_[i].indexA;
+		uint32_t indexB = pairs_[i].indexB;
+
+		//衝突フィルタリング
+		if ((colliderSoA_.GetCollisionAttribute(indexA) & colliderSoA_.GetCollisionMask(indexB)) == 0 ||
+			(colliderSoA_.GetCollisionAttribute(indexB) & colliderSoA_.GetCollisionMask(indexA)) == 0)
+		{
+			continue;
+		}
+
+		//両方とも前フレームから変化していなければ前フレームの結果をそのまま使う
+		if (isUnchanged_[indexA] && isUnchanged_[indexB])
+		{
+			std::unordered_map<PairKey, PersistentPair, PairKeyHash>::const_iterator it = persistentPairs_.find(MakePairKey(colliderArray_[indexA], colliderArray_[indexB]));
+			if (it != persistentPairs_.end())
+			{
+				contacts.push_back({ i,it->second.hitCount,it->second.timeOfImpact });
+			}
+			continue;
+		}
+
+		//CheckCollisionPairと同じ条件で当たった判定の数を数える
+		uint32_t primitiveA = colliderSoA_.GetCollisionPrimitive(indexA);
+		uint32_t primitiveB = colliderSoA_.GetCollisionPrimitive(indexB);
+		uint32_t hitCount = 0;
+
+		//球と球の判定
+		if ((primitiveA & kCollisionPrimitiveSphere) && (primitiveB & kCollisionPrimitiveSphere) && sphereSphereResults_[i])
+		{
+			++hitCount;
+		}
+
+		//AABBとAABBの判定
+		if ((primitiveA & kCollisionPrimitiveAABB) && (primitiveB & kCollisionPrimitiveAABB) && aabbAABBResults_[i])
+		{
+			++hitCount;
+		}
+
+		//球とAABBの判定
+		if ((((primitiveA & kCollisionPrimitiveSphere) != 0 && (primitiveB & kCollisionPrimitiveAABB) != 0) ||
+			((primitiveA & kCollisionPrimitiveAABB) != 0 && (primitiveB & kCollisionPrimitiveSphere) != 0)) && sphereAABBResults_[i])
+		{
+			++hitCount;
+		}
+
+		//OBBとAABBの判定
+		if (((primitiveA & kCollisionPrimitiveOBB) != 0 && (primitiveB & kCollisionPrimitiveAABB) != 0) ||
+			((primitiveA & kCollisionPrimitiveAABB) != 0 && (primitiveB & kCollisionPrimitiveOBB) != 0))
+		{
+			if ((primitiveA & kCollisionPrimitiveAABB) && (primitiveB & kCollisionPrimitiveOBB))
+			{
+				if (CheckCollisionAABBOBB(colliderSoA_.GetAABB(indexA), colliderSoA_.GetOBB(indexB)))
+				{
+					++hitCount;
+				}
+			}
+			else
+			{
+				if (CheckCollisionAABBOBB(colliderSoA_.GetAABB(indexB), colliderSoA_.GetOBB(indexA)))
+				{
+					++hitCount;
+				}
+			}
+		}
+
+		//OBBとOBBの判定
+		if ((primitiveA & kCollisionPrimitiveOBB) && (primitiveB & kCollisionPrimitiveOBB))
+		{
+			if (CheckCollisionOBB(colliderSoA_.GetOBB(indexA), colliderSoA_.GetOBB(indexB)))
+			{
+				++hitCount;
+			}
+		}
+
+		//球とOBBの判定
+		if (((primitiveA & kCollisionPrimitiveSphere) != 0 && (primitiveB & kCollisionPrimitiveOBB) != 0) ||
+			((primitiveA & kCollisionPrimitiveOBB) != 0 && (primitiveB & kCollisionPrimitiveSphere) != 0))
+		{
+			if ((primitiveA & kCollisionPrimitiveSphere) && (primitiveB & kCollisionPrimitiveOBB))
+			{
+				Sphere sphere = { .center{colliderSoA_.GetCenter(indexA)},.radius{colliderSoA_.GetRadius(indexA)} };
+				if (CheckCollisionSphereOBB(sphere, colliderSoA_.GetOBB(indexB)))
+				{
+					++hitCount;
+				}
+			}
+			else
+			{
+				Sphere sphere = { .center{colliderSoA_.GetCenter(indexB)},.radius{colliderSoA_.GetRadius(indexB)} };
+				if (CheckCollisionSphereOBB(sphere, colliderSoA_.GetOBB(indexA)))
+				{
+					++hitCount;
+				}
+			}
+		}
+
+		//当たっていれば結果に追加
+		if (hitCount > 0)
+		{
+			contacts.push_back({ i,hitCount,1.0f });
+			continue;
+		}
+
+		//今フレームの位置で当たっていなければ移動中に当たっていないか調べる
+		float timeOfImpact = 1.0f;
+		if (CheckContinuousCollision(indexA, indexB, timeOfImpact))
 		{
-			//イテレータBからコライダーBを取得する
-			Collider* colliderB = *itrB;
-			//ベアの当たり判定
-			CheckCollisionPair(colliderA, colliderB);
+			contacts.push_back({ i,1,timeOfImpact });
 		}
 	}
 }
 
-void CollisionManager::CheckCollisionPair(Collider* colliderA, Collider* colliderB)
+uint32_t CollisionManager::CheckCollisionPair(Collider* colliderA, Collider* colliderB)
 {
 	//衝突フィルタリング
 	if ((colliderA->GetCollisionAttribute() & colliderB->GetCollisionMask()) == 0 ||
 		(colliderB->GetCollisionAttribute() & colliderA->GetCollisionMask()) == 0)
 	{
-		return;
+		return 0;
 	}
 
+	//当たった判定の数
+	uint32_t hitCount = 0;
+
 	//球と球の判定
 	if ((colliderA->GetCollisionPrimitive() & kCollisionPrimitiveSphere) && (colliderB->GetCollisionPrimitive() & kCollisionPrimitiveSphere))
 	{
@@ -63,6 +804,7 @@ void CollisionManager::CheckCollisionPair(Collider* colliderA, Collider* collide
 			colliderA->OnCollision(colliderB);
 			//コライダーBの衝突時コールバックを呼び出す
 			colliderB->OnCollision(colliderA);
+			++hitCount;
 		}
 	}
 
@@ -84,6 +826,7 @@ void CollisionManager::CheckCollisionPair(Collider* colliderA, Collider* collide
 			colliderA->OnCollision(colliderB);
 			//コライダーBの衝突時コールバックを呼び出す
 			colliderB->OnCollision(colliderA);
+			++hitCount;
 		}
 	}
 
@@ -96,8 +839,8 @@ void CollisionManager::CheckCollisionPair(Collider* colliderA, Collider* collide
 		//コライダーBのワールド座標を取得
 		Vector3 posB = colliderB->GetWorldPosition();
 
-		//コライダーAがSphereの場合
-		if (colliderA->GetCollisionPrimitive() & kCollisionPrimitiveSphere)
+		//コライダーAがSphereでコライダーBがAABBの場合(相手が持っていない形状とは判定しない)
+		if ((colliderA->GetCollisionPrimitive() & kCollisionPrimitiveSphere) && (colliderB->GetCollisionPrimitive() & kCollisionPrimitiveAABB))
 		{
 			//コライダーAのSphereを作成
 			Sphere sphere = { .center{posA},.radius{colliderA->GetRadius()} };
@@ -110,13 +853,15 @@ void CollisionManager::CheckCollisionPair(Collider* colliderA, Collider* collide
 				colliderA->OnCollision(colliderB);
 				//コライダーBの衝突時コールバックを呼び出す
 				colliderB->OnCollision(colliderA);
+				++hitCount;
 			}
 		}
-		else if (colliderB->GetCollisionPrimitive() & kCollisionPrimitiveSphere)
+		//コライダーAがAABBでコライダーBがSphereの場合
+		else
 		{
-			//コライダーAのSphereを作成
+			//コライダーBのSphereを作成
 			Sphere sphere = { .center{posB},.radius{colliderB->GetRadius()} };
-			//コライダーBのAABBを取得
+			//コライダーAのAABBを取得
 			AABB aabb = { .min{posA + colliderA->GetAABB().min},.max{posA + colliderA->GetAABB().max} };
 			//衝突判定
 			if (CheckCollisionSphereAABB(sphere, aabb))
@@ -125,6 +870,7 @@ void CollisionManager::CheckCollisionPair(Collider* colliderA, Collider* collide
 				colliderA->OnCollision(colliderB);
 				//コライダーBの衝突時コールバックを呼び出す
 				colliderB->OnCollision(colliderA);
+				++hitCount;
 			}
 		}
 	}
@@ -133,13 +879,13 @@ void CollisionManager::CheckCollisionPair(Collider* colliderA, Collider* collide
 	if (((colliderA->GetCollisionPrimitive() & kCollisionPrimitiveOBB) != 0 && (colliderB->GetCollisionPrimitive() & kCollisionPrimitiveAABB) != 0) ||
 		((colliderA->GetCollisionPrimitive() & kCollisionPrimitiveAABB) != 0 && (colliderB->GetCollisionPrimitive() & kCollisionPrimitiveOBB) != 0))
 	{
-		//コライダーAがAABBの場合
-		if (colliderA->GetCollisionPrimitive() & kCollisionPrimitiveAABB)
+		//コライダーAがAABBでコライダーBがOBBの場合(相手が持っていない形状とは判定しない)
+		if ((colliderA->GetCollisionPrimitive() & kCollisionPrimitiveAABB) && (colliderB->GetCollisionPrimitive() & kCollisionPrimitiveOBB))
 		{
 			//コライダーAのAABBを取得
 			AABB aabb = { .min{colliderA->GetWorldPosition() + colliderA->GetAABB().min},.max{colliderA->GetWorldPosition() + colliderA->GetAABB().max}, };
 			//コライダーBのOBBを取得
-			OBB obb = colliderB->GetOBB();
+			OBB obb = colliderB->GetWorldOBB();
 
 			//衝突判定
 			if (CheckCollisionAABBOBB(aabb, obb))
@@ -148,15 +894,16 @@ void CollisionManager::CheckCollisionPair(Collider* colliderA, Collider* collide
 				colliderA->OnCollision(colliderB);
 				//コライダーBの衝突時コールバックを呼び出す
 				colliderB->OnCollision(colliderA);
+				++hitCount;
 			}
 		}
-		//ColliderBがAABBの場合
-		else if (colliderB->GetCollisionPrimitive() & kCollisionPrimitiveAABB)
+		//コライダーAがOBBでコライダーBがAABBの場合
+		else
 		{
 			//コライダーBのAABBを取得
 			AABB aabb = { .min{colliderB->GetWorldPosition() + colliderB->GetAABB().min},.max{colliderB->GetWorldPosition() + colliderB->GetAABB().max}, };
-			//コライダーBのOBBを取得
-			OBB obb = colliderA->GetOBB();
+			//コライダーAのOBBを取得
+			OBB obb = colliderA->GetWorldOBB();
 
 			//衝突判定
 			if (CheckCollisionAABBOBB(aabb, obb))
@@ -165,24 +912,86 @@ void CollisionManager::CheckCollisionPair(Collider* colliderA, Collider* collide
 				colliderA->OnCollision(colliderB);
 				//コライダーBの衝突時コールバックを呼び出す
 				colliderB->OnCollision(colliderA);
+				++hitCount;
+			}
+		}
+	}
+	//OBBとOBBの判定
+	if ((colliderA->GetCollisionPrimitive() & kCollisionPrimitiveOBB) && (colliderB->GetCollisionPrimitive() & kCollisionPrimitiveOBB))
+	{
+		//コライダーAのOBBを取得
+		OBB obbA = colliderA->GetWorldOBB();
+		//コライダーBのOBBを取得
+		OBB obbB = colliderB->GetWorldOBB();
+		//衝突判定
+		if (CheckCollisionOBB(obbA, obbB))
+		{
+			//コライダーAの衝突時コールバックを呼び出す
+			colliderA->OnCollision(colliderB);
+			//コライダーBの衝突時コールバックを呼び出す
+			colliderB->OnCollision(colliderA);
+			++hitCount;
+		}
+	}
+
+	//球とOBBの判定
+	if (((colliderA->GetCollisionPrimitive() & kCollisionPrimitiveSphere) != 0 && (colliderB->GetCollisionPrimitive() & kCollisionPrimitiveOBB) != 0) ||
+		((colliderA->GetCollisionPrimitive() & kCollisionPrimitiveOBB) != 0 && (colliderB->GetCollisionPrimitive() & kCollisionPrimitiveSphere) != 0))
+	{
+		//コライダーAがSphereでコライダーBがOBBの場合
+		if ((colliderA->GetCollisionPrimitive() & kCollisionPrimitiveSphere) && (colliderB->GetCollisionPrimitive() & kCollisionPrimitiveOBB))
+		{
+			//コライダーAのSphereを作成
+			Sphere sphere = { .center{colliderA->GetWorldPosition()},.radius{colliderA->GetRadius()} };
+			//コライダーBのOBBを取得
+			OBB obb = colliderB->GetWorldOBB();
+			//衝突判定
+			if (CheckCollisionSphereOBB(sphere, obb))
+			{
+				//コライダーAの衝突時コールバックを呼び出す
+				colliderA->OnCollision(colliderB);
+				//コライダーBの衝突時コールバックを呼び出す
+				colliderB->OnCollision(colliderA);
+				++hitCount;
+			}
+		}
+		//コライダーAがOBBでコライダーBがSphereの場合
+		else
+		{
+			//コライダーBのSphereを作成
+			Sphere sphere = { .center{colliderB->GetWorldPosition()},.radius{colliderB->GetRadius()} };
+			//コライダーAのOBBを取得
+			OBB obb = colliderA->GetWorldOBB();
+			//衝突判定
+			if (CheckCollisionSphereOBB(sphere, obb))
+			{
+				//コライダーAの衝突時コールバックを呼び出す
+				colliderA->OnCollision(colliderB);
+				//コライダーBの衝突時コールバックを呼び出す
+				colliderB->OnCollision(colliderA);
+				++hitCount;
 			}
 		}
 	}
+
+	return hitCount;
 }
 
-bool CollisionManager::CheckCollisionSphere(const Sphere& sphereA, const Sphere& sphereB)
+bool CollisionManager::CheckCollisionSphere(const Sphere& sphereA, const Sphere& sphereB) const
 {
-	//コライダーAとコライダーBの距離を計算
-	float distance = Mathf::Length(sphereA.center - sphereB.center);
-	//球と球の交差判定
-	if (distance <= sphereA.radius + sphereB.radius)
+	//コライダーAとコライダーBの距離の2乗を計算
+	Vector3 difference = sphereA.center - sphereB.center;
+	float distanceSquared = Mathf::Dot(difference, difference);
+	//球と球の交差判定(平方根を取らずに2乗同士で比べる)
+	float radius = sphereA.radius + sphereB.radius;
+	if (distanceSquared <= radius * radius)
 	{
 		return true;
 	}
 	return false;
 }
 
-bool CollisionManager::CheckCollisionSphereAABB(const Sphere& sphere, const AABB& aabb)
+bool CollisionManager::CheckCollisionSphereAABB(const Sphere& sphere, const AABB& aabb) const
 {
 	//最近接点を求める
 	Vector3 closestPoint{
@@ -190,17 +999,18 @@ bool CollisionManager::CheckCollisionSphereAABB(const Sphere& sphere, const AABB
 		std::clamp(sphere.center.y,aabb.min.y,aabb.max.y),
 		std::clamp(sphere.center.z,aabb.min.z,aabb.max.z)
 	};
-	//最近接点と球の中心との距離を求める
-	float distance = Mathf::Length(closestPoint - sphere.center);
+	//最近接点と球の中心との距離の2乗を求める
+	Vector3 difference = closestPoint - sphere.center;
+	float distanceSquared = Mathf::Dot(difference, difference);
 	//距離が半径よりも小さければ衝突
-	if (distance <= sphere.radius)
+	if (distanceSquared <= sphere.radius * sphere.radius)
 	{
 		return true;
 	}
 	return false;
 }
 
-bool CollisionManager::CheckCollisionAABB(const AABB& aabbA, const AABB& aabbB)
+bool CollisionManager::CheckCollisionAABB(const AABB& aabbA, const AABB& aabbB) const
 {
 	if (aabbA.min.x <= aabbB.max.x && aabbA.max.x >= aabbB.min.x &&
 		aabbA.min.y <= aabbB.max.y && aabbA.max.y >= aabbB.min.y &&
@@ -211,183 +1021,665 @@ bool CollisionManager::CheckCollisionAABB(const AABB& aabbA, const AABB& aabbB)
 	return false;
 }
 
-bool CollisionManager::CheckCollisionAABBOBB(const AABB& aabb, const OBB& obb)
+bool CollisionManager::CheckCollisionAABBOBB(const AABB& aabb, const OBB& obb) const
 {
-	Vector3 aabbCenter = (aabb.min + aabb.max) * 0.5f;
-
-	float aabbHalfSize[3] = {
-	0.5f * (aabb.max.x - aabb.min.x),
-	0.5f * (aabb.max.y - aabb.min.y),
-	0.5f * (aabb.max.z - aabb.min.z),
+	//AABBを軸が座標軸のOBBとして判定する
+	OBB aabbOBB = {
+		.center{(aabb.min + aabb.max) * 0.5f},
+		.orientations{{1.0f,0.0f,0.0f},{0.0f,1.0f,0.0f},{0.0f,0.0f,1.0f}},
+		.size{(aabb.max - aabb.min) * 0.5f},
 	};
+	return CheckCollisionOBB(aabbOBB, obb);
+}
+
+bool CollisionManager::CheckCollisionOBB(const OBB& obbA, const OBB& obbB) const
+{
+	//外積の軸が潰れた時に誤って分離しないように足す誤差
+	const float kEpsilon = 1.0e-6f;
 
-	Vector3 NAe1 = { 1.0f,0.0f,0.0f };
-	Vector3 Ae1 = NAe1 * aabbHalfSize[0];
-	Vector3 NAe2 = { 0.0f,1.0f,0.0f };
-	Vector3 Ae2 = NAe2 * aabbHalfSize[1];
-	Vector3 NAe3 = { 0.0f,0.0f,1.0f };
-	Vector3 Ae3 = NAe3 * aabbHalfSize[2];
+	float extentA[3] = { obbA.size.x,obbA.size.y,obbA.size.z };
+	float extentB[3] = { obbB.size.x,obbB.size.y,obbB.size.z };
 
-	Vector3 NBe1 = obb.orientations[0];
-	Vector3 Be1 = NBe1 * obb.size.x;
-	Vector3 NBe2 = obb.orientations[1];
-	Vector3 Be2 = NBe2 * obb.size.y;
-	Vector3 NBe3 = obb.orientations[2];
-	Vector3 Be3 = NBe3 * obb.size.z;
+	//中心間のベクトル
+	Vector3 interval = obbB.center - obbA.center;
 
-	Vector3 Interval = aabbCenter - obb.center;
+	//Bの軸をAの座標系で表した回転行列とその絶対値、中心間のベクトルをAの座標系で表したもの
+	float rotation[3][3]{};
+	float absRotation[3][3]{};
+	float t[3]{};
 
-	//文理軸 Ae1
-	float rA = Mathf::Length(Ae1);
-	float rB = LenSegOnSeparateAxis(&NAe1, &Be1, &Be2, &Be3);
-	float L = fabs(Mathf::Dot(Interval, NAe1));
-	if (L > rA + rB)
+	//分離軸 : Aの軸(回転行列は1行ずつ計算して分離していればすぐに抜ける)
+	float rA = 0.0f;
+	float rB = 0.0f;
+	for (uint32_t i = 0; i < 3; ++i)
 	{
-		return false;
+		for (uint32_t j = 0; j < 3; ++j)
+		{
+			rotation[i][j] = Mathf::Dot(obbA.orientations[i], obbB.orientations[j]);
+			absRotation[i][j] = std::abs(rotation[i][j]) + kEpsilon;
+		}
+		t[i] = Mathf::Dot(interval, obbA.orientations[i]);
+
+		rA = extentA[i];
+		rB = extentB[0] * absRotation[i][0] + extentB[1] * absRotation[i][1] + extentB[2] * absRotation[i][2];
+		if (std::abs(t[i]) > rA + rB)
+		{
+			return false;
+		}
 	}
 
-	// 分離軸 : Ae2
-	rA = Mathf::Length(Ae2);
-	rB = LenSegOnSeparateAxis(&NAe2, &Be1, &Be2, &Be3);
-	L = fabs(Mathf::Dot(Interval, NAe2));
-	if (L > rA + rB)
+	//分離軸 : Bの軸
+	for (uint32_t j = 0; j < 3; ++j)
 	{
-		return false;
+		rA = extentA[0] * absRotation[0][j] + extentA[1] * absRotation[1][j] + extentA[2] * absRotation[2][j];
+		rB = extentB[j];
+		if (std::abs(t[0] * rotation[0][j] + t[1] * rotation[1][j] + t[2] * rotation[2][j]) > rA + rB)
+		{
+			return false;
+		}
 	}
 
-	// 分離軸 : Ae3
-	rA = Mathf::Length(Ae3);
-	rB = LenSegOnSeparateAxis(&NAe3, &Be1, &Be2, &Be3);
-	L = fabs(Mathf::Dot(Interval, NAe3));
-	if (L > rA + rB)
+	//分離軸 : Aの軸iとBの軸jの外積
+	for (uint32_t i = 0; i < 3; ++i)
 	{
-		return false;
+		uint32_t i1 = (i + 1) % 3;
+		uint32_t i2 = (i + 2) % 3;
+		for (uint32_t j = 0; j < 3; ++j)
+		{
+			uint32_t j1 = (j + 1) % 3;
+			uint32_t j2 = (j + 2) % 3;
+			rA = extentA[i1] * absRotation[i2][j] + extentA[i2] * absRotation[i1][j];
+			rB = extentB[j1] * absRotation[i][j2] + extentB[j2] * absRotation[i][j1];
+			if (std::abs(t[i2] * rotation[i1][j] - t[i1] * rotation[i2][j]) > rA + rB)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool CollisionManager::CheckCollisionSphereOBB(const Sphere& sphere, const OBB& obb) const
+{
+	//球の中心をOBBの座標系に移してクランプし、最近接点までの距離の2乗を求める
+	Vector3 interval = sphere.center - obb.center;
+	float extent[3] = { obb.size.x,obb.size.y,obb.size.z };
+	float distanceSquared = 0.0f;
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		float distance = Mathf::Dot(interval, obb.orientations[i]);
+		float excess = std::abs(distance) - extent[i];
+		if (excess > 0.0f)
+		{
+			distanceSquared += excess * excess;
+			//半径を超えた時点で当たらないことが確定する
+			if (distanceSquared > sphere.radius * sphere.radius)
+			{
+				return false;
+			}
+		}
 	}
+	return true;
+}
 
-	// 分離軸 : Be1
-	rA = LenSegOnSeparateAxis(&NBe1, &Ae1, &Ae2, &Ae3);
-	rB = Mathf::Length(Be1);
-	L = fabs(Mathf::Dot(Interval, NBe1));
-	if (L > rA + rB)
+bool CollisionManager::Raycast(const Ray& ray, float maxDistance, uint32_t collisionMask, RaycastHit& hit) const
+{
+	//半径0のスフィアキャストとして判定する
+	return SphereCast(ray, 0.0f, maxDistance, collisionMask, hit);
+}
+
+bool CollisionManager::Linecast(const Vector3& start, const Vector3& end, uint32_t collisionMask, RaycastHit& hit) const
+{
+	//線分を始点からの長さが決まったレイとして判定する
+	Vector3 difference = end - start;
+	float length = Mathf::Length(difference);
+	if (length == 0.0f)
 	{
+		hit = {};
 		return false;
 	}
+	Ray ray = { .origin{start},.direction{difference / length} };
+	return Raycast(ray, length, collisionMask, hit);
+}
+
+void CollisionManager::RaycastAll(const Ray& ray, float maxDistance, uint32_t collisionMask, std::vector<RaycastHit>& hits) const
+{
+	hits.clear();
+	Ray normalizedRay = { .origin{ray.origin},.direction{Mathf::Normalize(ray.direction)} };
+	if (Mathf::Dot(normalizedRay.direction, normalizedRay.direction) == 0.0f)
+	{
+		return;
+	}
+
+	//最大距離を縮めずに全てのコライダーを集める
+	QueryRay(normalizedRay, maxDistance, 0.0f, collisionMask, [&](size_t index, float currentMaxDistance)
+		{
+			RaycastHit hit{};
+			if (IntersectRayCollider(index, normalizedRay, 0.0f, currentMaxDistance, hit))
+			{
+				hits.push_back(hit);
+			}
+			return currentMaxDistance;
+		}
+	);
+
+	//近い順に並べる
+	std::sort(hits.begin(), hits.end(), [](const RaycastHit& lhs, const RaycastHit& rhs)
+		{
+			return lhs.distance < rhs.distance;
+		}
+	);
+}
+
+void CollisionManager::RaycastBatch(const std::vector<Ray>& rays, float maxDistance, uint32_t collisionMask, std::vector<RaycastHit>& hits) const
+{
+	hits.resize(rays.size());
+
+	//レイごとに独立しているのでワーカースレッドで分担する
+	auto raycastRange = [&](uint32_t begin, uint32_t end, uint32_t)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				Raycast(rays[i], maxDistance, collisionMask, hits[i]);
+			}
+		};
+
+	if (isMultithreaded_)
+	{
+		ThreadPool::GetInstance()->ParallelFor(uint32_t(rays.size()), kRaysPerChunk, raycastRange);
+	}
+	else
+	{
+		raycastRange(0, uint32_t(rays.size()), 0);
+	}
+}
+
+uint32_t CollisionManager::GetQueryLayerMask(uint32_t collisionMask) const
+{
+	uint32_t layerMask = 0;
+	for (uint32_t layer = 0; layer < kCollisionLayerCount; ++layer)
+	{
+		if ((layerAttributes_[layer] & collisionMask) != 0)
+		{
+			layerMask |= 1u << layer;
+		}
+	}
+	return layerMask;
+}
 
-	// 分離軸 : Be2
-	rA = LenSegOnSeparateAxis(&NBe2, &Ae1, &Ae2, &Ae3);
-	rB = Mathf::Length(Be2);
-	L = fabs(Mathf::Dot(Interval, NBe2));
-	if (L > rA + rB)
+bool CollisionManager::SphereCast(const Ray& ray, float radius, float maxDistance, uint32_t collisionMask, RaycastHit& hit) const
+{
+	hit = {};
+	Ray normalizedRay = { .origin{ray.origin},.direction{Mathf::Normalize(ray.direction)} };
+	if (Mathf::Dot(normalizedRay.direction, normalizedRay.direction) == 0.0f)
 	{
 		return false;
 	}
 
-	// 分離軸 : Be3
-	rA = LenSegOnSeparateAxis(&NBe3, &Ae1, &Ae2, &Ae3);
-	rB = Mathf::Length(Be3);
-	L = fabs(Mathf::Dot(Interval, NBe3));
-	if (L > rA + rB)
+	//当たる度に最大距離を縮めて一番近いコライダーを探す
+	QueryRay(normalizedRay, maxDistance, radius, collisionMask, [&](size_t index, float currentMaxDistance)
+		{
+			RaycastHit candidate{};
+			if (IntersectRayCollider(index, normalizedRay, radius, currentMaxDistance, candidate))
+			{
+				hit = candidate;
+				return candidate.distance;
+			}
+			return currentMaxDistance;
+		}
+	);
+
+	return hit.collider != nullptr;
+}
+
+void CollisionManager::OverlapSphere(const Sphere& sphere, uint32_t collisionMask, std::vector<Collider*>& colliders) const
+{
+	colliders.clear();
+	AABB aabb = {
+		.min{sphere.center.x - sphere.radius,sphere.center.y - sphere.radius,sphere.center.z - sphere.radius},
+		.max{sphere.center.x + sphere.radius,sphere.center.y + sphere.radius,sphere.center.z + sphere.radius},
+	};
+
+	//AABBで絞り込んだ後にコライダーの形状と判定する
+	QueryAABB(aabb, collisionMask, [&](size_t index)
+		{
+			uint32_t primitive = colliderSoA_.GetCollisionPrimitive(index);
+			if (((primitive & kCollisionPrimitiveSphere) && CheckCollisionSphere(sphere, { .center{colliderSoA_.GetCenter(index)},.radius{colliderSoA_.GetRadius(index)} })) ||
+				((primitive & kCollisionPrimitiveAABB) && CheckCollisionSphereAABB(sphere, colliderSoA_.GetAABB(index))) ||
+				((primitive & kCollisionPrimitiveOBB) && CheckCollisionSphereOBB(sphere, colliderSoA_.GetOBB(index))))
+			{
+				colliders.push_back(colliderArray_[index]);
+			}
+		}
+	);
+}
+
+void CollisionManager::OverlapAABB(const AABB& aabb, uint32_t collisionMask, std::vector<Collider*>& colliders) const
+{
+	colliders.clear();
+
+	//AABBで絞り込んだ後にコライダーの形状と判定する
+	QueryAABB(aabb, collisionMask, [&](size_t index)
+		{
+			uint32_t primitive = colliderSoA_.GetCollisionPrimitive(index);
+			if (((primitive & kCollisionPrimitiveSphere) && CheckCollisionSphereAABB({ .center{colliderSoA_.GetCenter(index)},.radius{colliderSoA_.GetRadius(index)} }, aabb)) ||
+				((primitive & kCollisionPrimitiveAABB) && CheckCollisionAABB(colliderSoA_.GetAABB(index), aabb)) ||
+				((primitive & kCollisionPrimitiveOBB) && CheckCollisionAABBOBB(aabb, colliderSoA_.GetOBB(index))))
+			{
+				colliders.push_back(colliderArray_[index]);
+			}
+		}
+	);
+}
+
+bool CollisionManager::IntersectRayCollider(size_t index, const Ray& ray, float radius, float maxDistance, RaycastHit& hit) const
+{
+	//コライダーが持っている形状のうち一番近いものを探す
+	uint32_t primitive = colliderSoA_.GetCollisionPrimitive(index);
+	float nearestDistance = maxDistance;
+	Vector3 nearestNormal{};
+	bool isHit = false;
+	float distance = 0.0f;
+	Vector3 normal{};
+
+	//球(キャストする球の半径分膨らませる)
+	if (primitive & kCollisionPrimitiveSphere)
+	{
+		Sphere sphere = { .center{colliderSoA_.GetCenter(index)},.radius{colliderSoA_.GetRadius(index) + radius} };
+		if (IntersectRaySphere(ray, sphere, nearestDistance, distance, normal))
+		{
+			nearestDistance = distance;
+			nearestNormal = normal;
+			isHit = true;
+		}
+	}
+
+	//AABB
+	if (primitive & kCollisionPrimitiveAABB)
+	{
+		if (IntersectRayAABB(ray, radius, colliderSoA_.GetAABB(index), nearestDistance, distance, normal) && (!isHit || distance < nearestDistance))
+		{
+			nearestDistance = distance;
+			nearestNormal = normal;
+			isHit = true;
+		}
+	}
+
+	//OBB
+	if (primitive & kCollisionPrimitiveOBB)
+	{
+		if (IntersectRayOBB(ray, radius, colliderSoA_.GetOBB(index), nearestDistance, distance, normal) && (!isHit || distance < nearestDistance))
+		{
+			nearestDistance = distance;
+			nearestNormal = normal;
+			isHit = true;
+		}
+	}
+
+	if (!isHit)
 	{
 		return false;
 	}
 
-	// 分離軸 : C11
-	Vector3 Cross = Mathf::Cross(NAe1, NBe1);
-	rA = LenSegOnSeparateAxis(&Cross, &Ae2, &Ae3, 0);
-	rB = LenSegOnSeparateAxis(&Cross, &Be2, &Be3, 0);
-	L = fabs(Mathf::Dot(Interval, Cross));
-	if (L > rA + rB)
+	hit.collider = colliderArray_[index];
+	hit.distance = nearestDistance;
+	hit.normal = nearestNormal;
+	//スフィアキャストの場合は球の表面の接触点
+	hit.point = ray.origin + ray.direction * nearestDistance - nearestNormal * radius;
+	return true;
+}
+
+bool CollisionManager::IntersectRaySphere(const Ray& ray, const Sphere& sphere, float maxDistance, float& distance, Vector3& normal) const
+{
+	Vector3 m = ray.origin - sphere.center;
+	float b = Mathf::Dot(m, ray.direction);
+	float c = Mathf::Dot(m, m) - sphere.radius * sphere.radius;
+
+	//始点が球の外にあって球から遠ざかっている
+	if (c > 0.0f && b > 0.0f)
 	{
 		return false;
 	}
 
-	// 分離軸 : C12
-	Cross = Mathf::Cross(NAe1, NBe2);
-	rA = LenSegOnSeparateAxis(&Cross, &Ae2, &Ae3, 0);
-	rB = LenSegOnSeparateAxis(&Cross, &Be1, &Be3, 0);
-	L = fabs(Mathf::Dot(Interval, Cross));
-	if (L > rA + rB)
+	float discriminant = b * b - c;
+	if (discriminant < 0.0f)
 	{
 		return false;
 	}
 
-	// 分離軸 : C13
-	Cross = Mathf::Cross(NAe1, NBe3);
-	rA = LenSegOnSeparateAxis(&Cross, &Ae2, &Ae3, 0);
-	rB = LenSegOnSeparateAxis(&Cross, &Be1, &Be2, 0);
-	L = fabs(Mathf::Dot(Interval, Cross));
-	if (L > rA + rB)
+	//始点が球の中にある場合は距離0で当たったことにする
+	float t = -b - std::sqrt(discriminant);
+	if (t < 0.0f)
+	{
+		distance = 0.0f;
+		normal = ray.direction * -1.0f;
+		return true;
+	}
+
+	if (t > maxDistance)
 	{
 		return false;
 	}
 
-	// 分離軸 : C21
-	Cross = Mathf::Cross(NAe2, NBe1);
-	rA = LenSegOnSeparateAxis(&Cross, &Ae1, &Ae3, 0);
-	rB = LenSegOnSeparateAxis(&Cross, &Be2, &Be3, 0);
-	L = fabs(Mathf::Dot(Interval, Cross));
-	if (L > rA + rB)
+	distance = t;
+	normal = Mathf::Normalize(ray.origin + ray.direction * t - sphere.center);
+	return true;
+}
+
+bool CollisionManager::IntersectRayAABB(const Ray& ray, float radius, const AABB& aabb, float maxDistance, float& distance, Vector3& normal) const
+{
+	const float boxMin[3] = { aabb.min.x,aabb.min.y,aabb.min.z };
+	const float boxMax[3] = { aabb.max.x,aabb.max.y,aabb.max.z };
+	const float origin[3] = { ray.origin.x,ray.origin.y,ray.origin.z };
+	const float direction[3] = { ray.direction.x,ray.direction.y,ray.direction.z };
+
+	//始点が既に重なっている場合は距離0で当たったことにする
+	float distanceSquared = 0.0f;
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		float excess = (std::max)(boxMin[i] - origin[i], 0.0f) + (std::max)(origin[i] - boxMax[i], 0.0f);
+		distanceSquared += excess * excess;
+	}
+	if (distanceSquared <= radius * radius)
+	{
+		distance = 0.0f;
+		normal = ray.direction * -1.0f;
+		return true;
+	}
+
+	//半径分膨らませたAABBにスラブ法で入る位置を求める
+	float tMin = 0.0f;
+	float tMax = maxDistance;
+	int32_t hitAxis = -1;
+	float hitSign = 0.0f;
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		if (std::abs(direction[i]) < 1.0e-8f)
+		{
+			if (origin[i] < boxMin[i] - radius || origin[i] > boxMax[i] + radius)
+			{
+				return false;
+			}
+			continue;
+		}
+
+		float inverseDirection = 1.0f / direction[i];
+		float t1 = (boxMin[i] - radius - origin[i]) * inverseDirection;
+		float t2 = (boxMax[i] + radius - origin[i]) * inverseDirection;
+		float sign = -1.0f;
+		if (t1 > t2)
+		{
+			std::swap(t1, t2);
+			sign = 1.0f;
+		}
+		if (t1 > tMin)
+		{
+			tMin = t1;
+			hitAxis = int32_t(i);
+			hitSign = sign;
+		}
+		tMax = (std::min)(tMax, t2);
+		if (tMin > tMax)
+		{
+			return false;
+		}
+	}
+
+	//入った位置が元のAABBのどの領域にあるかを調べる
+	float point[3]{};
+	float corner[3]{};
+	bool isOutside[3]{};
+	uint32_t outsideCount = 0;
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		point[i] = origin[i] + direction[i] * tMin;
+		isOutside[i] = point[i] < boxMin[i] || point[i] > boxMax[i];
+		corner[i] = point[i] < boxMin[i] ? boxMin[i] : boxMax[i];
+		outsideCount += isOutside[i] ? 1 : 0;
+	}
+
+	//面の領域ならそのまま膨らませたAABBの面に当たっている
+	if (outsideCount <= 1 || radius <= 0.0f)
+	{
+		if (hitAxis < 0)
+		{
+			return false;
+		}
+		float normalArray[3] = { 0.0f,0.0f,0.0f };
+		normalArray[hitAxis] = hitSign;
+		distance = tMin;
+		normal = { normalArray[0],normalArray[1],normalArray[2] };
+		return true;
+	}
+
+	//辺や頂点の領域なら角の丸まった部分(辺の円柱と頂点の球)と判定する
+	float nearestDistance = maxDistance;
+	Vector3 nearestNormal{};
+	bool isHit = false;
+	for (uint32_t axis = 0; axis < 3; ++axis)
+	{
+		uint32_t u = (axis + 1) % 3;
+		uint32_t v = (axis + 2) % 3;
+		if (!isOutside[u] || !isOutside[v])
+		{
+			continue;
+		}
+
+		//axis方向に伸びる辺の円柱
+		float du = direction[u];
+		float dv = direction[v];
+		float ou = origin[u] - corner[u];
+		float ov = origin[v] - corner[v];
+		float a = du * du + dv * dv;
+		if (a > 1.0e-12f)
+		{
+			float b = ou * du + ov * dv;
+			float c = ou * ou + ov * ov - radius * radius;
+			float discriminant = b * b - a * c;
+			if (discriminant >= 0.0f)
+			{
+				float t = (-b - std::sqrt(discriminant)) / a;
+				float along = origin[axis] + direction[axis] * t;
+				if (t >= 0.0f && t <= nearestDistance && along >= boxMin[axis] && along <= boxMax[axis])
+				{
+					float normalArray[3]{};
+					normalArray[u] = ou + du * t;
+					normalArray[v] = ov + dv * t;
+					nearestDistance = t;
+					nearestNormal = Mathf::Normalize(Vector3{ normalArray[0],normalArray[1],normalArray[2] });
+					isHit = true;
+				}
+			}
+		}
+
+		//辺の両端の頂点の球
+		const float ends[2] = { boxMin[axis],boxMax[axis] };
+		for (float end : ends)
+		{
+			float vertex[3]{};
+			vertex[axis] = end;
+			vertex[u] = corner[u];
+			vertex[v] = corner[v];
+			Sphere sphere = { .center{vertex[0],vertex[1],vertex[2]},.radius{radius} };
+			float t = 0.0f;
+			Vector3 sphereNormal{};
+			if (IntersectRaySphere(ray, sphere, nearestDistance, t, sphereNormal) && (!isHit || t < nearestDistance))
+			{
+				nearestDistance = t;
+				nearestNormal = sphereNormal;
+				isHit = true;
+			}
+		}
+	}
+
+	if (!isHit)
 	{
 		return false;
 	}
 
-	// 分離軸 : C22
-	Cross = Mathf::Cross(NAe2, NBe2);
-	rA = LenSegOnSeparateAxis(&Cross, &Ae1, &Ae3, 0);
-	rB = LenSegOnSeparateAxis(&Cross, &Be1, &Be3, 0);
-	L = fabs(Mathf::Dot(Interval, Cross));
-	if (L > rA + rB)
+	distance = nearestDistance;
+	normal = nearestNormal;
+	return true;
+}
+
+bool CollisionManager::IntersectRayOBB(const Ray& ray, float radius, const OBB& obb, float maxDistance, float& distance, Vector3& normal) const
+{
+	//レイをOBBの座標系に移してAABBとして判定する
+	Vector3 interval = ray.origin - obb.center;
+	Ray localRay = {
+		.origin{Mathf::Dot(interval, obb.orientations[0]),Mathf::Dot(interval, obb.orientations[1]),Mathf::Dot(interval, obb.orientations[2])},
+		.direction{Mathf::Dot(ray.direction, obb.orientations[0]),Mathf::Dot(ray.direction, obb.orientations[1]),Mathf::Dot(ray.direction, obb.orientations[2])},
+	};
+	AABB localAABB = { .min{obb.size * -1.0f},.max{obb.size} };
+
+	Vector3 localNormal{};
+	if (!IntersectRayAABB(localRay, radius, localAABB, maxDistance, distance, localNormal))
 	{
 		return false;
 	}
 
-	// 分離軸 : C23
-	Cross = Mathf::Cross(NAe2, NBe3);
-	rA = LenSegOnSeparateAxis(&Cross, &Ae1, &Ae3, 0);
-	rB = LenSegOnSeparateAxis(&Cross, &Be1, &Be2, 0);
-	L = fabs(Mathf::Dot(Interval, Cross));
-	if (L > rA + rB)
+	//法線をワールド空間に戻す
+	normal = obb.orientations[0] * localNormal.x + obb.orientations[1] * localNormal.y + obb.orientations[2] * localNormal.z;
+	return true;
+}
+
+bool CollisionManager::CheckContinuousCollision(size_t indexA, size_t indexB, float& timeOfImpact) const
+{
+	//衝突フィルタリング
+	if ((colliderSoA_.GetCollisionAttribute(indexA) & colliderSoA_.GetCollisionMask(indexB)) == 0 ||
+		(colliderSoA_.GetCollisionAttribute(indexB) & colliderSoA_.GetCollisionMask(indexA)) == 0)
 	{
 		return false;
 	}
 
-	// 分離軸 : C31
-	Cross = Mathf::Cross(NAe3, NBe1);
-	rA = LenSegOnSeparateAxis(&Cross, &Ae1, &Ae2, 0);
-	rB = LenSegOnSeparateAxis(&Cross, &Be2, &Be3, 0);
-	L = fabs(Mathf::Dot(Interval, Cross));
-	if (L > rA + rB)
+	//連続衝突判定が有効な方の球を動かす
+	size_t moverIndex = indexA;
+	size_t targetIndex = indexB;
+	if (!colliderSoA_.GetIsContinuous(indexA))
+	{
+		if (!colliderSoA_.GetIsContinuous(indexB))
+		{
+			return false;
+		}
+		std::swap(moverIndex, targetIndex);
+	}
+
+	//相手を今フレームの位置に固定した時の相対的な移動を求める(相手が連続衝突判定を行わない場合は止まっているとみなす)
+	Vector3 targetMovement = colliderSoA_.GetCenter(targetIndex) - colliderSoA_.GetPreviousCenter(targetIndex);
+	Vector3 start = colliderSoA_.GetPreviousCenter(moverIndex) + targetMovement;
+	Vector3 movement = colliderSoA_.GetCenter(moverIndex) - start;
+	float length = Mathf::Length(movement);
+	if (length <= 0.0f)
 	{
 		return false;
 	}
 
-	// 分離軸 : C32
-	Cross = Mathf::Cross(NAe3, NBe2);
-	rA = LenSegOnSeparateAxis(&Cross, &Ae1, &Ae2, 0);
-	rB = LenSegOnSeparateAxis(&Cross, &Be1, &Be3, 0);
-	L = fabs(Mathf::Dot(Interval, Cross));
-	if (L > rA + rB)
+	//移動する球を相手の形状に対してスフィアキャストする
+	Ray ray = { .origin{start},.direction{movement / length} };
+	RaycastHit hit{};
+	if (!IntersectRayCollider(targetIndex, ray, colliderSoA_.GetRadius(moverIndex), length, hit))
 	{
 		return false;
 	}
 
-	// 分離軸 : C33
-	Cross = Mathf::Cross(NAe3, NBe3);
-	rA = LenSegOnSeparateAxis(&Cross, &Ae1, &Ae2, 0);
-	rB = LenSegOnSeparateAxis(&Cross, &Be1, &Be2, 0);
-	L = fabs(Mathf::Dot(Interval, Cross));
-	if (L > rA + rB)
+	//移動前から重なっていた場合は前フレームで当たっているので除く
+	if (hit.distance <= 0.0f)
 	{
 		return false;
 	}
 
+	timeOfImpact = hit.distance / length;
 	return true;
 }
 
-float CollisionManager::LenSegOnSeparateAxis(Vector3* Sep, Vector3* e1, Vector3* e2, Vector3* e3)
+void CollisionManager::NotifyContinuousCollision(Collider* colliderA, Collider* colliderB, float timeOfImpact)
+{
+	//当たった時刻をOnCollisionの中で取得できるようにする
+	colliderA->SetTimeOfImpact(timeOfImpact);
+	colliderB->SetTimeOfImpact(timeOfImpact);
+	//コライダーAの衝突時コールバックを呼び出す
+	colliderA->OnCollision(colliderB);
+	//コライダーBの衝突時コールバックを呼び出す
+	colliderB->OnCollision(colliderA);
+	//離散的な判定の時は1に戻す
+	colliderA->SetTimeOfImpact(1.0f);
+	colliderB->SetTimeOfImpact(1.0f);
+}
+
+size_t CollisionManager::PairKeyHash::operator()(const PairKey& key) const
+{
+	return std::hash<uint64_t>()((uint64_t(key.colliderIdA) << 32) | key.colliderIdB);
+}
+
+CollisionManager::PairKey CollisionManager::MakePairKey(const Collider* colliderA, const Collider* colliderB)
+{
+	//どちらの順番で渡しても同じキーになるようにする
+	uint32_t colliderIdA = colliderA->GetColliderId();
+	uint32_t colliderIdB = colliderB->GetColliderId();
+	return { (std::min)(colliderIdA,colliderIdB),(std::max)(colliderIdA,colliderIdB) };
+}
+
+void CollisionManager::UpdatePersistentPair(Collider* colliderA, Collider* colliderB, uint32_t hitCount, float timeOfImpact)
+{
+	//前フレームから当たっていれば既に登録されている
+	PairKey key = MakePairKey(colliderA, colliderB);
+	std::pair<std::unordered_map<PairKey, PersistentPair, PairKeyHash>::iterator, bool> result = persistentPairs_.try_emplace(key);
+	bool isSwapped = key.colliderIdA != colliderA->GetColliderId();
+	result.first->second = { isSwapped ? colliderB : colliderA,isSwapped ? colliderA : colliderB,frame_,hitCount,timeOfImpact };
+
+	if (result.second)
+	{
+		//当たり始めた時のコールバックを呼び出す
+		colliderA->OnCollisionEnter(colliderB);
+		colliderB->OnCollisionEnter(colliderA);
+	}
+	else
+	{
+		//当たり続けている時のコールバックを呼び出す
+		colliderA->OnCollisionStay(colliderB);
+		colliderB->OnCollisionStay(colliderA);
+	}
+}
+
+void CollisionManager::NotifyCollisionExits()
 {
-	float r1 = fabs(Mathf::Dot(*Sep, *e1));
-	float r2 = fabs(Mathf::Dot(*Sep, *e2));
-	float r3 = e3 ? (fabs(Mathf::Dot(*Sep, *e3))) : 0;
-	return r1 + r2 + r3;
-}
\ No newline at end of file
+	//今フレームで当たらなかったペアを削除する
+	exitPairs_.clear();
+	for (std::unordered_map<PairKey, PersistentPair, PairKeyHash>::iterator it = persistentPairs_.begin(); it != persistentPairs_.end();)
+	{
+		if (it->second.frame == frame_)
+		{
+			++it;
+			continue;
+		}
+
+		//両方とも今フレームも登録されていればコールバックを呼ぶ(削除されたコライダーには触らない)
+		//同じアドレスに別のコライダーが作られた場合は番号が違うので削除されたものとして扱う
+		std::unordered_map<const Collider*, ColliderState>::const_iterator stateA = colliderStates_.find(it->second.colliderA);
+		std::unordered_map<const Collider*, ColliderState>::const_iterator stateB = colliderStates_.find(it->second.colliderB);
+		if (stateA != colliderStates_.end() && stateB != colliderStates_.end() &&
+			stateA->second.colliderId == it->first.colliderIdA && stateB->second.colliderId == it->first.colliderIdB)
+		{
+			uint32_t indexA = stateA->second.index;
+			uint32_t indexB = stateB->second.index;
+			exitPairs_.push_back({ (std::min)(indexA,indexB),(std::max)(indexA,indexB) });
+		}
+		it = persistentPairs_.erase(it);
+	}
+
+	//ハッシュの順番に依存しないようにリストの順番で呼ぶ
+	std::sort(exitPairs_.begin(), exitPairs_.end(), [](const CollisionPair& lhs, const CollisionPair& rhs)
+		{
+			return lhs.indexA != rhs.indexA ? lhs.indexA < rhs.indexA : lhs.indexB < rhs.indexB;
+		}
+	);
+	for (const CollisionPair& exitPair : exitPairs_)
+	{
+		Collider* colliderA = colliderArray_[exitPair.indexA];
+		Collider* colliderB = colliderArray_[exitPair.indexB];
+		//離れた時のコールバックを呼び出す
+		colliderA->OnCollisionExit(colliderB);
+		colliderB->OnCollisionExit(colliderA);
+	}
+}
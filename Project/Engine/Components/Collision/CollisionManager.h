@@ -1,30 +1,419 @@
 #pragma once
 #include "Collider.h"
+#include "ColliderSoA.h"
+#include "CollisionConfig.h"
+#include "DynamicAABBTree.h"
+#include "SpatialHashGrid.h"
+#include "Engine/Math/Ray.h"
+#include <array>
 #include <list>
+#include <unordered_map>
+#include <vector>
+
+struct RaycastHit
+{
+	Collider* collider = nullptr;//当たったコライダー。当たらなかった場合はnullptr
+	Vector3 point{};//当たった位置
+	Vector3 normal{};//当たった面の法線
+	float distance = 0.0f;//始点からの距離
+};
 
 class CollisionManager
 {
 public:
+	enum BroadPhaseType
+	{
+		//総当たり
+		kBroadPhaseBruteForce,
+		//動的AABB木
+		kBroadPhaseDynamicAABBTree,
+		//空間ハッシュグリッド
+		kBroadPhaseSpatialHash,
+	};
+
+	//毎フレーム登録しなおす場合に使う。登録したコライダーは毎フレーム全ての情報を取得しなおす
 	void ClearColliderList();
 
 	void SetColliderList(Collider* collider);
 
+	//一度登録すれば解除するまで判定し続ける。情報はSetIsDirty(true)にしたフレームだけ取得しなおす
+	void RegisterCollider(Collider* collider);
+
+	//登録を解除する。コライダーを削除する前に必ず呼ぶ
+	void UnregisterCollider(Collider* collider);
+
 	void CheckAllCollisions();
 
+	const BroadPhaseType GetBroadPhaseType() const { return broadPhaseType_; };
+
+	void SetBroadPhaseType(BroadPhaseType broadPhaseType);
+
+	const float GetCellSize() const { return cellSize_; };
+
+	//0以下を設定するとコライダーの大きさから自動で決める
+	void SetCellSize(float cellSize);
+
+	const bool GetIsMultithreaded() const { return isMultithreaded_; };
+
+	void SetIsMultithreaded(bool isMultithreaded) { isMultithreaded_ = isMultithreaded; };
+
+	//以下のクエリは直前のCheckAllCollisionsの時点のコライダーに対して判定する
+	//collisionMaskと衝突属性が重なるコライダーだけが対象になる
+	bool Raycast(const Ray& ray, float maxDistance, uint32_t collisionMask, RaycastHit& hit) const;
+
+	bool Linecast(const Vector3& start, const Vector3& end, uint32_t collisionMask, RaycastHit& hit) const;
+
+	//距離の近い順に並べて返す
+	void RaycastAll(const Ray& ray, float maxDistance, uint32_t collisionMask, std::vector<RaycastHit>& hits) const;
+
+	//複数のレイを並列に判定する。hitsはraysと同じ順番で、当たらなかったものはcolliderがnullptrになる
+	void RaycastBatch(const std::vector<Ray>& rays, float maxDistance, uint32_t collisionMask, std::vector<RaycastHit>& hits) const;
+
+	bool SphereCast(const Ray& ray, float radius, float maxDistance, uint32_t collisionMask, RaycastHit& hit) const;
+
+	void OverlapSphere(const Sphere& sphere, uint32_t collisionMask, std::vector<Collider*>& colliders) const;
+
+	void OverlapAABB(const AABB& aabb, uint32_t collisionMask, std::vector<Collider*>& colliders) const;
+
+	//形状同士の判定(OBBはワールド座標で渡す)
+	bool CheckCollisionSphere(const Sphere& sphereA, const Sphere& sphereB) const;
+
+	bool CheckCollisionSphereAABB(const Sphere& sphere, const AABB& aabb) const;
+
+	bool CheckCollisionAABB(const AABB& aabbA, const AABB& aabbB) const;
+
+	bool CheckCollisionAABBOBB(const AABB& aabb, const OBB& obb) const;
+
+	bool CheckCollisionOBB(const OBB& obbA, const OBB& obbB) const;
+
+	bool CheckCollisionSphereOBB(const Sphere& sphere, const OBB& obb) const;
+
 private:
-	void CheckCollisionPair(Collider* colliderA, Collider* colliderB);
+	struct Contact
+	{
+		uint32_t pairIndex;//候補ペアの番号
+		uint32_t hitCount;//当たった判定の数
+		float timeOfImpact;//移動中に当たった時刻(連続衝突判定以外は1)
+	};
+
+	//コライダーの番号の組み合わせ(番号の小さい方がcolliderIdA)
+	//削除したコライダーと同じアドレスに別のコライダーが作られても別のペアになるようにアドレスは使わない
+	struct PairKey
+	{
+		uint32_t colliderIdA;
+		uint32_t colliderIdB;
+
+		bool operator==(const PairKey& rhs) const { return colliderIdA == rhs.colliderIdA && colliderIdB == rhs.colliderIdB; };
+	};
+
+	struct PairKeyHash
+	{
+		size_t operator()(const PairKey& key) const;
+	};
+
+	//前フレームから当たり続けているペア
+	struct PersistentPair
+	{
+		const Collider* colliderA;//colliderIdAのコライダー
+		const Collider* colliderB;//colliderIdBのコライダー
+		uint32_t frame;//最後に当たったフレーム
+		uint32_t hitCount;
+		float timeOfImpact;
+	};
+
+	//変化したかどうかを調べるためのコライダーの情報
+	struct ColliderSnapshot
+	{
+		Vector3 center;
+		Vector3 previousCenter;
+		float radius;
+		AABB aabb;
+		OBB obb;
+		uint32_t attribute;
+		uint32_t mask;
+		uint32_t primitive;
+	};
+
+	struct Proxy
+	{
+		int32_t proxyId;
+		uint32_t layer;//登録している木のレイヤー
+	};
+
+	struct ColliderState
+	{
+		uint32_t frame;//最後に情報を取得したフレーム
+		uint32_t index;//配列の番号(番号が変わると取得しなおすので常に今の番号)
+		uint32_t colliderId;//同じアドレスに別のコライダーが作られたかどうかを調べるための番号
+		ColliderSnapshot snapshot;
+	};
+
+	void CheckAllCollisionsBruteForce();
+
+	void UpdateColliderArray();
+
+	void UpdateBounds();
+
+	void UpdateColliderStates();
+
+	ColliderSnapshot MakeSnapshot(size_t index) const;
+
+	void RemoveStaleColliders();
+
+	//衝突属性の一番下のビットの番号。属性が無い場合はkCollisionLayerCount
+	static uint32_t GetLayer(uint32_t collisionAttribute);
+
+	void UpdateLayerMatrix();
+
+	void DestroyProxy(const Collider* collider);
+
+	void UpdateDynamicAABBTree();
+
+	void FindPairsDynamicAABBTree();
+
+	void FindPairsSpatialHash();
+
+	//動いていないコライダー同士の前フレームに当たっていたペアを候補に残す
+	void RetainStaticPairs();
+
+	void SortPairs();
+
+	float ComputeAutoCellSize() const;
+
+	AABB ComputeWorldAABB(size_t index) const;
+
+	void CheckCandidatePairs();
+
+	void EvaluatePairs(uint32_t begin, uint32_t end, std::vector<Contact>& contacts);
+
+	uint32_t CheckCollisionPair(Collider* colliderA, Collider* colliderB);
 
-	bool CheckCollisionSphere(const Sphere& sphereA, const Sphere& sphereB);
+	bool CheckContinuousCollision(size_t indexA, size_t indexB, float& timeOfImpact) const;
 
-	bool CheckCollisionSphereAABB(const Sphere& sphere, const AABB& aabb);
+	void NotifyContinuousCollision(Collider* colliderA, Collider* colliderB, float timeOfImpact);
 
-	bool CheckCollisionAABB(const AABB& aabbA, const AABB& aabbB);
+	static PairKey MakePairKey(const Collider* colliderA, const Collider* colliderB);
 
-	bool CheckCollisionAABBOBB(const AABB& aabb, const OBB& obb);
+	void UpdatePersistentPair(Collider* colliderA, Collider* colliderB, uint32_t hitCount, float timeOfImpact);
 
-	float LenSegOnSeparateAxis(Vector3* Sep, Vector3* e1, Vector3* e2, Vector3* e3);
+	void NotifyCollisionExits();
+
+	//collisionMaskと衝突属性が重なるコライダーがいるレイヤーのビット
+	uint32_t GetQueryLayerMask(uint32_t collisionMask) const;
+
+	template<typename T>
+	void QueryAABB(const AABB& aabb, uint32_t collisionMask, T callback) const;
+
+	template<typename T>
+	void QueryRay(const Ray& ray, float maxDistance, float radius, uint32_t collisionMask, T callback) const;
+
+	bool IntersectRayCollider(size_t index, const Ray& ray, float radius, float maxDistance, RaycastHit& hit) const;
+
+	bool IntersectRaySphere(const Ray& ray, const Sphere& sphere, float maxDistance, float& distance, Vector3& normal) const;
+
+	bool IntersectRayAABB(const Ray& ray, float radius, const AABB& aabb, float maxDistance, float& distance, Vector3& normal) const;
+
+	bool IntersectRayOBB(const Ray& ray, float radius, const OBB& obb, float maxDistance, float& distance, Vector3& normal) const;
 
 private:
 	std::list<Collider*> colliders_{};
+
+	//前フレームにSetColliderListで登録されていたコライダー
+	std::vector<Collider*> previousListedColliders_{};
+
+	//RegisterColliderで登録されたコライダー(colliderArray_の先頭に同じ順番で並ぶ)
+	std::vector<Collider*> registeredColliders_{};
+
+	//前フレームから配列の番号が変わった最初の番号
+	size_t firstChangedIndex_ = 0;
+
+	BroadPhaseType broadPhaseType_ = kBroadPhaseDynamicAABBTree;
+
+	//今フレームのコライダーをリスト順に並べたもの
+	std::vector<Collider*> colliderArray_{};
+
+	//1フレームに1回取得したコライダーの情報
+	ColliderSoA colliderSoA_{};
+
+	//コライダーごとのワールド空間のAABB
+	std::vector<AABB> bounds_{};
+
+	//形状を持っているかどうか
+	std::vector<bool> hasBounds_{};
+
+	//コライダーごとのレイヤー(衝突属性の一番下のビット)
+	std::vector<uint8_t> layers_{};
+
+	//レイヤーごとのコライダーの衝突属性と衝突マスクを合わせたもの
+	std::array<uint32_t, kCollisionLayerCount> layerAttributes_{};
+
+	std::array<uint32_t, kCollisionLayerCount> layerMasks_{};
+
+	//レイヤーごとに判定するレイヤーのビット(属性とマスクが両方向で重なる組み合わせ)
+	std::array<uint32_t, kCollisionLayerCount> layerMatrix_{};
+
+	//ブロードフェーズで見つかった候補ペア
+	std::vector<CollisionPair> pairs_{};
+
+	//候補ペアごとの判定結果
+	std::vector<uint8_t> sphereSphereResults_{};
+
+	std::vector<uint8_t> aabbAABBResults_{};
+
+	std::vector<uint8_t> sphereAABBResults_{};
+
+	//スレッドごとの衝突結果
+	std::vector<std::vector<Contact>> contactBuffers_{};
+
+	//全スレッドの衝突結果をペアの順に並べたもの
+	std::vector<Contact> contacts_{};
+
+	bool isMultithreaded_ = true;
+
+	//1回のジョブで判定するペアの数
+	static const uint32_t kPairsPerChunk = 256;
+
+	//1回のジョブで判定するレイの数
+	static const uint32_t kRaysPerChunk = 16;
+
+	//今フレームに情報を取得しなおすかどうか
+	std::vector<uint8_t> isMoved_{};
+
+	std::vector<uint32_t> movedIndices_{};
+
+	//全てのコライダーの情報を取得しなおしてブロードフェーズを作り直すかどうか
+	bool isFullUpdate_ = true;
+
+	//ブロードフェーズの設定が変わったなど次のフレームで作り直す必要があるかどうか
+	bool isFullUpdateRequired_ = true;
+
+	//前フレームから形状や位置が変化していないかどうか
+	std::vector<uint8_t> isUnchanged_{};
+
+	//コライダーごとの前フレームの情報
+	std::unordered_map<const Collider*, ColliderState> colliderStates_{};
+
+	//当たっているペア
+	std::unordered_map<PairKey, PersistentPair, PairKeyHash> persistentPairs_{};
+
+	//今フレームで離れたペア
+	std::vector<CollisionPair> exitPairs_{};
+
+	//レイヤーごとの動的AABB木
+	std::array<DynamicAABBTree, kCollisionLayerCount> dynamicAABBTrees_{};
+
+	std::unordered_map<const Collider*, Proxy> proxies_{};
+
+	uint32_t frame_ = 0;
+
+	SpatialHashGrid spatialHashGrid_{};
+
+	float cellSize_ = 0.0f;
 };
 
+template<typename T>
+inline void CollisionManager::QueryAABB(const AABB& aabb, uint32_t collisionMask, T callback) const
+{
+	//動的AABB木か空間ハッシュグリッドがあればマスクと重なるレイヤーだけ辿り、なければ全てのコライダーを調べる
+	if (broadPhaseType_ == kBroadPhaseSpatialHash)
+	{
+		spatialHashGrid_.Query(aabb, GetQueryLayerMask(collisionMask), bounds_, [&](uint32_t index)
+			{
+				if ((colliderSoA_.GetCollisionAttribute(index) & collisionMask) != 0)
+				{
+					callback(size_t(index));
+				}
+			}
+		);
+		return;
+	}
+
+	if (broadPhaseType_ == kBroadPhaseDynamicAABBTree)
+	{
+		for (uint32_t layer = 0; layer < kCollisionLayerCount; ++layer)
+		{
+			if ((layerAttributes_[layer] & collisionMask) == 0)
+			{
+				continue;
+			}
+
+			const DynamicAABBTree& dynamicAABBTree = dynamicAABBTrees_[layer];
+			dynamicAABBTree.Query(aabb, [&](int32_t proxyId)
+				{
+					size_t index = size_t(dynamicAABBTree.GetUserData(proxyId));
+					if ((colliderSoA_.GetCollisionAttribute(index) & collisionMask) != 0 && DynamicAABBTree::TestOverlap(bounds_[index], aabb))
+					{
+						callback(index);
+					}
+					return true;
+				}
+			);
+		}
+		return;
+	}
+
+	for (size_t i = 0; i < colliderArray_.size(); ++i)
+	{
+		if (hasBounds_[i] && (colliderSoA_.GetCollisionAttribute(i) & collisionMask) != 0 && DynamicAABBTree::TestOverlap(bounds_[i], aabb))
+		{
+			callback(i);
+		}
+	}
+}
+
+template<typename T>
+inline void CollisionManager::QueryRay(const Ray& ray, float maxDistance, float radius, uint32_t collisionMask, T callback) const
+{
+	//コールバックは新しい最大距離を返す。0以下なら探索を打ち切る
+	if (broadPhaseType_ == kBroadPhaseSpatialHash)
+	{
+		//レイが通るセルを近い順に辿る
+		spatialHashGrid_.RayCast(ray.origin, ray.direction, maxDistance, radius, GetQueryLayerMask(collisionMask), bounds_, [&](uint32_t index, float currentMaxDistance)
+			{
+				if ((colliderSoA_.GetCollisionAttribute(index) & collisionMask) != 0)
+				{
+					return callback(size_t(index), currentMaxDistance);
+				}
+				return currentMaxDistance;
+			}
+		);
+		return;
+	}
+
+	if (broadPhaseType_ == kBroadPhaseDynamicAABBTree)
+	{
+		for (uint32_t layer = 0; layer < kCollisionLayerCount && maxDistance > 0.0f; ++layer)
+		{
+			if ((layerAttributes_[layer] & collisionMask) == 0)
+			{
+				continue;
+			}
+
+			//見つかった距離を次のレイヤーの木にも引き継ぐ
+			const DynamicAABBTree& dynamicAABBTree = dynamicAABBTrees_[layer];
+			dynamicAABBTree.RayCast(ray.origin, ray.direction, maxDistance, radius, [&](int32_t proxyId, float currentMaxDistance)
+				{
+					size_t index = size_t(dynamicAABBTree.GetUserData(proxyId));
+					if ((colliderSoA_.GetCollisionAttribute(index) & collisionMask) != 0)
+					{
+						maxDistance = callback(index, currentMaxDistance);
+					}
+					return maxDistance;
+				}
+			);
+		}
+		return;
+	}
+
+	for (size_t i = 0; i < colliderArray_.size(); ++i)
+	{
+		if (hasBounds_[i] && (colliderSoA_.GetCollisionAttribute(i) & collisionMask) != 0)
+		{
+			maxDistance = callback(i, maxDistance);
+			if (maxDistance <= 0.0f)
+			{
+				return;
+			}
+		}
+	}
+}
@@ -0,0 +1,433 @@
+#include "DynamicAABBTree.h"
+#include <algorithm>
+#include <cmath>
+
+int32_t DynamicAABBTree::CreateProxy(const AABB& aabb, int32_t userData)
+{
+	//ノードを確保
+	int32_t proxyId = AllocateNode();
+
+	//余白を持たせたAABBを設定して木に挿入
+	nodes_[proxyId].aabb = Expand(aabb, margin_);
+	nodes_[proxyId].userData = userData;
+	nodes_[proxyId].height = 0;
+	InsertLeaf(proxyId);
+
+	return proxyId;
+}
+
+void DynamicAABBTree::DestroyProxy(int32_t proxyId)
+{
+	assert(0 <= proxyId && proxyId < int32_t(nodes_.size()));
+	assert(nodes_[proxyId].IsLeaf());
+
+	RemoveLeaf(proxyId);
+	FreeNode(proxyId);
+}
+
+bool DynamicAABBTree::MoveProxy(int32_t proxyId, const AABB& aabb)
+{
+	assert(0 <= proxyId && proxyId < int32_t(nodes_.size()));
+	assert(nodes_[proxyId].IsLeaf());
+
+	//余白の範囲内に収まっていて、大きくなりすぎていなければ何もしない
+	const AABB& fatAABB = nodes_[proxyId].aabb;
+	if (Contains(fatAABB, aabb))
+	{
+		AABB hugeAABB = Expand(aabb, 4.0f * margin_);
+		if (Contains(hugeAABB, fatAABB))
+		{
+			return false;
+		}
+	}
+
+	//木から外して入れなおす
+	RemoveLeaf(proxyId);
+	nodes_[proxyId].aabb = Expand(aabb, margin_);
+	InsertLeaf(proxyId);
+
+	return true;
+}
+
+void DynamicAABBTree::Clear()
+{
+	nodes_.clear();
+	root_ = kNullNode;
+	freeList_ = kNullNode;
+}
+
+int32_t DynamicAABBTree::AllocateNode()
+{
+	//空きノードがなければ新しく追加
+	if (freeList_ == kNullNode)
+	{
+		nodes_.push_back(Node{});
+		int32_t nodeId = int32_t(nodes_.size()) - 1;
+		nodes_[nodeId].parent = kNullNode;
+		nodes_[nodeId].child1 = kNullNode;
+		nodes_[nodeId].child2 = kNullNode;
+		nodes_[nodeId].height = 0;
+		nodes_[nodeId].userData = -1;
+		return nodeId;
+	}
+
+	//フリーリストから取り出す
+	int32_t nodeId = freeList_;
+	freeList_ = nodes_[nodeId].parent;
+	nodes_[nodeId].parent = kNullNode;
+	nodes_[nodeId].child1 = kNullNode;
+	nodes_[nodeId].child2 = kNullNode;
+	nodes_[nodeId].height = 0;
+	nodes_[nodeId].userData = -1;
+	return nodeId;
+}
+
+void DynamicAABBTree::FreeNode(int32_t nodeId)
+{
+	//フリーリストの先頭に繋ぐ
+	nodes_[nodeId].parent = freeList_;
+	nodes_[nodeId].height = -1;
+	freeList_ = nodeId;
+}
+
+void DynamicAABBTree::InsertLeaf(int32_t leaf)
+{
+	//木が空なら根にする
+	if (root_ == kNullNode)
+	{
+		root_ = leaf;
+		nodes_[root_].parent = kNullNode;
+		return;
+	}
+
+	//表面積が最小になる兄弟ノードを探す
+	AABB leafAABB = nodes_[leaf].aabb;
+	int32_t index = root_;
+	while (!nodes_[index].IsLeaf())
+	{
+		int32_t child1 = nodes_[index].child1;
+		int32_t child2 = nodes_[index].child2;
+
+		float area = SurfaceArea(nodes_[index].aabb);
+		float combinedArea = SurfaceArea(Combine(nodes_[index].aabb, leafAABB));
+
+		//このノードと葉で新しい親を作る場合のコスト
+		float cost = 2.0f * combinedArea;
+
+		//さらに下に降りる場合に祖先が負担するコスト
+		float inheritanceCost = 2.0f * (combinedArea - area);
+
+		//child1に降りる場合のコスト
+		float cost1 = SurfaceArea(Combine(leafAABB, nodes_[child1].aabb)) + inheritanceCost;
+		if (!nodes_[child1].IsLeaf())
+		{
+			cost1 -= SurfaceArea(nodes_[child1].aabb);
+		}
+
+		//child2に降りる場合のコスト
+		float cost2 = SurfaceArea(Combine(leafAABB, nodes_[child2].aabb)) + inheritanceCost;
+		if (!nodes_[child2].IsLeaf())
+		{
+			cost2 -= SurfaceArea(nodes_[child2].aabb);
+		}
+
+		//このノードを兄弟にするのが一番安ければ終了
+		if (cost < cost1 && cost < cost2)
+		{
+			break;
+		}
+
+		//安い方へ降りる
+		index = cost1 < cost2 ? child1 : child2;
+	}
+
+	int32_t sibling = index;
+
+	//新しい親ノードを作る
+	int32_t oldParent = nodes_[sibling].parent;
+	int32_t newParent = AllocateNode();
+	nodes_[newParent].parent = oldParent;
+	nodes_[newParent].userData = -1;
+	nodes_[newParent].aabb = Combine(leafAABB, nodes_[sibling].aabb);
+	nodes_[newParent].height = nodes_[sibling].height + 1;
+	nodes_[newParent].child1 = sibling;
+	nodes_[newParent].child2 = leaf;
+	nodes_[sibling].parent = newParent;
+	nodes_[leaf].parent = newParent;
+
+	if (oldParent != kNullNode)
+	{
+		//兄弟ノードがいた位置を新しい親に差し替える
+		if (nodes_[oldParent].child1 == sibling)
+		{
+			nodes_[oldParent].child1 = newParent;
+		}
+		else
+		{
+			nodes_[oldParent].child2 = newParent;
+		}
+	}
+	else
+	{
+		//兄弟ノードが根だった
+		root_ = newParent;
+	}
+
+	//根に向かってAABBと高さを更新しながら平衡化する
+	index = nodes_[leaf].parent;
+	while (index != kNullNode)
+	{
+		index = Balance(index);
+
+		int32_t child1 = nodes_[index].child1;
+		int32_t child2 = nodes_[index].child2;
+		nodes_[index].height = 1 + (std::max)(nodes_[child1].height, nodes_[child2].height);
+		nodes_[index].aabb = Combine(nodes_[child1].aabb, nodes_[child2].aabb);
+
+		index = nodes_[index].parent;
+	}
+}
+
+void DynamicAABBTree::RemoveLeaf(int32_t leaf)
+{
+	//根ならそのまま空にする
+	if (leaf == root_)
+	{
+		root_ = kNullNode;
+		return;
+	}
+
+	int32_t parent = nodes_[leaf].parent;
+	int32_t grandParent = nodes_[parent].parent;
+	int32_t sibling = nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+	if (grandParent != kNullNode)
+	{
+		//親を消して兄弟ノードを祖父に繋ぐ
+		if (nodes_[grandParent].child1 == parent)
+		{
+			nodes_[grandParent].child1 = sibling;
+		}
+		else
+		{
+			nodes_[grandParent].child2 = sibling;
+		}
+		nodes_[sibling].parent = grandParent;
+		FreeNode(parent);
+
+		//根に向かってAABBと高さを更新しながら平衡化する
+		int32_t index = grandParent;
+		while (index != kNullNode)
+		{
+			index = Balance(index);
+
+			int32_t child1 = nodes_[index].child1;
+			int32_t child2 = nodes_[index].child2;
+			nodes_[index].aabb = Combine(nodes_[child1].aabb, nodes_[child2].aabb);
+			nodes_[index].height = 1 + (std::max)(nodes_[child1].height, nodes_[child2].height);
+
+			index = nodes_[index].parent;
+		}
+	}
+	else
+	{
+		//兄弟ノードを根にする
+		root_ = sibling;
+		nodes_[sibling].parent = kNullNode;
+		FreeNode(parent);
+	}
+}
+
+int32_t DynamicAABBTree::Balance(int32_t iA)
+{
+	Node& A = nodes_[iA];
+	if (A.IsLeaf() || A.height < 2)
+	{
+		return iA;
+	}
+
+	int32_t iB = A.child1;
+	int32_t iC = A.child2;
+	Node& B = nodes_[iB];
+	Node& C = nodes_[iC];
+
+	int32_t balance = C.height - B.height;
+
+	//Cを上に回転させる
+	if (balance > 1)
+	{
+		int32_t iF = C.child1;
+		int32_t iG = C.child2;
+		Node& F = nodes_[iF];
+		Node& G = nodes_[iG];
+
+		//AとCを入れ替える
+		C.child1 = iA;
+		C.parent = A.parent;
+		A.parent = iC;
+
+		//Aの親が指す先をCにする
+		if (C.parent != kNullNode)
+		{
+			if (nodes_[C.parent].child1 == iA)
+			{
+				nodes_[C.parent].child1 = iC;
+			}
+			else
+			{
+				nodes_[C.parent].child2 = iC;
+			}
+		}
+		else
+		{
+			root_ = iC;
+		}
+
+		//高い方の子をCに残す
+		if (F.height > G.height)
+		{
+			C.child2 = iF;
+			A.child2 = iG;
+			G.parent = iA;
+			A.aabb = Combine(B.aabb, G.aabb);
+			C.aabb = Combine(A.aabb, F.aabb);
+			A.height = 1 + (std::max)(B.height, G.height);
+			C.height = 1 + (std::max)(A.height, F.height);
+		}
+		else
+		{
+			C.child2 = iG;
+			A.child2 = iF;
+			F.parent = iA;
+			A.aabb = Combine(B.aabb, F.aabb);
+			C.aabb = Combine(A.aabb, G.aabb);
+			A.height = 1 + (std::max)(B.height, F.height);
+			C.height = 1 + (std::max)(A.height, G.height);
+		}
+
+		return iC;
+	}
+
+	//Bを上に回転させる
+	if (balance < -1)
+	{
+		int32_t iD = B.child1;
+		int32_t iE = B.child2;
+		Node& D = nodes_[iD];
+		Node& E = nodes_[iE];
+
+		//AとBを入れ替える
+		B.child1 = iA;
+		B.parent = A.parent;
+		A.parent = iB;
+
+		//Aの親が指す先をBにする
+		if (B.parent != kNullNode)
+		{
+			if (nodes_[B.parent].child1 == iA)
+			{
+				nodes_[B.parent].child1 = iB;
+			}
+			else
+			{
+				nodes_[B.parent].child2 = iB;
+			}
+		}
+		else
+		{
+			root_ = iB;
+		}
+
+		//高い方の子をBに残す
+		if (D.height > E.height)
+		{
+			B.child2 = iD;
+			A.child1 = iE;
+			E.parent = iA;
+			A.aabb = Combine(C.aabb, E.aabb);
+			B.aabb = Combine(A.aabb, D.aabb);
+			A.height = 1 + (std::max)(C.height, E.height);
+			B.height = 1 + (std::max)(A.height, D.height);
+		}
+		else
+		{
+			B.child2 = iE;
+			A.child1 = iD;
+			D.parent = iA;
+			A.aabb = Combine(C.aabb, D.aabb);
+			B.aabb = Combine(A.aabb, E.aabb);
+			A.height = 1 + (std::max)(C.height, D.height);
+			B.height = 1 + (std::max)(A.height, E.height);
+		}
+
+		return iB;
+	}
+
+	return iA;
+}
+
+AABB DynamicAABBTree::Combine(const AABB& aabbA, const AABB& aabbB)
+{
+	AABB result{};
+	result.min = { (std::min)(aabbA.min.x,aabbB.min.x),(std::min)(aabbA.min.y,aabbB.min.y),(std::min)(aabbA.min.z,aabbB.min.z) };
+	result.max = { (std::max)(aabbA.max.x,aabbB.max.x),(std::max)(aabbA.max.y,aabbB.max.y),(std::max)(aabbA.max.z,aabbB.max.z) };
+	return result;
+}
+
+bool DynamicAABBTree::Contains(const AABB& outer, const AABB& inner)
+{
+	return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+		inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+}
+
+float DynamicAABBTree::SurfaceArea(const AABB& aabb)
+{
+	float x = aabb.max.x - aabb.min.x;
+	float y = aabb.max.y - aabb.min.y;
+	float z = aabb.max.z - aabb.min.z;
+	return 2.0f * (x * y + y * z + z * x);
+}
+
+AABB DynamicAABBTree::Expand(const AABB& aabb, float margin)
+{
+	AABB result{};
+	result.min = { aabb.min.x - margin,aabb.min.y - margin,aabb.min.z - margin };
+	result.max = { aabb.max.x + margin,aabb.max.y + margin,aabb.max.z + margin };
+	return result;
+}
+
+bool DynamicAABBTree::TestRayOverlap(const AABB& aabb, const Vector3& origin, const Vector3& direction, float maxDistance)
+{
+	const float boxMin[3] = { aabb.min.x,aabb.min.y,aabb.min.z };
+	const float boxMax[3] = { aabb.max.x,aabb.max.y,aabb.max.z };
+	const float rayOrigin[3] = { origin.x,origin.y,origin.z };
+	const float rayDirection[3] = { direction.x,direction.y,direction.z };
+
+	//スラブ法で[0,maxDistance]の区間がAABBと重なるか調べる
+	float tMin = 0.0f;
+	float tMax = maxDistance;
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		//軸に平行な場合は始点がスラブの中にあるかだけ見る
+		if (std::abs(rayDirection[i]) < 1.0e-8f)
+		{
+			if (rayOrigin[i] < boxMin[i] || rayOrigin[i] > boxMax[i])
+			{
+				return false;
+			}
+			continue;
+		}
+
+		float inverseDirection = 1.0f / rayDirection[i];
+		float t1 = (boxMin[i] - rayOrigin[i]) * inverseDirection;
+		float t2 = (boxMax[i] - rayOrigin[i]) * inverseDirection;
+		tMin = (std::max)(tMin, (std::min)(t1, t2));
+		tMax = (std::min)(tMax, (std::max)(t1, t2));
+		if (tMin > tMax)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
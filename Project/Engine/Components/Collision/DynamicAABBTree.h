@@ -0,0 +1,165 @@
+#pragma once
+#include "Engine/Math/AABB.h"
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+class DynamicAABBTree
+{
+public:
+	static const int32_t kNullNode = -1;
+
+	int32_t CreateProxy(const AABB& aabb, int32_t userData);
+
+	void DestroyProxy(int32_t proxyId);
+
+	bool MoveProxy(int32_t proxyId, const AABB& aabb);
+
+	void Clear();
+
+	template<typename T>
+	void Query(const AABB& aabb, T callback) const;
+
+	//半径を指定するとAABBを膨らませて判定する(スフィアキャスト用)
+	template<typename T>
+	void RayCast(const Vector3& origin, const Vector3& direction, float maxDistance, float radius, T callback) const;
+
+	const int32_t GetUserData(int32_t proxyId) const { return nodes_[proxyId].userData; };
+
+	void SetUserData(int32_t proxyId, int32_t userData) { nodes_[proxyId].userData = userData; };
+
+	const AABB& GetFatAABB(int32_t proxyId) const { return nodes_[proxyId].aabb; };
+
+	const int32_t GetHeight() const { return root_ == kNullNode ? 0 : nodes_[root_].height; };
+
+	const float GetMargin() const { return margin_; };
+
+	void SetMargin(float margin) { margin_ = margin; };
+
+	static bool TestOverlap(const AABB& aabbA, const AABB& aabbB)
+	{
+		return aabbA.min.x <= aabbB.max.x && aabbA.max.x >= aabbB.min.x &&
+			aabbA.min.y <= aabbB.max.y && aabbA.max.y >= aabbB.min.y &&
+			aabbA.min.z <= aabbB.max.z && aabbA.max.z >= aabbB.min.z;
+	}
+
+private:
+	struct Node
+	{
+		AABB aabb;//葉ノードは余白を含んだAABB
+		int32_t parent;//フリーリスト内では次の空きノード
+		int32_t child1;
+		int32_t child2;
+		int32_t height;//葉は0、空きノードは-1
+		int32_t userData;
+
+		bool IsLeaf() const { return child1 == kNullNode; };
+	};
+
+	int32_t AllocateNode();
+
+	void FreeNode(int32_t nodeId);
+
+	void InsertLeaf(int32_t leaf);
+
+	void RemoveLeaf(int32_t leaf);
+
+	int32_t Balance(int32_t iA);
+
+	static AABB Combine(const AABB& aabbA, const AABB& aabbB);
+
+	static bool Contains(const AABB& outer, const AABB& inner);
+
+	static float SurfaceArea(const AABB& aabb);
+
+	static AABB Expand(const AABB& aabb, float margin);
+
+	static bool TestRayOverlap(const AABB& aabb, const Vector3& origin, const Vector3& direction, float maxDistance);
+
+private:
+	//探索スタックの最大数(平衡木なので高さはlog(n)程度に収まる)
+	static const int32_t kStackCapacity = 256;
+
+	std::vector<Node> nodes_{};
+
+	int32_t root_ = kNullNode;
+
+	int32_t freeList_ = kNullNode;
+
+	float margin_ = 0.1f;
+};
+
+template<typename T>
+inline void DynamicAABBTree::Query(const AABB& aabb, T callback) const
+{
+	int32_t stack[kStackCapacity];
+	int32_t stackCount = 0;
+	stack[stackCount++] = root_;
+
+	while (stackCount > 0)
+	{
+		int32_t nodeId = stack[--stackCount];
+		if (nodeId == kNullNode)
+		{
+			continue;
+		}
+
+		const Node& node = nodes_[nodeId];
+		if (TestOverlap(node.aabb, aabb))
+		{
+			if (node.IsLeaf())
+			{
+				//コールバックがfalseを返したら探索を打ち切る
+				if (!callback(nodeId))
+				{
+					return;
+				}
+			}
+			else
+			{
+				assert(stackCount + 2 <= kStackCapacity);
+				stack[stackCount++] = node.child1;
+				stack[stackCount++] = node.child2;
+			}
+		}
+	}
+}
+
+template<typename T>
+inline void DynamicAABBTree::RayCast(const Vector3& origin, const Vector3& direction, float maxDistance, float radius, T callback) const
+{
+	int32_t stack[kStackCapacity];
+	int32_t stackCount = 0;
+	stack[stackCount++] = root_;
+
+	while (stackCount > 0)
+	{
+		int32_t nodeId = stack[--stackCount];
+		if (nodeId == kNullNode)
+		{
+			continue;
+		}
+
+		const Node& node = nodes_[nodeId];
+		if (!TestRayOverlap(Expand(node.aabb, radius), origin, direction, maxDistance))
+		{
+			continue;
+		}
+
+		if (node.IsLeaf())
+		{
+			//コールバックは新しい最大距離を返す。0以下なら探索を打ち切る
+			maxDistance = callback(nodeId, maxDistance);
+			if (maxDistance <= 0.0f)
+			{
+				return;
+			}
+		}
+		else
+		{
+			assert(stackCount + 2 <= kStackCapacity);
+			stack[stackCount++] = node.child1;
+			stack[stackCount++] = node.child2;
+		}
+	}
+}
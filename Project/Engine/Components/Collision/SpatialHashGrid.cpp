@@ -0,0 +1,128 @@
+#include "SpatialHashGrid.h"
+#include <algorithm>
+#include <cmath>
+
+void SpatialHashGrid::Clear()
+{
+	entries_.clear();
+	sortedCount_ = 0;
+	items_.clear();
+	largeItems_.clear();
+	itemBounds_ = { {FLT_MAX,FLT_MAX,FLT_MAX},{-FLT_MAX,-FLT_MAX,-FLT_MAX} };
+}
+
+void SpatialHashGrid::Insert(uint32_t index, uint32_t layer, const AABB& aabb)
+{
+	//AABBが重なっているセルの範囲を求める
+	int32_t minX = ToCell(aabb.min.x);
+	int32_t minY = ToCell(aabb.min.y);
+	int32_t minZ = ToCell(aabb.min.z);
+	int32_t maxX = ToCell(aabb.max.x);
+	int32_t maxY = ToCell(aabb.max.y);
+	int32_t maxZ = ToCell(aabb.max.z);
+
+	//セルをまたぎすぎる大きいコライダーは別に管理する
+	int64_t cellCount = int64_t(maxX - minX + 1) * int64_t(maxY - minY + 1) * int64_t(maxZ - minZ + 1);
+	if (cellCount > kMaxCellsPerCollider)
+	{
+		largeItems_.push_back({ layer,index });
+		return;
+	}
+	items_.push_back({ layer,index });
+	itemBounds_.min = { (std::min)(itemBounds_.min.x,aabb.min.x),(std::min)(itemBounds_.min.y,aabb.min.y),(std::min)(itemBounds_.min.z,aabb.min.z) };
+	itemBounds_.max = { (std::max)(itemBounds_.max.x,aabb.max.x),(std::max)(itemBounds_.max.y,aabb.max.y),(std::max)(itemBounds_.max.z,aabb.max.z) };
+
+	//重なっている全てのセルに登録
+	for (int32_t z = minZ; z <= maxZ; ++z)
+	{
+		for (int32_t y = minY; y <= maxY; ++y)
+		{
+			for (int32_t x = minX; x <= maxX; ++x)
+			{
+				entries_.push_back({ MakeKey(x,y,z),layer,index });
+			}
+		}
+	}
+}
+
+void SpatialHashGrid::Build()
+{
+	//セルごと、セルの中はレイヤーごとにまとまるように並べ替える(追加した分だけソートして並べ替え済みの分とマージする)
+	auto compare = [](const Entry& lhs, const Entry& rhs)
+		{
+			if (lhs.key != rhs.key)
+			{
+				return lhs.key < rhs.key;
+			}
+			return lhs.layer != rhs.layer ? lhs.layer < rhs.layer : lhs.index < rhs.index;
+		};
+	std::sort(entries_.begin() + sortedCount_, entries_.end(), compare);
+	std::inplace_merge(entries_.begin(), entries_.begin() + sortedCount_, entries_.end(), compare);
+	sortedCount_ = entries_.size();
+}
+
+int32_t SpatialHashGrid::ToCell(float value) const
+{
+	//セルの座標に変換して範囲内に収める
+	float cell = std::floor(value / cellSize_);
+	cell = std::clamp(cell, float(-kMaxCell), float(kMaxCell));
+	return int32_t(cell);
+}
+
+uint64_t SpatialHashGrid::MakeKey(int32_t x, int32_t y, int32_t z)
+{
+	//負の座標をずらして21bitずつ詰める
+	uint64_t ux = uint64_t(x + kMaxCell);
+	uint64_t uy = uint64_t(y + kMaxCell);
+	uint64_t uz = uint64_t(z + kMaxCell);
+	return (ux << 42) | (uy << 21) | uz;
+}
+
+bool SpatialHashGrid::TestOverlap(const AABB& aabbA, const AABB& aabbB)
+{
+	return aabbA.min.x <= aabbB.max.x && aabbA.max.x >= aabbB.min.x &&
+		aabbA.min.y <= aabbB.max.y && aabbA.max.y >= aabbB.min.y &&
+		aabbA.min.z <= aabbB.max.z && aabbA.max.z >= aabbB.min.z;
+}
+
+
+bool SpatialHashGrid::IntersectRay(const AABB& aabb, const Vector3& origin, const Vector3& direction, float maxDistance, float& tEnter, float& tExit)
+{
+	const float boxMin[3] = { aabb.min.x,aabb.min.y,aabb.min.z };
+	const float boxMax[3] = { aabb.max.x,aabb.max.y,aabb.max.z };
+	const float rayOrigin[3] = { origin.x,origin.y,origin.z };
+	const float rayDirection[3] = { direction.x,direction.y,direction.z };
+
+	//スラブ法(DynamicAABBTreeと同じ判定)
+	tEnter = 0.0f;
+	tExit = maxDistance;
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		//軸に平行な場合は始点がスラブの中にあるかだけ見る
+		if (std::abs(rayDirection[i]) < 1.0e-8f)
+		{
+			if (rayOrigin[i] < boxMin[i] || rayOrigin[i] > boxMax[i])
+			{
+				return false;
+			}
+			continue;
+		}
+
+		float inverseDirection = 1.0f / rayDirection[i];
+		float t1 = (boxMin[i] - rayOrigin[i]) * inverseDirection;
+		float t2 = (boxMax[i] - rayOrigin[i]) * inverseDirection;
+		tEnter = (std::max)(tEnter, (std::min)(t1, t2));
+		tExit = (std::min)(tExit, (std::max)(t1, t2));
+		if (tEnter > tExit)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+AABB SpatialHashGrid::Expand(const AABB& aabb, float radius)
+{
+	return { {aabb.min.x - radius,aabb.min.y - radius,aabb.min.z - radius},{aabb.max.x + radius,aabb.max.y + radius,aabb.max.z + radius} };
+}
\ No newline at end of file
@@ -0,0 +1,426 @@
+#pragma once
+#include "CollisionConfig.h"
+#include "Engine/Math/AABB.h"
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+class SpatialHashGrid
+{
+public:
+	void Clear();
+
+	//layerはコライダーを分けるレイヤーの番号
+	void Insert(uint32_t index, uint32_t layer, const AABB& aabb);
+
+	//前回のBuildから追加した分だけ並べ替えて既存の登録と合わせる
+	void Build();
+
+	//predicateがtrueを返すコライダーの登録を外す(並び順は保たれるので再度ソートする必要はない)
+	template<typename T>
+	void RemoveIf(T predicate);
+
+	//layerMatrixはレイヤーごとに判定するレイヤーのビットを持つ。判定しないレイヤー同士はペアを作らない
+	template<typename T>
+	void FindPairs(const std::vector<AABB>& bounds, const std::array<uint32_t, kCollisionLayerCount>& layerMatrix, T callback) const;
+
+	//aabbと重なっている、layerMaskに含まれるレイヤーのコライダーを1回ずつ報告する
+	template<typename T>
+	void Query(const AABB& aabb, uint32_t layerMask, const std::vector<AABB>& bounds, T callback) const;
+
+	//レイが通るセルを始点から順に辿り、layerMaskに含まれるレイヤーのコライダーを1回ずつ報告する
+	//コールバックは新しい最大距離を返す。0以下なら探索を打ち切る。半径を指定するとAABBを膨らませて判定する(スフィアキャスト用)
+	template<typename T>
+	void RayCast(const Vector3& origin, const Vector3& direction, float maxDistance, float radius, uint32_t layerMask, const std::vector<AABB>& bounds, T callback) const;
+
+	const float GetCellSize() const { return cellSize_; };
+
+	void SetCellSize(float cellSize) { cellSize_ = cellSize; };
+
+private:
+	struct Entry
+	{
+		uint64_t key;//セルのキー
+		uint32_t layer;//レイヤーの番号
+		uint32_t index;//コライダーの番号
+	};
+
+	struct Item
+	{
+		uint32_t layer;
+		uint32_t index;
+	};
+
+	int32_t ToCell(float value) const;
+
+	static uint64_t MakeKey(int32_t x, int32_t y, int32_t z);
+
+	static bool TestOverlap(const AABB& aabbA, const AABB& aabbB);
+
+	//[0,maxDistance]の区間でレイがAABBと重なる範囲を求める
+	static bool IntersectRay(const AABB& aabb, const Vector3& origin, const Vector3& direction, float maxDistance, float& tEnter, float& tExit);
+
+	static AABB Expand(const AABB& aabb, float radius);
+
+private:
+	//セルの座標の範囲(キーに21bitずつ詰めるため)
+	static const int32_t kMaxCell = (1 << 20) - 1;
+
+	//1つのコライダーが登録できるセルの最大数
+	static const int64_t kMaxCellsPerCollider = 64;
+
+	std::vector<Entry> entries_{};
+
+	//entries_の先頭から並べ替え済みの数
+	size_t sortedCount_ = 0;
+
+	//セルに登録したコライダー
+	std::vector<Item> items_{};
+
+	//大きすぎてセルに登録しなかったコライダー
+	std::vector<Item> largeItems_{};
+
+	//セルに登録したコライダーを全て囲むAABB(レイの範囲を絞り込むのに使う。登録を外しても縮めない)
+	AABB itemBounds_{ {FLT_MAX,FLT_MAX,FLT_MAX},{-FLT_MAX,-FLT_MAX,-FLT_MAX} };
+
+	float cellSize_ = 4.0f;
+};
+
+template<typename T>
+inline void SpatialHashGrid::FindPairs(const std::vector<AABB>& bounds, const std::array<uint32_t, kCollisionLayerCount>& layerMatrix, T callback) const
+{
+	//同じセルに入っているコライダー同士でペアを作る
+	size_t begin = 0;
+	while (begin < entries_.size())
+	{
+		size_t end = begin + 1;
+		while (end < entries_.size() && entries_[end].key == entries_[begin].key)
+		{
+			++end;
+		}
+
+		//セルの中はレイヤーごとにまとまっているので、判定するレイヤーの組み合わせだけ調べる
+		size_t endA = begin;
+		for (size_t beginA = begin; beginA < end; beginA = endA)
+		{
+			uint32_t layerA = entries_[beginA].layer;
+			endA = beginA + 1;
+			while (endA < end && entries_[endA].layer == layerA)
+			{
+				++endA;
+			}
+
+			size_t endB = beginA;
+			for (size_t beginB = beginA; beginB < end; beginB = endB)
+			{
+				uint32_t layerB = entries_[beginB].layer;
+				endB = beginB + 1;
+				while (endB < end && entries_[endB].layer == layerB)
+				{
+					++endB;
+				}
+				if ((layerMatrix[layerA] & (1u << layerB)) == 0)
+				{
+					continue;
+				}
+
+				for (size_t i = beginA; i < endA; ++i)
+				{
+					uint32_t indexA = entries_[i].index;
+					const AABB& aabbA = bounds[indexA];
+					for (size_t j = beginB == beginA ? i + 1 : beginB; j < endB; ++j)
+					{
+						uint32_t indexB = entries_[j].index;
+						const AABB& aabbB = bounds[indexB];
+						if (!TestOverlap(aabbA, aabbB))
+						{
+							continue;
+						}
+
+						//重なっている範囲の最小の角があるセルでだけ報告する(複数セルでの重複を回避)
+						int32_t x = ToCell(aabbA.min.x > aabbB.min.x ? aabbA.min.x : aabbB.min.x);
+						int32_t y = ToCell(aabbA.min.y > aabbB.min.y ? aabbA.min.y : aabbB.min.y);
+						int32_t z = ToCell(aabbA.min.z > aabbB.min.z ? aabbA.min.z : aabbB.min.z);
+						if (MakeKey(x, y, z) != entries_[begin].key)
+						{
+							continue;
+						}
+
+						callback(indexA, indexB);
+					}
+				}
+			}
+		}
+
+		begin = end;
+	}
+
+	//大きいコライダーは全てのコライダーと判定する
+	for (size_t i = 0; i < largeItems_.size(); ++i)
+	{
+		const Item& itemA = largeItems_[i];
+		const AABB& aabbA = bounds[itemA.index];
+		uint32_t layerMask = layerMatrix[itemA.layer];
+		for (const Item& itemB : items_)
+		{
+			if ((layerMask & (1u << itemB.layer)) != 0 && TestOverlap(aabbA, bounds[itemB.index]))
+			{
+				callback(itemA.index, itemB.index);
+			}
+		}
+		for (size_t j = i + 1; j < largeItems_.size(); ++j)
+		{
+			const Item& itemB = largeItems_[j];
+			if ((layerMask & (1u << itemB.layer)) != 0 && TestOverlap(aabbA, bounds[itemB.index]))
+			{
+				callback(itemA.index, itemB.index);
+			}
+		}
+	}
+}
+
+template<typename T>
+inline void SpatialHashGrid::RemoveIf(T predicate)
+{
+	entries_.erase(std::remove_if(entries_.begin(), entries_.end(), [&](const Entry& entry) { return predicate(entry.index); }), entries_.end());
+	items_.erase(std::remove_if(items_.begin(), items_.end(), [&](const Item& item) { return predicate(item.index); }), items_.end());
+	largeItems_.erase(std::remove_if(largeItems_.begin(), largeItems_.end(), [&](const Item& item) { return predicate(item.index); }), largeItems_.end());
+	sortedCount_ = entries_.size();
+}
+
+template<typename T>
+inline void SpatialHashGrid::Query(const AABB& aabb, uint32_t layerMask, const std::vector<AABB>& bounds, T callback) const
+{
+	int32_t minX = ToCell(aabb.min.x);
+	int32_t minY = ToCell(aabb.min.y);
+	int32_t minZ = ToCell(aabb.min.z);
+	int32_t maxX = ToCell(aabb.max.x);
+	int32_t maxY = ToCell(aabb.max.y);
+	int32_t maxZ = ToCell(aabb.max.z);
+
+	//セルをまたぎすぎる場合はセルを辿らずに全て調べる
+	int64_t cellCount = int64_t(maxX - minX + 1) * int64_t(maxY - minY + 1) * int64_t(maxZ - minZ + 1);
+	if (cellCount > kMaxCellsPerCollider)
+	{
+		for (const Item& item : items_)
+		{
+			if ((layerMask & (1u << item.layer)) != 0 && TestOverlap(aabb, bounds[item.index]))
+			{
+				callback(item.index);
+			}
+		}
+	}
+	else
+	{
+		for (int32_t z = minZ; z <= maxZ; ++z)
+		{
+			for (int32_t y = minY; y <= maxY; ++y)
+			{
+				for (int32_t x = minX; x <= maxX; ++x)
+				{
+					//同じセルの登録を二分探索で探す
+					uint64_t key = MakeKey(x, y, z);
+					std::vector<Entry>::const_iterator it = std::lower_bound(entries_.begin(), entries_.end(), key, [](const Entry& entry, uint64_t key)
+						{
+							return entry.key < key;
+						}
+					);
+					for (; it != entries_.end() && it->key == key; ++it)
+					{
+						if ((layerMask & (1u << it->layer)) == 0)
+						{
+							continue;
+						}
+
+						const AABB& other = bounds[it->index];
+						if (!TestOverlap(aabb, other))
+						{
+							continue;
+						}
+
+						//重なっている範囲の最小の角があるセルでだけ報告する(FindPairsと同じ)
+						int32_t cellX = ToCell(aabb.min.x > other.min.x ? aabb.min.x : other.min.x);
+						int32_t cellY = ToCell(aabb.min.y > other.min.y ? aabb.min.y : other.min.y);
+						int32_t cellZ = ToCell(aabb.min.z > other.min.z ? aabb.min.z : other.min.z);
+						if (cellX == x && cellY == y && cellZ == z)
+						{
+							callback(it->index);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	//大きいコライダーは全て調べる
+	for (const Item& item : largeItems_)
+	{
+		if ((layerMask & (1u << item.layer)) != 0 && TestOverlap(aabb, bounds[item.index]))
+		{
+			callback(item.index);
+		}
+	}
+}
+
+template<typename T>
+inline void SpatialHashGrid::RayCast(const Vector3& origin, const Vector3& direction, float maxDistance, float radius, uint32_t layerMask, const std::vector<AABB>& bounds, T callback) const
+{
+	float tEnter = 0.0f;
+	float tExit = 0.0f;
+
+	//大きいコライダーは全て調べる
+	for (const Item& item : largeItems_)
+	{
+		if ((layerMask & (1u << item.layer)) != 0 && IntersectRay(Expand(bounds[item.index], radius), origin, direction, maxDistance, tEnter, tExit))
+		{
+			maxDistance = callback(item.index, maxDistance);
+			if (maxDistance <= 0.0f)
+			{
+				return;
+			}
+		}
+	}
+
+	//セルに登録したコライダーの範囲だけ辿る
+	if (items_.empty() || !IntersectRay(Expand(itemBounds_, radius), origin, direction, maxDistance, tEnter, tExit))
+	{
+		return;
+	}
+
+	//半径の分だけ周りのセルも調べる
+	int32_t range = radius > 0.0f ? int32_t(std::ceil(radius / cellSize_)) : 0;
+	int64_t neighborCount = int64_t(range * 2 + 1) * int64_t(range * 2 + 1) * int64_t(range * 2 + 1);
+
+	const float rayOrigin[3] = { origin.x,origin.y,origin.z };
+	const float rayDirection[3] = { direction.x,direction.y,direction.z };
+	const float enterPoint[3] = { origin.x + direction.x * tEnter,origin.y + direction.y * tEnter,origin.z + direction.z * tEnter };
+	const float exitPoint[3] = { origin.x + direction.x * tExit,origin.y + direction.y * tExit,origin.z + direction.z * tExit };
+
+	int32_t cell[3]{};
+	int32_t lastCell[3]{};
+	int64_t walkCount = 1;
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		cell[i] = ToCell(enterPoint[i]);
+		lastCell[i] = ToCell(exitPoint[i]);
+		walkCount += std::abs(int64_t(lastCell[i]) - int64_t(cell[i]));
+	}
+
+	//辿るセルが多すぎる場合はセルを辿らずに全て調べる
+	if (walkCount * neighborCount > int64_t(items_.size()))
+	{
+		for (const Item& item : items_)
+		{
+			if ((layerMask & (1u << item.layer)) != 0 && IntersectRay(Expand(bounds[item.index], radius), origin, direction, maxDistance, tEnter, tExit))
+			{
+				maxDistance = callback(item.index, maxDistance);
+				if (maxDistance <= 0.0f)
+				{
+					return;
+				}
+			}
+		}
+		return;
+	}
+
+	//次のセルの境界までの距離と1セル進むのにかかる距離(3D-DDA)
+	int32_t step[3]{};
+	float tNext[3]{};
+	float tDelta[3]{};
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		if (std::abs(rayDirection[i]) < 1.0e-8f)
+		{
+			tNext[i] = std::numeric_limits<float>::infinity();
+			tDelta[i] = std::numeric_limits<float>::infinity();
+			continue;
+		}
+		step[i] = rayDirection[i] > 0.0f ? 1 : -1;
+		float boundary = float(step[i] > 0 ? cell[i] + 1 : cell[i]) * cellSize_;
+		tNext[i] = (boundary - rayOrigin[i]) / rayDirection[i];
+		tDelta[i] = cellSize_ / std::abs(rayDirection[i]);
+	}
+
+	bool hasPreviousCell = false;
+	int32_t previousCell[3]{};
+	float tCell = tEnter;
+	for (int64_t walk = 0; walk < walkCount && tCell <= maxDistance; ++walk)
+	{
+		for (int32_t dz = -range; dz <= range; ++dz)
+		{
+			for (int32_t dy = -range; dy <= range; ++dy)
+			{
+				for (int32_t dx = -range; dx <= range; ++dx)
+				{
+					int32_t x = cell[0] + dx;
+					int32_t y = cell[1] + dy;
+					int32_t z = cell[2] + dz;
+					if (std::abs(x) > kMaxCell || std::abs(y) > kMaxCell || std::abs(z) > kMaxCell)
+					{
+						continue;
+					}
+
+					uint64_t key = MakeKey(x, y, z);
+					std::vector<Entry>::const_iterator it = std::lower_bound(entries_.begin(), entries_.end(), key, [](const Entry& entry, uint64_t key)
+						{
+							return entry.key < key;
+						}
+					);
+					for (; it != entries_.end() && it->key == key; ++it)
+					{
+						if ((layerMask & (1u << it->layer)) == 0)
+						{
+							continue;
+						}
+
+						//コライダーが登録されているセルのうち今のセルに一番近いセルでだけ報告する
+						const AABB& other = bounds[it->index];
+						int32_t minCell[3] = { ToCell(other.min.x),ToCell(other.min.y),ToCell(other.min.z) };
+						int32_t maxCell[3] = { ToCell(other.max.x),ToCell(other.max.y),ToCell(other.max.z) };
+						if (x != std::clamp(cell[0], minCell[0], maxCell[0]) ||
+							y != std::clamp(cell[1], minCell[1], maxCell[1]) ||
+							z != std::clamp(cell[2], minCell[2], maxCell[2]))
+						{
+							continue;
+						}
+
+						//前のセルからも届く範囲なら前のセルで報告済み
+						if (hasPreviousCell &&
+							previousCell[0] >= minCell[0] - range && previousCell[0] <= maxCell[0] + range &&
+							previousCell[1] >= minCell[1] - range && previousCell[1] <= maxCell[1] + range &&
+							previousCell[2] >= minCell[2] - range && previousCell[2] <= maxCell[2] + range)
+						{
+							continue;
+						}
+
+						if (!IntersectRay(Expand(other, radius), origin, direction, maxDistance, tEnter, tExit))
+						{
+							continue;
+						}
+
+						maxDistance = callback(it->index, maxDistance);
+						if (maxDistance <= 0.0f)
+						{
+							return;
+						}
+					}
+				}
+			}
+		}
+
+		//境界が一番近い軸の方向に次のセルへ進む
+		uint32_t axis = tNext[0] < tNext[1] ? (tNext[0] < tNext[2] ? 0 : 2) : (tNext[1] < tNext[2] ? 1 : 2);
+		hasPreviousCell = true;
+		previousCell[0] = cell[0];
+		previousCell[1] = cell[1];
+		previousCell[2] = cell[2];
+		cell[axis] += step[axis];
+		tCell = tNext[axis];
+		tNext[axis] += tDelta[axis];
+	}
+}
@@ -0,0 +1,208 @@
+#include "GPUParticleKernels.h"
+#include "Engine/Math/MathFunction.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace GPUParticleKernels
+{
+	uint32_t GetThreadGroupCount(uint32_t count)
+	{
+		return (count + kThreadGroupSize - 1) / kThreadGroupSize;
+	}
+
+	uint32_t Hash(uint32_t value)
+	{
+		uint32_t state = value * 747796405u + 2891336453u;
+		uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+		return (word >> 22u) ^ word;
+	}
+
+	float NextRandom(uint32_t& state)
+	{
+		//上位24ビットを使うとfloatに誤差なく変換できる
+		state = Hash(state);
+		return float(state >> 8) * (1.0f / 16777216.0f);
+	}
+
+	GPUParticle MakeParticle(const ConstBuffDataGPUParticleEmitter& emitter, uint32_t index)
+	{
+		//スレッドごとに独立した乱数の系列を作る
+		uint32_t state = Hash(index + Hash(emitter.seed));
+		auto getRandomFloat = [&state](float min, float max)
+			{
+				return min + (max - min) * NextRandom(state);
+			};
+
+		GPUParticle particle{};
+
+		//座標
+		particle.translation = {
+			emitter.translation.x + getRandomFloat(emitter.minPopArea.x,emitter.maxPopArea.x),
+			emitter.translation.y + getRandomFloat(emitter.minPopArea.y,emitter.maxPopArea.y),
+			emitter.translation.z + getRandomFloat(emitter.minPopArea.z,emitter.maxPopArea.z)
+		};
+
+		//回転
+		Vector3 rotation = {
+			getRandomFloat(emitter.minPopRotation.x,emitter.maxPopRotation.x),
+			getRandomFloat(emitter.minPopRotation.y,emitter.maxPopRotation.y),
+			getRandomFloat(emitter.minPopRotation.z,emitter.maxPopRotation.z)
+		};
+
+		//スケール
+		particle.scale = {
+			getRandomFloat(emitter.minPopScale.x,emitter.maxPopScale.x),
+			getRandomFloat(emitter.minPopScale.y,emitter.maxPopScale.y),
+			getRandomFloat(emitter.minPopScale.z,emitter.maxPopScale.z)
+		};
+
+		//方位角
+		float azimuth = getRandomFloat(emitter.minPopAzimuth, emitter.maxPopAzimuth);
+		float azimuthRadian = azimuth * float(std::numbers::pi / 180.0f);
+
+		//仰角
+		float elevation = getRandomFloat(emitter.minPopElevation, emitter.maxPopElevation);
+		float elevationRadian = elevation * float(std::numbers::pi / 180.0f);
+
+		//速度
+		if (azimuth != 0.0f || elevation != 0.0f)
+		{
+			particle.velocity.x = getRandomFloat(emitter.minPopVelocity.x, emitter.maxPopVelocity.x) * std::cos(elevationRadian) * std::cos(azimuthRadian);
+			particle.velocity.y = getRandomFloat(emitter.minPopVelocity.y, emitter.maxPopVelocity.y) * std::cos(elevationRadian) * std::sin(azimuthRadian);
+			particle.velocity.z = getRandomFloat(emitter.minPopVelocity.z, emitter.maxPopVelocity.z) * std::sin(elevationRadian);
+		}
+		else
+		{
+			particle.velocity.x = getRandomFloat(emitter.minPopVelocity.x, emitter.maxPopVelocity.x);
+			particle.velocity.y = getRandomFloat(emitter.minPopVelocity.y, emitter.maxPopVelocity.y);
+			particle.velocity.z = getRandomFloat(emitter.minPopVelocity.z, emitter.maxPopVelocity.z);
+		}
+
+		//色
+		particle.color = {
+			getRandomFloat(emitter.minPopColor.x,emitter.maxPopColor.x),
+			getRandomFloat(emitter.minPopColor.y,emitter.maxPopColor.y),
+			getRandomFloat(emitter.minPopColor.z,emitter.maxPopColor.z),
+			getRandomFloat(emitter.minPopColor.w,emitter.maxPopColor.w)
+		};
+		particle.alpha = particle.color.w;
+
+		//寿命
+		particle.lifeTime = getRandomFloat(emitter.minPopLifeTime, emitter.maxPopLifeTime) * emitter.lifeTimeScale;
+		particle.currentTime = 0.0f;
+
+		//角度が指定されていればクォータニオンより優先する
+		particle.rotation = rotation != Vector3{ 0.0f,0.0f,0.0f } ? Mathf::MakeRotateQuaternion(rotation) : emitter.popQuaternion;
+
+		return particle;
+	}
+
+	bool UpdateParticle(GPUParticle& particle, const ConstBuffDataGPUParticleSimulation& simulation)
+	{
+		float timeScale = simulation.timeScale;
+		Vector3 translation = particle.translation;
+		Vector3 velocity = particle.velocity;
+
+		//加速フィールドの判定
+		if (simulation.isAccelerationEnable)
+		{
+			if (simulation.accelerationMin.x <= translation.x && simulation.accelerationMax.x >= translation.x &&
+				simulation.accelerationMin.y <= translation.y && simulation.accelerationMax.y >= translation.y &&
+				simulation.accelerationMin.z <= translation.z && simulation.accelerationMax.z >= translation.z)
+			{
+				velocity = velocity + simulation.acceleration * timeScale;
+			}
+		}
+
+		//重力フィールドの判定
+		if (simulation.isGravityEnable)
+		{
+			if (simulation.gravityMin.x <= translation.x && simulation.gravityMax.x >= translation.x &&
+				simulation.gravityMin.y <= translation.y && simulation.gravityMax.y >= translation.y &&
+				simulation.gravityMin.z <= translation.z && simulation.gravityMax.z >= translation.z)
+			{
+				//距離を計算
+				Vector3 sub = simulation.gravityCenter - translation;
+				float distance = std::sqrt(sub.x * sub.x + sub.y * sub.y + sub.z * sub.z);
+
+				//中心に近づいたら速度を0にする
+				if (distance < simulation.gravityStopDistance)
+				{
+					velocity = { 0.0f,0.0f,0.0f };
+				}
+				else if (distance != 0.0f)
+				{
+					velocity.x += sub.x / distance * simulation.gravityStrength * timeScale;
+					velocity.y += sub.y / distance * simulation.gravityStrength * timeScale;
+					velocity.z += sub.z / distance * simulation.gravityStrength * timeScale;
+				}
+			}
+		}
+
+		//移動処理
+		particle.translation.x = translation.x + velocity.x * timeScale;
+		particle.translation.y = translation.y + velocity.y * timeScale;
+		particle.translation.z = translation.z + velocity.z * timeScale;
+		particle.velocity = velocity;
+
+		//寿命を減らす
+		particle.currentTime += simulation.deltaTime;
+		particle.color.w = particle.alpha - (particle.currentTime / particle.lifeTime);
+
+		//寿命が生存時間を上回ったら消す
+		return !(particle.lifeTime < particle.currentTime);
+	}
+
+	ParticleForGPU MakeInstance(const GPUParticle& particle)
+	{
+		ParticleForGPU instance{};
+		instance.translation = particle.translation;
+		instance.scale = particle.scale;
+		instance.rotation = particle.rotation;
+		instance.color = particle.color;
+		return instance;
+	}
+
+	void Emit(const ConstBuffDataGPUParticleEmitter& emitter, const ConstBuffDataGPUParticleSimulation& simulation, GPUParticle* particles, uint32_t* counters)
+	{
+		for (uint32_t threadId = 0; threadId < emitter.popCount; ++threadId)
+		{
+			//InterlockedAddと同じく加算前の値を番号にする
+			uint32_t index = counters[0]++;
+			if (index < simulation.maxParticleCount)
+			{
+				particles[index] = MakeParticle(emitter, threadId);
+			}
+		}
+	}
+
+	void Simulate(const ConstBuffDataGPUParticleSimulation& simulation, const GPUParticle* sourceParticles, GPUParticle* destinationParticles, ParticleForGPU* instances, uint32_t* counters)
+	{
+		//生成で最大数を超えた分は数えない
+		uint32_t count = (std::min)(counters[0], simulation.maxParticleCount);
+		for (uint32_t threadId = 0; threadId < count; ++threadId)
+		{
+			GPUParticle particle = sourceParticles[threadId];
+			if (UpdateParticle(particle, simulation))
+			{
+				uint32_t index = counters[1]++;
+				destinationParticles[index] = particle;
+				instances[index] = MakeInstance(particle);
+			}
+		}
+	}
+
+	void Finish(const ConstBuffDataGPUParticleSimulation& simulation, uint32_t* counters, uint32_t* drawArguments)
+	{
+		//頂点数、インスタンス数、開始頂点、開始インスタンスの順
+		drawArguments[0] = simulation.vertexCount;
+		drawArguments[1] = counters[1];
+		drawArguments[2] = 0;
+		drawArguments[3] = 0;
+
+		//生き残った数を次のフレームの今いる数にする
+		counters[0] = counters[1];
+		counters[1] = 0;
+	}
+}
\ No newline at end of file
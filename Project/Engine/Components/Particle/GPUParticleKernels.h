@@ -0,0 +1,40 @@
+#pragma once
+#include "Engine/Base/ConstantBuffers.h"
+#include <cstdint>
+
+//GPUParticle.hlsliのコンピュートシェーダーと同じ処理をCPUで行う参照実装(GPUを使わずに結果を確かめるために使う)
+//演算の順番はシェーダーと同じにしているが、GPUのsin,cos,sqrt,除算は数ULPずれることがあるので比較には許容誤差を使うこと
+//GPUでは生き残ったパーティクルを詰める順番がスレッドの実行順で変わるので、並び順に依存せずに比較すること
+namespace GPUParticleKernels
+{
+	//1つのスレッドグループのスレッド数(シェーダーのnumthreadsと同じ)
+	static const uint32_t kThreadGroupSize = 256;
+
+	//count個のスレッドを起動するのに必要なスレッドグループの数
+	uint32_t GetThreadGroupCount(uint32_t count);
+
+	//PCGハッシュ
+	uint32_t Hash(uint32_t value);
+
+	//状態を進めて[0,1)の一様乱数を返す
+	float NextRandom(uint32_t& state);
+
+	//index番目のスレッドが生成するパーティクル(ParticleEmitter::Popと同じ順番で乱数を使う)
+	GPUParticle MakeParticle(const ConstBuffDataGPUParticleEmitter& emitter, uint32_t index);
+
+	//ParticlePool::UpdateParticleと同じ計算順で移動させて、生きていればtrueを返す
+	bool UpdateParticle(GPUParticle& particle, const ConstBuffDataGPUParticleSimulation& simulation);
+
+	ParticleForGPU MakeInstance(const GPUParticle& particle);
+
+	//以下は1回のディスパッチをCPUで実行する。countersの[0]は今いる数、[1]は移動後に生き残った数
+
+	//particlesの後ろにpopCount個追加する(最大数を超えた分は書き込まない)
+	void Emit(const ConstBuffDataGPUParticleEmitter& emitter, const ConstBuffDataGPUParticleSimulation& simulation, GPUParticle* particles, uint32_t* counters);
+
+	//移動させて生き残ったパーティクルと描画用のデータを前に詰めて書き込む
+	void Simulate(const ConstBuffDataGPUParticleSimulation& simulation, const GPUParticle* sourceParticles, GPUParticle* destinationParticles, ParticleForGPU* instances, uint32_t* counters);
+
+	//描画の引数(D3D12_DRAW_ARGUMENTS)を書き込んで次のフレームのためにカウンターを進める
+	void Finish(const ConstBuffDataGPUParticleSimulation& simulation, uint32_t* counters, uint32_t* drawArguments);
+}
@@ -1,85 +1,130 @@
 #include "ParticleEmitter.h"
-#include "Engine/Utilities/RandomGenerator.h"
 #include "Engine/Math/MathFunction.h"
+#include <algorithm>
+#include <cmath>
 #include <numbers>
 
-void ParticleEmitter::Update()
+ParticleEmitter::ParticleEmitter()
+{
+	//シード値はメインスレッドで作成時に決める
+	SetSeed(RandomGenerator::GetRandomSeed());
+}
+
+void ParticleEmitter::Update(float deltaTime)
+{
+	Emit(deltaTime);
+	bounds_ = Simulate(0, particles_.GetCount(), deltaTime);
+	UpdateDeleteTimer(deltaTime);
+}
+
+void ParticleEmitter::Emit(float deltaTime)
 {
 	//パーティクルを生成
-	const float kDeltaTime = 1.0f / 60.0f;
-	frequencyTime_ += kDeltaTime;
-	if (popFrequency_ <= frequencyTime_)
+	uint32_t maxParticleCount = ComputeMaxParticleCount();
+	if (particles_.GetCapacity() < maxParticleCount)
 	{
-		if (!spawnFinished_)
-		{
-			for (uint32_t index = 0; index < popCount_; ++index)
-			{
-				Pop();
-			}
-			frequencyTime_ -= popFrequency_;
-		}
+		particles_.Reserve(maxParticleCount);
 	}
 
-	//パーティクルの処理
-	for (std::list<std::unique_ptr<Particle>>::iterator particleIterator = particles_.begin(); particleIterator != particles_.end();)
+	//死亡フラグが立ったパーティクルを先に削除して空いた分に生成する
+	particles_.RemoveDeadParticles();
+
+	//生成するパーティクル全ての乱数をまとめて作る
+	uint32_t popCount = UpdatePopTimer(deltaTime);
+	randoms_.resize(size_t(popCount) * kRandomsPerParticle);
+	randomStream_.FillUniform(randoms_.data(), randoms_.size(), 0.0f, 1.0f);
+	randomIndex_ = 0;
+	for (uint32_t index = 0; index < popCount; ++index)
 	{
-		//死亡フラグが立ったパーティクルを削除
-		if (particleIterator->get()->IsDead())
+		Pop();
+	}
+}
+
+uint32_t ParticleEmitter::EmitGPU(float deltaTime, ConstBuffDataGPUParticleEmitter& emitterData)
+{
+	//乱数はシェーダーでスレッドごとに作るのでシード値だけを渡す
+	uint32_t popCount = UpdatePopTimer(deltaTime);
+	emitterData.popCount = popCount;
+	emitterData.seed = randomStream_.NextUInt();
+	emitterData.translation = translation_;
+	emitterData.minPopArea = popArea_.min;
+	emitterData.maxPopArea = popArea_.max;
+	emitterData.minPopRotation = popRotation_.min;
+	emitterData.maxPopRotation = popRotation_.max;
+	emitterData.minPopScale = popScale_.min;
+	emitterData.maxPopScale = popScale_.max;
+	emitterData.minPopAzimuth = popAzimuth.min;
+	emitterData.maxPopAzimuth = popAzimuth.max;
+	emitterData.minPopElevation = popElevation.min;
+	emitterData.maxPopElevation = popElevation.max;
+	emitterData.minPopVelocity = popVelocity_.min;
+	emitterData.maxPopVelocity = popVelocity_.max;
+	emitterData.minPopColor = popColor_.min;
+	emitterData.maxPopColor = popColor_.max;
+	emitterData.minPopLifeTime = popLifeTime_.min;
+	emitterData.maxPopLifeTime = popLifeTime_.max;
+	emitterData.lifeTimeScale = GetLifeTimeScale();
+	emitterData.popQuaternion = popQuaternion_;
+
+	//生成したパーティクルが全て消えるまではエミッターを削除しない
+	if (popCount > 0)
+	{
+		remainingLifeTime_ = (std::max)(popLifeTime_.min, popLifeTime_.max) * GetLifeTimeScale();
+	}
+	return popCount;
+}
+
+uint32_t ParticleEmitter::UpdatePopTimer(float deltaTime)
+{
+	//生成の間隔は1/60秒より短くしない
+	const float kDeltaTime = 1.0f / 60.0f;
+	float frequency = (std::max)(popFrequency_, kDeltaTime);
+	frequencyTime_ += deltaTime;
+	uint32_t popCount = 0;
+	if (!spawnFinished_)
+	{
+		//長いフレームの後は経過した時間の分だけまとめて生成する
+		uint32_t popTimes = 0;
+		while (frequency <= frequencyTime_ && popTimes < kMaxPopTimesPerUpdate)
 		{
-			particleIterator = particles_.erase(particleIterator);
+			//LODの倍率を掛けた数だけ生成する
+			popRemainder_ += float(popCount_) * lodScale_;
+			uint32_t count = uint32_t(popRemainder_);
+			popRemainder_ -= float(count);
+			popCount += count;
+			frequencyTime_ -= frequency;
+			++popTimes;
 		}
-		else
+
+		//上限を超えて追いつけなかった時間は捨てる
+		if (frequency <= frequencyTime_)
 		{
-			//加速フィールドの判定
-			if (accelerationField_.isEnable)
-			{
-				if (IsCollision(accelerationField_.area, particleIterator->get()->GetTranslation()))
-				{
-					Vector3 velocity = particleIterator->get()->GetVelocity();
-					particleIterator->get()->SetVelocity(velocity + accelerationField_.acceleration);
-				}
-			}
-
-			//重力フィールドの判定
-			if (gravityField_.isEnable)
-			{
-				if (IsCollision(gravityField_.area, particleIterator->get()->GetTranslation()))
-				{
-					//距離を計算
-					Vector3 sub = gravityField_.center - particleIterator->get()->GetTranslation();
-					float distance = Mathf::Length(sub);
-
-					//引力を計算
-					Vector3 gravityForce = Mathf::Normalize(sub) * gravityField_.strength;
-
-					//中心に近づいたら速度を0にする
-					if (distance < gravityField_.stopDistance)
-					{
-						particleIterator->get()->SetVelocity({ 0.0f,0.0f,0.0f });
-					}
-					else
-					{
-						//現在の速度に引力を足す
-						Vector3 currentVelocity = particleIterator->get()->GetVelocity();
-						particleIterator->get()->SetVelocity(currentVelocity + gravityForce);
-					}
-				}
-			}
-
-			//パーティクルの更新
-			particleIterator->get()->Update();
-
-			//イテレータを進める
-			++particleIterator;
+			frequencyTime_ = std::fmod(frequencyTime_, frequency);
 		}
 	}
+	return popCount;
+}
+
+float ParticleEmitter::GetLifeTimeScale() const
+{
+	const float kMinLifeTimeScale = 0.5f;
+	return (std::max)(lodScale_, kMinLifeTimeScale);
+}
+
+AABB ParticleEmitter::Simulate(uint32_t begin, uint32_t end, float deltaTime)
+{
+	return particles_.Simulate(begin, end, accelerationField_, gravityField_, deltaTime);
+}
 
+void ParticleEmitter::UpdateDeleteTimer(float deltaTime)
+{
 	//エミッターの死亡フラグを立てる
-	deleteTimer_ += kDeltaTime;
+	deleteTimer_ += deltaTime;
+	remainingLifeTime_ = (std::max)(remainingLifeTime_ - deltaTime, 0.0f);
 	if (deleteTimer_ > deleteTime_)
 	{
 		spawnFinished_ = true;
-		if (particles_.size() == 0)
+		if (particles_.GetCount() == 0 && remainingLifeTime_ == 0.0f)
 		{
 			isActive_ = false;
 		}
@@ -90,31 +135,31 @@ void ParticleEmitter::Pop()
 {
 	//座標
 	Vector3 translation = {
-		translation_.x + RandomGenerator::GetRandomFloat(popArea_.min.x,popArea_.max.x),
-		translation_.y + RandomGenerator::GetRandomFloat(popArea_.min.y,popArea_.max.y),
-		translation_.z + RandomGenerator::GetRandomFloat(popArea_.min.z,popArea_.max.z)
+		translation_.x + GetRandomFloat(popArea_.min.x,popArea_.max.x),
+		translation_.y + GetRandomFloat(popArea_.min.y,popArea_.max.y),
+		translation_.z + GetRandomFloat(popArea_.min.z,popArea_.max.z)
 	};
 
 	//回転
 	Vector3 rotation = {
-		RandomGenerator::GetRandomFloat(popRotation_.min.x,popRotation_.max.x),
-		RandomGenerator::GetRandomFloat(popRotation_.min.y,popRotation_.max.y),
-		RandomGenerator::GetRandomFloat(popRotation_.min.z,popRotation_.max.z)
+		GetRandomFloat(popRotation_.min.x,popRotation_.max.x),
+		GetRandomFloat(popRotation_.min.y,popRotation_.max.y),
+		GetRandomFloat(popRotation_.min.z,popRotation_.max.z)
 	};
 
 	//スケール
 	Vector3 scale = {
-		RandomGenerator::GetRandomFloat(popScale_.min.x,popScale_.max.x),
-		RandomGenerator::GetRandomFloat(popScale_.min.y,popScale_.max.y),
-		RandomGenerator::GetRandomFloat(popScale_.min.z,popScale_.max.z)
+		GetRandomFloat(popScale_.min.x,popScale_.max.x),
+		GetRandomFloat(popScale_.min.y,popScale_.max.y),
+		GetRandomFloat(popScale_.min.z,popScale_.max.z)
 	};
 
 	//方位角
-	float azimuth = { RandomGenerator::GetRandomFloat(popAzimuth.min,popAzimuth.max) };
+	float azimuth = { GetRandomFloat(popAzimuth.min,popAzimuth.max) };
 	float azimuthRadian = azimuth * float(std::numbers::pi / 180.0f);
 
 	//仰角
-	float elevation = { RandomGenerator::GetRandomFloat(popElevation.min,popElevation.max) };
+	float elevation = { GetRandomFloat(popElevation.min,popElevation.max) };
 	float elevationRadian = elevation * float(std::numbers::pi / 180.0f);
 
 	//速度
@@ -122,45 +167,84 @@ void ParticleEmitter::Pop()
 	if (azimuth != 0.0f || elevation != 0.0f)
 	{
 		velocity = {
-			RandomGenerator::GetRandomFloat(popVelocity_.min.x,popVelocity_.max.x) * std::cos(elevationRadian) * std::cos(azimuthRadian),
-			RandomGenerator::GetRandomFloat(popVelocity_.min.y,popVelocity_.max.y) * std::cos(elevationRadian) * std::sin(azimuthRadian),
-			RandomGenerator::GetRandomFloat(popVelocity_.min.z,popVelocity_.max.z) * std::sin(elevationRadian)
+			GetRandomFloat(popVelocity_.min.x,popVelocity_.max.x) * std::cos(elevationRadian) * std::cos(azimuthRadian),
+			GetRandomFloat(popVelocity_.min.y,popVelocity_.max.y) * std::cos(elevationRadian) * std::sin(azimuthRadian),
+			GetRandomFloat(popVelocity_.min.z,popVelocity_.max.z) * std::sin(elevationRadian)
 		};
 	}
 	else
 	{
 		velocity = {
-			RandomGenerator::GetRandomFloat(popVelocity_.min.x,popVelocity_.max.x),
-			RandomGenerator::GetRandomFloat(popVelocity_.min.y,popVelocity_.max.y),
-			RandomGenerator::GetRandomFloat(popVelocity_.min.z,popVelocity_.max.z),
+			GetRandomFloat(popVelocity_.min.x,popVelocity_.max.x),
+			GetRandomFloat(popVelocity_.min.y,popVelocity_.max.y),
+			GetRandomFloat(popVelocity_.min.z,popVelocity_.max.z),
 		};
 	}
 
 	//色
 	Vector4 color = {
-		RandomGenerator::GetRandomFloat(popColor_.min.x,popColor_.max.x),
-		RandomGenerator::GetRandomFloat(popColor_.min.y,popColor_.max.y),
-		RandomGenerator::GetRandomFloat(popColor_.min.z,popColor_.max.z),
-		RandomGenerator::GetRandomFloat(popColor_.min.w,popColor_.max.w)
+		GetRandomFloat(popColor_.min.x,popColor_.max.x),
+		GetRandomFloat(popColor_.min.y,popColor_.max.y),
+		GetRandomFloat(popColor_.min.z,popColor_.max.z),
+		GetRandomFloat(popColor_.min.w,popColor_.max.w)
 	};
 
-	//寿命
-	float lifeTime = RandomGenerator::GetRandomFloat(popLifeTime_.min, popLifeTime_.max);
+	//寿命(LODで密度を下げている間は短くする)
+	float lifeTime = GetRandomFloat(popLifeTime_.min, popLifeTime_.max) * GetLifeTimeScale();
 
 	//パーティクルの生成
-	Particle* particle = new Particle();
-	particle->Initialize(translation, rotation, popQuaternion_, scale, velocity, color, lifeTime);
-	particles_.push_back(std::unique_ptr<Particle>(particle));
+	particles_.Add(translation, rotation, popQuaternion_, scale, velocity, color, lifeTime);
 }
 
-bool ParticleEmitter::IsCollision(const AABB& aabb, const Vector3& point)
+void ParticleEmitter::SetSeed(uint32_t seed)
 {
-	if (aabb.min.x <= point.x && aabb.max.x >= point.x &&
-		aabb.min.y <= point.y && aabb.max.y >= point.y &&
-		aabb.min.z <= point.z && aabb.max.z >= point.z)
+	seed_ = seed;
+	randomStream_.SetSeed(seed);
+}
+
+uint32_t ParticleEmitter::ComputeMaxParticleCount() const
+{
+	//死亡フラグが立ってから削除されるまでの2フレーム分を寿命に足す
+	const float kDeltaTime = 1.0f / 60.0f;
+	float lifeTime = (std::max)(popLifeTime_.min, popLifeTime_.max) + kDeltaTime * 2.0f;
+
+	//生成の間隔は1/60秒より短くならない。長いフレームの後は1回の更新でまとめて生成される
+	float frequency = (std::max)(popFrequency_, kDeltaTime);
+	uint32_t popTimes = uint32_t(std::ceil(lifeTime / frequency)) + 1;
+	if (popTimes < kMaxPopTimesPerUpdate)
 	{
-		return true;
+		popTimes = kMaxPopTimesPerUpdate;
 	}
+	return popCount_ * popTimes;
+}
 
-	return false;
+uint32_t ParticleEmitter::ComputeSteadyParticleCount() const
+{
+	const float kDeltaTime = 1.0f / 60.0f;
+	float lifeTime = (std::max)(popLifeTime_.min, popLifeTime_.max);
+	float frequency = (std::max)(popFrequency_, kDeltaTime);
+	return popCount_ * uint32_t(std::ceil(lifeTime / frequency));
+}
+
+uint32_t ParticleEmitter::ComputeSpawnCount(float deltaTime) const
+{
+	if (spawnFinished_)
+	{
+		return 0;
+	}
+
+	//UpdatePopTimerと同じく1回の更新で生成する回数には上限がある
+	const float kDeltaTime = 1.0f / 60.0f;
+	float frequency = (std::max)(popFrequency_, kDeltaTime);
+	uint32_t popTimes = uint32_t((frequencyTime_ + deltaTime) / frequency);
+	if (kMaxPopTimesPerUpdate < popTimes)
+	{
+		popTimes = kMaxPopTimesPerUpdate;
+	}
+	return popCount_ * popTimes;
+}
+
+float ParticleEmitter::GetRandomFloat(float min, float max)
+{
+	return min + (max - min) * randoms_[randomIndex_++];
 }
\ No newline at end of file
@@ -1,25 +1,8 @@
 #pragma once
-#include "Engine/Math/AABB.h"
-#include "Particle.h"
+#include "ParticlePool.h"
+#include "Engine/Utilities/RandomGenerator.h"
 #include <string>
-#include <memory>
-#include <list>
-
-struct AccelerationField
-{
-	Vector3 acceleration;//加速度
-	AABB area;//範囲
-	bool isEnable;//フラグ
-};
-
-struct GravityField
-{
-	Vector3 center;//中心点
-	AABB area;//範囲
-	float strength;//重力の強さ
-	float stopDistance;//動きを止める距離
-	bool isEnable;//フラグ
-};
+#include <vector>
 
 class ParticleEmitter
 {
@@ -42,9 +25,24 @@ public:
 		float max;
 	};
 
-	void Update();
+	ParticleEmitter();
+
+	//deltaTimeは前の更新からの経過時間(秒)
+	void Update(float deltaTime);
+
+	//パーティクルの生成と死亡したパーティクルの削除
+	void Emit(float deltaTime);
+
+	//GPUで生成と移動を行う場合の生成処理。今回生成する数と乱数のシード値を含めた生成の設定を書き込んで生成する数を返す
+	uint32_t EmitGPU(float deltaTime, ConstBuffDataGPUParticleEmitter& emitterData);
 
-	std::list<std::unique_ptr<Particle>>& GetParticles() { return particles_; };
+	//[begin,end)のパーティクルを移動させて移動後の座標を囲むAABBを返す(範囲が重ならなければ別スレッドから同時に呼べる)
+	AABB Simulate(uint32_t begin, uint32_t end, float deltaTime);
+
+	//エミッターの寿命を進める
+	void UpdateDeleteTimer(float deltaTime);
+
+	ParticlePool& GetParticles() { return particles_; };
 
 	const std::string& GetName() const { return name_; };
 
@@ -130,13 +128,49 @@ public:
 
 	void SetGravityField(const GravityField& gravityField) { gravityField_ = gravityField; };
 
+	const uint32_t GetSeed() const { return seed_; };
+
+	//同じシード値なら同じ順番で同じパーティクルが生成される
+	void SetSeed(uint32_t seed);
+
+	//パーティクルの座標を囲むAABB(パーティクルの大きさは含まない)
+	const AABB& GetBounds() const { return bounds_; };
+
+	void SetBounds(const AABB& bounds) { bounds_ = bounds; };
+
+	const int32_t GetPriority() const { return priority_; };
+
+	//パーティクルの上限を超えた時に優先度が高いエミッターから順に生成する
+	void SetPriority(int32_t priority) { priority_ = priority; };
+
+	const float GetLodScale() const { return lodScale_; };
+
+	//生成数と寿命に掛ける倍率(1で最大密度)
+	void SetLodScale(float lodScale) { lodScale_ = lodScale; };
+
+	//生成頻度と寿命から同時に存在できるパーティクルの最大数を計算する(長いフレームの後にまとめて生成した分も含めるので確保する容量に使う)
+	uint32_t ComputeMaxParticleCount() const;
+
+	//最大密度で生成し続けた時に同時に存在するパーティクルの数(popCount*ceil(寿命/生成間隔))
+	uint32_t ComputeSteadyParticleCount() const;
+
+	//次にdeltaTime秒進めた時に最大密度で生成する数
+	uint32_t ComputeSpawnCount(float deltaTime) const;
+
 private:
+	//生成の間隔を進めて今回生成する数を返す
+	uint32_t UpdatePopTimer(float deltaTime);
+
+	//LODで密度を下げている間は寿命を短くする
+	float GetLifeTimeScale() const;
+
 	void Pop();
 
-	bool IsCollision(const AABB& aabb, const Vector3& point);
+	//生成時にまとめて作った乱数を順番に[min,max)に変換して取り出す
+	float GetRandomFloat(float min, float max);
 
 private:
-	std::list<std::unique_ptr<Particle>> particles_{};
+	ParticlePool particles_{};
 
 	std::string name_ = "nameless";
 
@@ -178,6 +212,35 @@ private:
 
 	GravityField gravityField_{};
 
+	int32_t priority_ = 0;
+
+	float lodScale_ = 1.0f;
+
+	//LODで生成数を減らした時の端数(次の生成に持ち越す)
+	float popRemainder_ = 0.0f;
+
+	//最後に生成したパーティクルが消えるまでの時間(GPUで移動させる場合はCPUでパーティクルの数が分からないので使う)
+	float remainingLifeTime_ = 0.0f;
+
+	//最後に移動させた時のパーティクルの範囲
+	AABB bounds_ = { {0.0f,0.0f,0.0f},{0.0f,0.0f,0.0f} };
+
+	//エミッターごとの乱数(スレッド間で共有しない)
+	uint32_t seed_ = 0;
+
+	RandomStream randomStream_{};
+
+	//1回の生成で使う乱数
+	std::vector<float> randoms_{};
+
+	uint32_t randomIndex_ = 0;
+
+	//1つのパーティクルの生成に使う乱数の数
+	static const uint32_t kRandomsPerParticle = 19;
+
+	//長いフレームの後に1回の更新で生成する回数の上限(超えた分の時間は捨てる)
+	static const uint32_t kMaxPopTimesPerUpdate = 8;
+
 	friend class ParticleEmitterBuilder;
 };
 
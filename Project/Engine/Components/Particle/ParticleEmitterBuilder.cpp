@@ -108,6 +108,18 @@ ParticleEmitterBuilder& ParticleEmitterBuilder::SetGravityField(const GravityFie
 	return *this;
 }
 
+ParticleEmitterBuilder& ParticleEmitterBuilder::SetSeed(uint32_t seed)
+{
+	particleEmitter_->SetSeed(seed);
+	return *this;
+}
+
+ParticleEmitterBuilder& ParticleEmitterBuilder::SetPriority(int32_t priority)
+{
+	particleEmitter_->SetPriority(priority);
+	return *this;
+}
+
 ParticleEmitter* ParticleEmitterBuilder::Build()
 {
 	return particleEmitter_;
@@ -138,6 +138,20 @@ public:
 	/// <returns></returns>
 	ParticleEmitterBuilder& SetGravityField(const GravityField& gravityField);
 
+	/// <summary>
+	/// 乱数のシード値を設定
+	/// </summary>
+	/// <param name="seed"></param>
+	/// <returns></returns>
+	ParticleEmitterBuilder& SetSeed(uint32_t seed);
+
+	/// <summary>
+	/// パーティクルの上限を超えた時の優先度を設定
+	/// </summary>
+	/// <param name="priority"></param>
+	/// <returns></returns>
+	ParticleEmitterBuilder& SetPriority(int32_t priority);
+
 	/// <summary>
 	/// エミッターを作成
 	/// </summary>
@@ -0,0 +1,18 @@
+#pragma once
+#include "Engine/Math/AABB.h"
+
+struct AccelerationField
+{
+	Vector3 acceleration;//加速度
+	AABB area;//範囲
+	bool isEnable;//フラグ
+};
+
+struct GravityField
+{
+	Vector3 center;//中心点
+	AABB area;//範囲
+	float strength;//重力の強さ
+	float stopDistance;//動きを止める距離
+	bool isEnable;//フラグ
+};
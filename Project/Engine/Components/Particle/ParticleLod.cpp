@@ -0,0 +1,94 @@
+#include "ParticleLod.h"
+#include "ParticleEmitter.h"
+#include "Engine/Math/MathFunction.h"
+#include <algorithm>
+
+namespace ParticleLod
+{
+	EmitterLod MakeEmitterLod(ParticleEmitter* emitter, float deltaTime, const Vector3& cameraPosition, float projectionScale)
+	{
+		//生成の間隔は1/60秒より短くならない
+		const float kDeltaTime = 1.0f / 60.0f;
+		EmitterLod emitterLod{};
+		emitterLod.emitter = emitter;
+		emitterLod.priority = emitter->GetPriority();
+		emitterLod.steadyParticleCount = float(emitter->ComputeSteadyParticleCount());
+		emitterLod.projectedSpawnCount = float(emitter->ComputeSpawnCount(deltaTime));
+		emitterLod.spawnCount = float(emitter->GetPopCount()) * deltaTime / (std::max)(emitter->GetPopFrequency(), kDeltaTime);
+
+		//画面上の大きさはパーティクルの範囲を囲む球の半径を距離で割って求める(まだ移動していない場合は大きさ0)
+		const AABB& bounds = emitter->GetBounds();
+		Vector3 center = emitter->GetTranslation();
+		float radius = 0.0f;
+		if (bounds.min.x <= bounds.max.x)
+		{
+			center = (bounds.min + bounds.max) * 0.5f;
+			radius = Mathf::Length(bounds.max - bounds.min) * 0.5f;
+		}
+		emitterLod.distance = Mathf::Length(center - cameraPosition);
+		emitterLod.screenSize = emitterLod.distance > radius ? projectionScale * radius / emitterLod.distance : projectionScale;
+		return emitterLod;
+	}
+
+	uint32_t AssignLodScales(std::vector<EmitterLod>& emitterLods, uint32_t particleCount, uint32_t maxParticleCount, uint32_t maxSpawnCountPerFrame)
+	{
+		float projectedSpawnCount = 0.0f;
+		float totalSpawnCount = 0.0f;
+		for (const EmitterLod& emitterLod : emitterLods)
+		{
+			projectedSpawnCount += emitterLod.projectedSpawnCount;
+			totalSpawnCount += emitterLod.spawnCount;
+		}
+
+		//上限に収まる場合は全て最大密度にする
+		if (float(particleCount) + projectedSpawnCount <= float(maxParticleCount) && totalSpawnCount <= float(maxSpawnCountPerFrame))
+		{
+			for (const EmitterLod& emitterLod : emitterLods)
+			{
+				emitterLod.emitter->SetLodScale(1.0f);
+			}
+			return 0;
+		}
+
+		//優先度が高く、画面上で大きく、カメラに近い順に残りの上限から割り当てる
+		std::sort(emitterLods.begin(), emitterLods.end(), [](const EmitterLod& a, const EmitterLod& b)
+			{
+				if (a.priority != b.priority)
+				{
+					return a.priority > b.priority;
+				}
+				if (a.screenSize != b.screenSize)
+				{
+					return a.screenSize > b.screenSize;
+				}
+				return a.distance < b.distance;
+			}
+		);
+
+		//エミッターには最大密度で生成し続けた時の数を割り当てる
+		uint32_t reducedEmitterCount = 0;
+		float remainingParticleCount = float(maxParticleCount);
+		float remainingSpawnCount = float(maxSpawnCountPerFrame);
+		for (const EmitterLod& emitterLod : emitterLods)
+		{
+			float lodScale = 1.0f;
+			if (emitterLod.steadyParticleCount > 0.0f)
+			{
+				lodScale = (std::min)(lodScale, remainingParticleCount / emitterLod.steadyParticleCount);
+			}
+			if (emitterLod.spawnCount > 0.0f)
+			{
+				lodScale = (std::min)(lodScale, remainingSpawnCount / emitterLod.spawnCount);
+			}
+			lodScale = (std::max)(lodScale, 0.0f);
+			emitterLod.emitter->SetLodScale(lodScale);
+			remainingParticleCount -= emitterLod.steadyParticleCount * lodScale;
+			remainingSpawnCount -= emitterLod.spawnCount * lodScale;
+			if (lodScale < 1.0f)
+			{
+				++reducedEmitterCount;
+			}
+		}
+		return reducedEmitterCount;
+	}
+}
\ No newline at end of file
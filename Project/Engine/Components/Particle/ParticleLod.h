@@ -0,0 +1,31 @@
+#pragma once
+#include "Engine/Math/Vector3.h"
+#include <cstdint>
+#include <vector>
+
+class ParticleEmitter;
+
+//パーティクルの上限を超えた時にエミッターごとの生成の倍率(LOD)を決める(描画に依存しないのでGPUを使わずに確かめられる)
+namespace ParticleLod
+{
+	struct EmitterLod
+	{
+		ParticleEmitter* emitter;
+		int32_t priority;
+		float screenSize;
+		float distance;
+		//最大密度で生成し続けた時に同時に存在する数
+		float steadyParticleCount;
+		//今回の更新で最大密度で生成する数
+		float projectedSpawnCount;
+		//1フレームあたりの平均の生成数
+		float spawnCount;
+	};
+
+	//deltaTime秒進める前のエミッターの状態と直前のDrawのカメラから割り当てに使う値を求める
+	EmitterLod MakeEmitterLod(ParticleEmitter* emitter, float deltaTime, const Vector3& cameraPosition, float projectionScale);
+
+	//今生きているパーティクルに今回の生成数を足して上限を超える場合か、平均の生成数が上限を超える場合だけ倍率を下げる
+	//倍率を下げる時は優先度、画面上の大きさ、距離の順に並べ替えて割り当てる。倍率を下げたエミッターの数を返す
+	uint32_t AssignLodScales(std::vector<EmitterLod>& emitterLods, uint32_t particleCount, uint32_t maxParticleCount, uint32_t maxSpawnCountPerFrame);
+}
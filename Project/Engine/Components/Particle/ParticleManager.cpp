@@ -1,4 +1,10 @@
 #include "ParticleManager.h"
+#include "Engine/Base/GraphicsCore.h"
+#include "Engine/Math/MathFunction.h"
+#include "Engine/Utilities/ThreadPool.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
 
 ParticleManager* ParticleManager::instance_ = nullptr;
 
@@ -28,14 +34,146 @@ ParticleSystem* ParticleManager::Create(const std::string& name)
 
 void ParticleManager::Update()
 {
+	Update(GraphicsCore::GetInstance()->GetDeltaTime());
+}
+
+void ParticleManager::Update(float deltaTime)
+{
+	//寿命が尽きたエミッターを削除して全てのシステムのエミッターを集める
+	particleEmitters_.clear();
 	for (auto& particleSystem : particleSystems_)
 	{
-		particleSystem.second->Update();
+		particleSystem.second->RemoveDeadEmitters();
+		particleSystem.second->AppendParticleEmitters(particleEmitters_);
+	}
+
+	//GPUで移動させるシステムはこのUpdateで進めた時間の分を1回でまとめて進める
+	float gpuDeltaTime = 0.0f;
+	if (isFixedTimeStep_)
+	{
+		//貯まった時間を固定の時間ずつ進める
+		accumulatedTime_ += deltaTime;
+		uint32_t stepCount = 0;
+		UpdateEmitterLods((std::min)(accumulatedTime_, fixedDeltaTime_ * float(kMaxStepCount)));
+		while (fixedDeltaTime_ <= accumulatedTime_ && stepCount < kMaxStepCount)
+		{
+			Step(fixedDeltaTime_);
+			accumulatedTime_ -= fixedDeltaTime_;
+			++stepCount;
+		}
+		gpuDeltaTime = fixedDeltaTime_ * float(stepCount);
+
+		//上限を超えて追いつけなかった時間は捨てる
+		if (fixedDeltaTime_ <= accumulatedTime_)
+		{
+			accumulatedTime_ = std::fmod(accumulatedTime_, fixedDeltaTime_);
+		}
+	}
+	else
+	{
+		//長いフレームの後に一度に進めすぎないようにする
+		const float kMaxDeltaTime = 0.25f;
+		deltaTime = (std::min)(deltaTime, kMaxDeltaTime);
+		UpdateEmitterLods(deltaTime);
+		Step(deltaTime);
+		gpuDeltaTime = deltaTime;
+	}
+
+	if (gpuDeltaTime > 0.0f)
+	{
+		for (auto& particleSystem : particleSystems_)
+		{
+			if (particleSystem.second->GetIsGPUSimulated())
+			{
+				particleSystem.second->Update(gpuDeltaTime);
+			}
+		}
+	}
+}
+
+void ParticleManager::Step(float deltaTime)
+{
+	//マルチスレッドを使わないときはスレッドプールを生成しない
+	ThreadPool* threadPool = isMultithreaded_ ? ThreadPool::GetInstance() : nullptr;
+	bool isParallel = threadPool && threadPool->GetThreadCount() > 1;
+
+	//生成はエミッターごとの乱数を使うのでエミッター単位で分担する
+	auto emitRange = [this, deltaTime](uint32_t begin, uint32_t end, uint32_t)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				particleEmitters_[i]->Emit(deltaTime);
+			}
+		};
+
+	if (isParallel)
+	{
+		threadPool->ParallelFor(uint32_t(particleEmitters_.size()), 1, emitRange);
+	}
+	else
+	{
+		emitRange(0, uint32_t(particleEmitters_.size()), 0);
+	}
+
+	//移動はパーティクルごとに独立しているので大きいエミッターは分割して分担する
+	simulationChunks_.clear();
+	for (ParticleEmitter* particleEmitter : particleEmitters_)
+	{
+		uint32_t particleCount = particleEmitter->GetParticles().GetCount();
+		for (uint32_t begin = 0; begin < particleCount; begin += kParticlesPerChunk)
+		{
+			simulationChunks_.push_back({ particleEmitter,begin,(std::min)(begin + kParticlesPerChunk,particleCount),{} });
+		}
+	}
+
+	auto simulateRange = [this, deltaTime](uint32_t begin, uint32_t end, uint32_t)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				SimulationChunk& chunk = simulationChunks_[i];
+				chunk.bounds = chunk.emitter->Simulate(chunk.begin, chunk.end, deltaTime);
+			}
+		};
+
+	if (isParallel)
+	{
+		threadPool->ParallelFor(uint32_t(simulationChunks_.size()), 1, simulateRange);
+	}
+	else
+	{
+		simulateRange(0, uint32_t(simulationChunks_.size()), 0);
+	}
+
+	//チャンクごとの範囲をまとめてエミッターの範囲にする
+	for (ParticleEmitter* particleEmitter : particleEmitters_)
+	{
+		particleEmitter->SetBounds({ {FLT_MAX,FLT_MAX,FLT_MAX},{-FLT_MAX,-FLT_MAX,-FLT_MAX} });
+	}
+	for (const SimulationChunk& chunk : simulationChunks_)
+	{
+		AABB bounds = chunk.emitter->GetBounds();
+		bounds.min.x = (std::min)(bounds.min.x, chunk.bounds.min.x);
+		bounds.min.y = (std::min)(bounds.min.y, chunk.bounds.min.y);
+		bounds.min.z = (std::min)(bounds.min.z, chunk.bounds.min.z);
+		bounds.max.x = (std::max)(bounds.max.x, chunk.bounds.max.x);
+		bounds.max.y = (std::max)(bounds.max.y, chunk.bounds.max.y);
+		bounds.max.z = (std::max)(bounds.max.z, chunk.bounds.max.z);
+		chunk.emitter->SetBounds(bounds);
+	}
+
+	//エミッターの寿命を進める
+	for (ParticleEmitter* particleEmitter : particleEmitters_)
+	{
+		particleEmitter->UpdateDeleteTimer(deltaTime);
 	}
 }
 
 void ParticleManager::Draw(const Camera& camera)
 {
+	//次のUpdateのLODの計算に使う
+	cameraPosition_ = camera.translation_;
+	projectionScale_ = camera.matProjection_.m[1][1];
+
 	for (auto& particleSystem : particleSystems_)
 	{
 		particleSystem.second->Draw(camera);
@@ -50,6 +188,18 @@ void ParticleManager::Clear()
 	}
 }
 
+void ParticleManager::UpdateEmitterLods(float deltaTime)
+{
+	emitterLods_.clear();
+	particleCount_ = 0;
+	for (ParticleEmitter* particleEmitter : particleEmitters_)
+	{
+		particleCount_ += particleEmitter->GetParticles().GetCount();
+		emitterLods_.push_back(ParticleLod::MakeEmitterLod(particleEmitter, deltaTime, cameraPosition_, projectionScale_));
+	}
+	reducedEmitterCount_ = ParticleLod::AssignLodScales(emitterLods_, particleCount_, maxParticleCount_, maxSpawnCountPerFrame_);
+}
+
 ParticleSystem* ParticleManager::CreateInternal(const std::string& name)
 {
 	auto it = particleSystems_.find(name);
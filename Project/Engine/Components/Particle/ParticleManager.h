@@ -1,6 +1,8 @@
 #pragma once
 #include "ParticleSystem.h"
+#include "ParticleLod.h"
 #include <unordered_map>
+#include <vector>
 
 class ParticleManager
 {
@@ -11,13 +13,54 @@ public:
 
 	static ParticleSystem* Create(const std::string& name);
 
+	//前のフレームからの経過時間で更新する
 	void Update();
 
+	void Update(float deltaTime);
+
 	void Draw(const Camera& camera);
 
 	void Clear();
 
+	const bool GetIsMultithreaded() const { return isMultithreaded_; };
+
+	void SetIsMultithreaded(bool isMultithreaded) { isMultithreaded_ = isMultithreaded; };
+
+	const bool GetIsFixedTimeStep() const { return isFixedTimeStep_; };
+
+	//経過時間を貯めて固定の時間ずつ更新する(フレームレートに関係なく同じ結果になる)
+	void SetIsFixedTimeStep(bool isFixedTimeStep) { isFixedTimeStep_ = isFixedTimeStep; };
+
+	const float GetFixedDeltaTime() const { return fixedDeltaTime_; };
+
+	void SetFixedDeltaTime(float fixedDeltaTime) { fixedDeltaTime_ = fixedDeltaTime; };
+
+	const uint32_t GetMaxParticleCount() const { return maxParticleCount_; };
+
+	//全てのパーティクルの上限(生きている数と今回の生成数の合計が超える場合は優先度と画面上の大きさが小さいエミッターから生成を減らす)
+	void SetMaxParticleCount(uint32_t maxParticleCount) { maxParticleCount_ = maxParticleCount; };
+
+	const uint32_t GetMaxSpawnCountPerFrame() const { return maxSpawnCountPerFrame_; };
+
+	//1回のUpdateで生成するパーティクルの上限(生成頻度から求めた平均で判定する)
+	void SetMaxSpawnCountPerFrame(uint32_t maxSpawnCountPerFrame) { maxSpawnCountPerFrame_ = maxSpawnCountPerFrame; };
+
+	//直前のUpdateの開始時点のパーティクルの数
+	const uint32_t GetParticleCount() const { return particleCount_; };
+
+	//直前のUpdateで生成を減らしたエミッターの数
+	const uint32_t GetReducedEmitterCount() const { return reducedEmitterCount_; };
+
 private:
+	//1つのジョブで移動させるパーティクルの範囲
+	struct SimulationChunk
+	{
+		ParticleEmitter* emitter;
+		uint32_t begin;
+		uint32_t end;
+		AABB bounds;
+	};
+
 	ParticleManager() = default;
 	~ParticleManager() = default;
 	ParticleManager(const ParticleManager&) = delete;
@@ -26,9 +69,50 @@ private:
 private:
 	ParticleSystem* CreateInternal(const std::string& name);
 
+	//上限に収まるようにエミッターごとの生成の倍率を決める
+	void UpdateEmitterLods(float deltaTime);
+
+	//全てのエミッターをdeltaTime秒分進める
+	void Step(float deltaTime);
+
 private:
 	static ParticleManager* instance_;
 
 	std::unordered_map<std::string, std::unique_ptr<ParticleSystem>> particleSystems_;
+
+	//全てのシステムの生きているエミッター
+	std::vector<ParticleEmitter*> particleEmitters_{};
+
+	std::vector<SimulationChunk> simulationChunks_{};
+
+	std::vector<ParticleLod::EmitterLod> emitterLods_{};
+
+	//LODの計算に使う直前のDrawのカメラ
+	Vector3 cameraPosition_ = { 0.0f,0.0f,0.0f };
+
+	float projectionScale_ = 0.0f;
+
+	uint32_t maxParticleCount_ = 1 << 20;
+
+	uint32_t maxSpawnCountPerFrame_ = 1 << 16;
+
+	uint32_t particleCount_ = 0;
+
+	uint32_t reducedEmitterCount_ = 0;
+
+	bool isMultithreaded_ = true;
+
+	bool isFixedTimeStep_ = false;
+
+	float fixedDeltaTime_ = 1.0f / 60.0f;
+
+	//固定の時間に満たずにまだ進めていない時間
+	float accumulatedTime_ = 0.0f;
+
+	//長いフレームの後に1回のUpdateで進める回数の上限(超えた分の時間は捨てる)
+	static const uint32_t kMaxStepCount = 4;
+
+	//1回のジョブで移動させるパーティクルの数(SIMDで処理する8の倍数にする)
+	static const uint32_t kParticlesPerChunk = 4096;
 };
 
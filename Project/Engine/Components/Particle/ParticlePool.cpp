@@ -0,0 +1,402 @@
+#include "ParticlePool.h"
+#include "Engine/Math/MathFunction.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define PARTICLE_POOL_USE_SSE
+#endif
+
+void ParticlePool::Reserve(uint32_t capacity)
+{
+	//今いるパーティクルより小さくはしない
+	capacity_ = (std::max)(capacity, count_);
+	translationX_.resize(capacity_);
+	translationY_.resize(capacity_);
+	translationZ_.resize(capacity_);
+	velocityX_.resize(capacity_);
+	velocityY_.resize(capacity_);
+	velocityZ_.resize(capacity_);
+	colorR_.resize(capacity_);
+	colorG_.resize(capacity_);
+	colorB_.resize(capacity_);
+	colorA_.resize(capacity_);
+	lifeTimes_.resize(capacity_);
+	currentTimes_.resize(capacity_);
+	alphas_.resize(capacity_);
+	isDead_.resize(capacity_);
+	quaternions_.resize(capacity_);
+	scales_.resize(capacity_);
+}
+
+bool ParticlePool::Add(const Vector3& translation, const Vector3& rotation, const Quaternion& quaternion, const Vector3& scale, const Vector3& velocity, const Vector4& color, float lifeTime)
+{
+	if (count_ >= capacity_)
+	{
+		return false;
+	}
+
+	uint32_t index = count_++;
+
+	//座標
+	translationX_[index] = translation.x;
+	translationY_[index] = translation.y;
+	translationZ_[index] = translation.z;
+
+	//速度
+	velocityX_[index] = velocity.x;
+	velocityY_[index] = velocity.y;
+	velocityZ_[index] = velocity.z;
+
+	//色
+	colorR_[index] = color.x;
+	colorG_[index] = color.y;
+	colorB_[index] = color.z;
+	colorA_[index] = color.w;
+
+	//寿命
+	lifeTimes_[index] = lifeTime;
+	currentTimes_[index] = 0.0f;
+	alphas_[index] = color.w;
+	isDead_[index] = 0;
+
+	//角度が指定されていればクォータニオンより優先する
+	quaternions_[index] = rotation != Vector3{ 0.0f,0.0f,0.0f } ? Mathf::MakeRotateQuaternion(rotation) : quaternion;
+	scales_[index] = scale;
+
+	return true;
+}
+
+void ParticlePool::Remove(uint32_t index)
+{
+	//最後のパーティクルを削除する番号に移動する
+	uint32_t last = --count_;
+	if (index != last)
+	{
+		translationX_[index] = translationX_[last];
+		translationY_[index] = translationY_[last];
+		translationZ_[index] = translationZ_[last];
+		velocityX_[index] = velocityX_[last];
+		velocityY_[index] = velocityY_[last];
+		velocityZ_[index] = velocityZ_[last];
+		colorR_[index] = colorR_[last];
+		colorG_[index] = colorG_[last];
+		colorB_[index] = colorB_[last];
+		colorA_[index] = colorA_[last];
+		lifeTimes_[index] = lifeTimes_[last];
+		currentTimes_[index] = currentTimes_[last];
+		alphas_[index] = alphas_[last];
+		isDead_[index] = isDead_[last];
+		quaternions_[index] = quaternions_[last];
+		scales_[index] = scales_[last];
+	}
+}
+
+void ParticlePool::Clear()
+{
+	count_ = 0;
+}
+
+void ParticlePool::Update(const AccelerationField& accelerationField, const GravityField& gravityField, float deltaTime)
+{
+	RemoveDeadParticles();
+	Simulate(0, count_, accelerationField, gravityField, deltaTime);
+}
+
+AABB ParticlePool::Simulate(uint32_t begin, uint32_t end, const AccelerationField& accelerationField, const GravityField& gravityField, float deltaTime)
+{
+	//速度と加速度は1/60秒あたりの量なので経過時間をフレーム数に直して掛ける
+	const float kFrameRate = 60.0f;
+	float timeScale = deltaTime * kFrameRate;
+	end = (std::min)(end, count_);
+	uint32_t index = begin;
+	AABB bounds = { {FLT_MAX,FLT_MAX,FLT_MAX},{-FLT_MAX,-FLT_MAX,-FLT_MAX} };
+#ifdef PARTICLE_POOL_USE_SSE
+	const __m128 kZero = _mm_setzero_ps();
+	const __m128 deltaTimes = _mm_set1_ps(deltaTime);
+	const __m128 timeScales = _mm_set1_ps(timeScale);
+
+	//加速フィールド
+	const __m128 accelerationX = _mm_set1_ps(accelerationField.acceleration.x * timeScale);
+	const __m128 accelerationY = _mm_set1_ps(accelerationField.acceleration.y * timeScale);
+	const __m128 accelerationZ = _mm_set1_ps(accelerationField.acceleration.z * timeScale);
+	const __m128 accelerationMinX = _mm_set1_ps(accelerationField.area.min.x);
+	const __m128 accelerationMinY = _mm_set1_ps(accelerationField.area.min.y);
+	const __m128 accelerationMinZ = _mm_set1_ps(accelerationField.area.min.z);
+	const __m128 accelerationMaxX = _mm_set1_ps(accelerationField.area.max.x);
+	const __m128 accelerationMaxY = _mm_set1_ps(accelerationField.area.max.y);
+	const __m128 accelerationMaxZ = _mm_set1_ps(accelerationField.area.max.z);
+
+	//重力フィールド
+	const __m128 centerX = _mm_set1_ps(gravityField.center.x);
+	const __m128 centerY = _mm_set1_ps(gravityField.center.y);
+	const __m128 centerZ = _mm_set1_ps(gravityField.center.z);
+	const __m128 gravityMinX = _mm_set1_ps(gravityField.area.min.x);
+	const __m128 gravityMinY = _mm_set1_ps(gravityField.area.min.y);
+	const __m128 gravityMinZ = _mm_set1_ps(gravityField.area.min.z);
+	const __m128 gravityMaxX = _mm_set1_ps(gravityField.area.max.x);
+	const __m128 gravityMaxY = _mm_set1_ps(gravityField.area.max.y);
+	const __m128 gravityMaxZ = _mm_set1_ps(gravityField.area.max.z);
+	const __m128 strength = _mm_set1_ps(gravityField.strength);
+	const __m128 stopDistance = _mm_set1_ps(gravityField.stopDistance);
+
+	//移動後の座標の範囲
+	__m128 boundsMinX = _mm_set1_ps(FLT_MAX);
+	__m128 boundsMinY = _mm_set1_ps(FLT_MAX);
+	__m128 boundsMinZ = _mm_set1_ps(FLT_MAX);
+	__m128 boundsMaxX = _mm_set1_ps(-FLT_MAX);
+	__m128 boundsMaxY = _mm_set1_ps(-FLT_MAX);
+	__m128 boundsMaxZ = _mm_set1_ps(-FLT_MAX);
+
+	//8個ずつまとめて更新する(4個ずつ2回に分けて依存関係を減らす)
+	for (; index + 8 <= end; index += 8)
+	{
+		for (uint32_t offset = index; offset < index + 8; offset += 4)
+		{
+			__m128 px = _mm_loadu_ps(&translationX_[offset]);
+			__m128 py = _mm_loadu_ps(&translationY_[offset]);
+			__m128 pz = _mm_loadu_ps(&translationZ_[offset]);
+			__m128 vx = _mm_loadu_ps(&velocityX_[offset]);
+			__m128 vy = _mm_loadu_ps(&velocityY_[offset]);
+			__m128 vz = _mm_loadu_ps(&velocityZ_[offset]);
+
+			//加速フィールドの判定
+			if (accelerationField.isEnable)
+			{
+				__m128 inside = _mm_and_ps(_mm_cmple_ps(accelerationMinX, px), _mm_cmpge_ps(accelerationMaxX, px));
+				inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmple_ps(accelerationMinY, py), _mm_cmpge_ps(accelerationMaxY, py)));
+				inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmple_ps(accelerationMinZ, pz), _mm_cmpge_ps(accelerationMaxZ, pz)));
+
+				//範囲内の要素だけ加速度を足す
+				vx = _mm_or_ps(_mm_and_ps(inside, _mm_add_ps(vx, accelerationX)), _mm_andnot_ps(inside, vx));
+				vy = _mm_or_ps(_mm_and_ps(inside, _mm_add_ps(vy, accelerationY)), _mm_andnot_ps(inside, vy));
+				vz = _mm_or_ps(_mm_and_ps(inside, _mm_add_ps(vz, accelerationZ)), _mm_andnot_ps(inside, vz));
+			}
+
+			//重力フィールドの判定
+			if (gravityField.isEnable)
+			{
+				__m128 inside = _mm_and_ps(_mm_cmple_ps(gravityMinX, px), _mm_cmpge_ps(gravityMaxX, px));
+				inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmple_ps(gravityMinY, py), _mm_cmpge_ps(gravityMaxY, py)));
+				inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmple_ps(gravityMinZ, pz), _mm_cmpge_ps(gravityMaxZ, pz)));
+
+				//距離を計算
+				__m128 subX = _mm_sub_ps(centerX, px);
+				__m128 subY = _mm_sub_ps(centerY, py);
+				__m128 subZ = _mm_sub_ps(centerZ, pz);
+				__m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(subX, subX), _mm_mul_ps(subY, subY)), _mm_mul_ps(subZ, subZ)));
+
+				//中心に近づいた要素は速度を0にし、それ以外は引力を足す(距離が0の要素は何もしない)
+				__m128 stop = _mm_and_ps(inside, _mm_cmplt_ps(distance, stopDistance));
+				__m128 pull = _mm_andnot_ps(stop, _mm_and_ps(inside, _mm_cmpneq_ps(distance, kZero)));
+				__m128 forceX = _mm_mul_ps(_mm_mul_ps(_mm_div_ps(subX, distance), strength), timeScales);
+				__m128 forceY = _mm_mul_ps(_mm_mul_ps(_mm_div_ps(subY, distance), strength), timeScales);
+				__m128 forceZ = _mm_mul_ps(_mm_mul_ps(_mm_div_ps(subZ, distance), strength), timeScales);
+				vx = _mm_andnot_ps(stop, _mm_or_ps(_mm_and_ps(pull, _mm_add_ps(vx, forceX)), _mm_andnot_ps(pull, vx)));
+				vy = _mm_andnot_ps(stop, _mm_or_ps(_mm_and_ps(pull, _mm_add_ps(vy, forceY)), _mm_andnot_ps(pull, vy)));
+				vz = _mm_andnot_ps(stop, _mm_or_ps(_mm_and_ps(pull, _mm_add_ps(vz, forceZ)), _mm_andnot_ps(pull, vz)));
+			}
+
+			//移動処理
+			px = _mm_add_ps(px, _mm_mul_ps(vx, timeScales));
+			py = _mm_add_ps(py, _mm_mul_ps(vy, timeScales));
+			pz = _mm_add_ps(pz, _mm_mul_ps(vz, timeScales));
+			_mm_storeu_ps(&translationX_[offset], px);
+			_mm_storeu_ps(&translationY_[offset], py);
+			_mm_storeu_ps(&translationZ_[offset], pz);
+			boundsMinX = _mm_min_ps(boundsMinX, px);
+			boundsMinY = _mm_min_ps(boundsMinY, py);
+			boundsMinZ = _mm_min_ps(boundsMinZ, pz);
+			boundsMaxX = _mm_max_ps(boundsMaxX, px);
+			boundsMaxY = _mm_max_ps(boundsMaxY, py);
+			boundsMaxZ = _mm_max_ps(boundsMaxZ, pz);
+			_mm_storeu_ps(&velocityX_[offset], vx);
+			_mm_storeu_ps(&velocityY_[offset], vy);
+			_mm_storeu_ps(&velocityZ_[offset], vz);
+
+			//寿命を減らしてアルファ値を計算
+			__m128 lifeTime = _mm_loadu_ps(&lifeTimes_[offset]);
+			__m128 currentTime = _mm_add_ps(_mm_loadu_ps(&currentTimes_[offset]), deltaTimes);
+			_mm_storeu_ps(&currentTimes_[offset], currentTime);
+			_mm_storeu_ps(&colorA_[offset], _mm_sub_ps(_mm_loadu_ps(&alphas_[offset]), _mm_div_ps(currentTime, lifeTime)));
+
+			//寿命が生存時間を上回ったら消す
+			int dead = _mm_movemask_ps(_mm_cmplt_ps(lifeTime, currentTime));
+			isDead_[offset + 0] = uint8_t(dead & 1);
+			isDead_[offset + 1] = uint8_t((dead >> 1) & 1);
+			isDead_[offset + 2] = uint8_t((dead >> 2) & 1);
+			isDead_[offset + 3] = uint8_t((dead >> 3) & 1);
+		}
+	}
+
+	//4要素の範囲をまとめる
+	alignas(16) float boundsMin[3][4]{};
+	alignas(16) float boundsMax[3][4]{};
+	_mm_store_ps(boundsMin[0], boundsMinX);
+	_mm_store_ps(boundsMin[1], boundsMinY);
+	_mm_store_ps(boundsMin[2], boundsMinZ);
+	_mm_store_ps(boundsMax[0], boundsMaxX);
+	_mm_store_ps(boundsMax[1], boundsMaxY);
+	_mm_store_ps(boundsMax[2], boundsMaxZ);
+	for (uint32_t lane = 0; lane < 4; ++lane)
+	{
+		bounds.min.x = (std::min)(bounds.min.x, boundsMin[0][lane]);
+		bounds.min.y = (std::min)(bounds.min.y, boundsMin[1][lane]);
+		bounds.min.z = (std::min)(bounds.min.z, boundsMin[2][lane]);
+		bounds.max.x = (std::max)(bounds.max.x, boundsMax[0][lane]);
+		bounds.max.y = (std::max)(bounds.max.y, boundsMax[1][lane]);
+		bounds.max.z = (std::max)(bounds.max.z, boundsMax[2][lane]);
+	}
+#endif
+	//残りはスカラーで更新
+	for (; index < end; ++index)
+	{
+		UpdateParticle(index, accelerationField, gravityField, deltaTime);
+		bounds.min.x = (std::min)(bounds.min.x, translationX_[index]);
+		bounds.min.y = (std::min)(bounds.min.y, translationY_[index]);
+		bounds.min.z = (std::min)(bounds.min.z, translationZ_[index]);
+		bounds.max.x = (std::max)(bounds.max.x, translationX_[index]);
+		bounds.max.y = (std::max)(bounds.max.y, translationY_[index]);
+		bounds.max.z = (std::max)(bounds.max.z, translationZ_[index]);
+	}
+
+	return bounds;
+}
+
+void ParticlePool::RemoveDeadParticles()
+{
+	//入れ替わったパーティクルを同じ番号で判定する
+	uint32_t index = 0;
+	while (index < count_)
+	{
+		if (isDead_[index])
+		{
+			Remove(index);
+		}
+		else
+		{
+			++index;
+		}
+	}
+}
+
+void ParticlePool::UpdateParticle(uint32_t index, const AccelerationField& accelerationField, const GravityField& gravityField, float deltaTime)
+{
+	const float kFrameRate = 60.0f;
+	float timeScale = deltaTime * kFrameRate;
+	Vector3 translation = { translationX_[index],translationY_[index],translationZ_[index] };
+	Vector3 velocity = { velocityX_[index],velocityY_[index],velocityZ_[index] };
+
+	//加速フィールドの判定
+	if (accelerationField.isEnable)
+	{
+		if (IsCollision(accelerationField.area, translation))
+		{
+			velocity = velocity + accelerationField.acceleration * timeScale;
+		}
+	}
+
+	//重力フィールドの判定
+	if (gravityField.isEnable)
+	{
+		if (IsCollision(gravityField.area, translation))
+		{
+			//距離を計算
+			Vector3 sub = gravityField.center - translation;
+			float distance = std::sqrt(sub.x * sub.x + sub.y * sub.y + sub.z * sub.z);
+
+			//中心に近づいたら速度を0にする
+			if (distance < gravityField.stopDistance)
+			{
+				velocity = { 0.0f,0.0f,0.0f };
+			}
+			else if (distance != 0.0f)
+			{
+				//現在の速度に引力を足す(Mathf::Normalizeと同じ計算順にする)
+				velocity.x += sub.x / distance * gravityField.strength * timeScale;
+				velocity.y += sub.y / distance * gravityField.strength * timeScale;
+				velocity.z += sub.z / distance * gravityField.strength * timeScale;
+			}
+		}
+	}
+
+	//移動処理
+	translationX_[index] = translation.x + velocity.x * timeScale;
+	translationY_[index] = translation.y + velocity.y * timeScale;
+	translationZ_[index] = translation.z + velocity.z * timeScale;
+	velocityX_[index] = velocity.x;
+	velocityY_[index] = velocity.y;
+	velocityZ_[index] = velocity.z;
+
+	//寿命を減らす
+	currentTimes_[index] += deltaTime;
+	colorA_[index] = alphas_[index] - (currentTimes_[index] / lifeTimes_[index]);
+
+	//寿命が生存時間を上回ったら消す
+	isDead_[index] = lifeTimes_[index] < currentTimes_[index] ? 1 : 0;
+}
+
+uint32_t ParticlePool::WriteInstances(ParticleForGPU* instances, uint32_t maxCount) const
+{
+	uint32_t count = (std::min)(count_, maxCount);
+	for (uint32_t index = 0; index < count; ++index)
+	{
+		instances[index].translation = { translationX_[index],translationY_[index],translationZ_[index] };
+		instances[index].scale = scales_[index];
+		instances[index].rotation = quaternions_[index];
+		instances[index].color = { colorR_[index],colorG_[index],colorB_[index],colorA_[index] };
+	}
+	return count;
+}
+
+uint32_t ParticlePool::WriteVisibleInstances(ParticleForGPU* instances, uint32_t maxCount, const Frustum& frustum, float radius, uint32_t& culledCount) const
+{
+	uint32_t count = 0;
+	culledCount = 0;
+	for (uint32_t index = 0; index < count_; ++index)
+	{
+		//スケールの一番大きい成分で半径を決めて球で判定する
+		const Vector3& scale = scales_[index];
+		float scaledRadius = radius * (std::max)((std::max)(std::abs(scale.x), std::abs(scale.y)), std::abs(scale.z));
+		bool isVisible = true;
+		for (const Vector4& plane : frustum.planes)
+		{
+			if (plane.x * translationX_[index] + plane.y * translationY_[index] + plane.z * translationZ_[index] + plane.w < -scaledRadius)
+			{
+				isVisible = false;
+				break;
+			}
+		}
+
+		if (!isVisible)
+		{
+			++culledCount;
+			continue;
+		}
+
+		//視錐台の中でも最大数を超えた分は書き込まない
+		if (count < maxCount)
+		{
+			instances[count].translation = { translationX_[index],translationY_[index],translationZ_[index] };
+			instances[count].scale = scale;
+			instances[count].rotation = quaternions_[index];
+			instances[count].color = { colorR_[index],colorG_[index],colorB_[index],colorA_[index] };
+			++count;
+		}
+	}
+	return count;
+}
+
+bool ParticlePool::IsCollision(const AABB& aabb, const Vector3& point)
+{
+	if (aabb.min.x <= point.x && aabb.max.x >= point.x &&
+		aabb.min.y <= point.y && aabb.max.y >= point.y &&
+		aabb.min.z <= point.z && aabb.max.z >= point.z)
+	{
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include "ParticleField.h"
+#include "Engine/Base/ConstantBuffers.h"
+#include "Engine/Math/Vector4.h"
+#include "Engine/Math/Frustum.h"
+#include "Engine/Math/Quaternion.h"
+#include <cstdint>
+#include <vector>
+
+class ParticlePool
+{
+public:
+	//最大数を変更する。今いるパーティクルはそのまま残る
+	void Reserve(uint32_t capacity);
+
+	//最大数に達している場合は追加せずにfalseを返す
+	bool Add(const Vector3& translation, const Vector3& rotation, const Quaternion& quaternion, const Vector3& scale, const Vector3& velocity, const Vector4& color, float lifeTime);
+
+	//最後のパーティクルと入れ替えて削除する(並び順は保たれない)
+	void Remove(uint32_t index);
+
+	void Clear();
+
+	//死亡フラグが立ったパーティクルを削除して、残りのパーティクルをフィールドの影響を受けて移動させる
+	//速度と加速度は1/60秒あたりの量として、deltaTime秒分進める
+	void Update(const AccelerationField& accelerationField, const GravityField& gravityField, float deltaTime);
+
+	//死亡フラグが立ったパーティクルを削除する
+	void RemoveDeadParticles();
+
+	//[begin,end)のパーティクルだけ移動させて移動後の座標を囲むAABBを返す(範囲が重ならなければ別スレッドから同時に呼べる)
+	//範囲が空の場合はminがmaxより大きいAABBを返す
+	AABB Simulate(uint32_t begin, uint32_t end, const AccelerationField& accelerationField, const GravityField& gravityField, float deltaTime);
+
+	//描画用のデータを書き込んで書き込んだ数を返す(maxCountを超えた分は書き込まない)
+	uint32_t WriteInstances(ParticleForGPU* instances, uint32_t maxCount) const;
+
+	//視錐台の外にあるパーティクルを除いて描画用のデータを書き込み、書き込んだ数を返す
+	//radiusはスケールが1の時の半径。視錐台の外にあった数をculledCountに入れる
+	uint32_t WriteVisibleInstances(ParticleForGPU* instances, uint32_t maxCount, const Frustum& frustum, float radius, uint32_t& culledCount) const;
+
+	//SIMDと同じ演算順で1つのパーティクルを更新するスカラー版
+	void UpdateParticle(uint32_t index, const AccelerationField& accelerationField, const GravityField& gravityField, float deltaTime);
+
+	const uint32_t GetCount() const { return count_; };
+
+	const uint32_t GetCapacity() const { return capacity_; };
+
+	const Vector3 GetTranslation(uint32_t index) const { return { translationX_[index],translationY_[index],translationZ_[index] }; };
+
+	const Quaternion& GetQuaternion(uint32_t index) const { return quaternions_[index]; };
+
+	const Vector3& GetScale(uint32_t index) const { return scales_[index]; };
+
+	const Vector3 GetVelocity(uint32_t index) const { return { velocityX_[index],velocityY_[index],velocityZ_[index] }; };
+
+	const Vector4 GetColor(uint32_t index) const { return { colorR_[index],colorG_[index],colorB_[index],colorA_[index] }; };
+
+	const bool GetIsDead(uint32_t index) const { return isDead_[index] != 0; };
+
+private:
+	static bool IsCollision(const AABB& aabb, const Vector3& point);
+
+private:
+	uint32_t count_ = 0;
+
+	uint32_t capacity_ = 0;
+
+	//毎フレーム更新する値は成分ごとに並べる
+	std::vector<float> translationX_{};
+	std::vector<float> translationY_{};
+	std::vector<float> translationZ_{};
+
+	std::vector<float> velocityX_{};
+	std::vector<float> velocityY_{};
+	std::vector<float> velocityZ_{};
+
+	std::vector<float> colorR_{};
+	std::vector<float> colorG_{};
+	std::vector<float> colorB_{};
+	std::vector<float> colorA_{};
+
+	//寿命
+	std::vector<float> lifeTimes_{};
+
+	//経過時間
+	std::vector<float> currentTimes_{};
+
+	//生成時のアルファ値
+	std::vector<float> alphas_{};
+
+	std::vector<uint8_t> isDead_{};
+
+	//描画の時だけ使う値(角度が指定された場合はクォータニオンに変換して持つ)
+	std::vector<Quaternion> quaternions_{};
+
+	std::vector<Vector3> scales_{};
+};
@@ -1,7 +1,10 @@
 #include "ParticleSystem.h"
 #include "Engine/Base/GraphicsCore.h"
+#include "Engine/Base/Renderer.h"
+#include "GPUParticleKernels.h"
 #include "Engine/Math/MathFunction.h"
-#include <numbers>
+#include <algorithm>
+#include <cmath>
 
 void ParticleSystem::Initialize()
 {
@@ -14,37 +17,80 @@ void ParticleSystem::Initialize()
 }
 
 void ParticleSystem::Update()
+{
+	Update(GraphicsCore::GetInstance()->GetDeltaTime());
+}
+
+void ParticleSystem::Update(float deltaTime)
+{
+	RemoveDeadEmitters();
+
+	if (isGPUSimulated_)
+	{
+		UpdateGPU(deltaTime);
+		return;
+	}
+
+	//エミッターの更新
+	for (std::unique_ptr<ParticleEmitter>& emitter : particleEmitters_)
+	{
+		emitter->Update(deltaTime);
+	}
+}
+
+void ParticleSystem::RemoveDeadEmitters()
 {
 	//エミッターの削除
-	particleEmitters_.remove_if([](std::unique_ptr<ParticleEmitter>& particleEmitter)
+	particleEmitters_.remove_if([this](std::unique_ptr<ParticleEmitter>& particleEmitter)
 		{
 			if (particleEmitter->GetIsDead())
 			{
+				ReleaseGPUParticleResource(particleEmitter.get());
 				particleEmitter.reset();
 				return true;
 			}
 			return false;
 		}
 	);
+}
+
+void ParticleSystem::AppendParticleEmitters(std::vector<ParticleEmitter*>& particleEmitters)
+{
+	//GPUで移動させるエミッターはUpdateで進める
+	if (isGPUSimulated_)
+	{
+		return;
+	}
 
-	//エミッターの更新
 	for (std::unique_ptr<ParticleEmitter>& emitter : particleEmitters_)
 	{
-		emitter->Update();
+		particleEmitters.push_back(emitter.get());
 	}
 }
 
 void ParticleSystem::Draw(const Camera& camera)
 {
+	if (isGPUSimulated_)
+	{
+		DrawGPU(camera);
+		return;
+	}
+
 	UpdateInstancingResource(camera);
+	if (numInstance_ == 0)
+	{
+		return;
+	}
+
 	CommandContext* commandContext = GraphicsCore::GetInstance()->GetCommandContext();
 	Model* model = model_ ? model_ : defaultModel_.get();
 	commandContext->SetVertexBuffer(model->vertexBufferView_);
 	commandContext->SetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	commandContext->SetConstantBuffer(0, model->materialConstBuffer_->GetGpuVirtualAddress());
-	commandContext->SetDescriptorTable(1, instancingResource_->GetSRVHandle());
+	commandContext->SetDescriptorTable(1, instancingFrames_[frameIndex_].resource->GetSRVHandle());
 	commandContext->SetConstantBuffer(2, camera.GetConstantBuffer()->GetGpuVirtualAddress());
 	commandContext->SetDescriptorTable(3, model->texture_->GetSRVHandle());
+	commandContext->SetConstantBuffer(4, particleConstBuffer_->GetGpuVirtualAddress());
 	commandContext->DrawInstanced(UINT(model->modelData_.vertices.size()), numInstance_);
 }
 
@@ -79,79 +125,375 @@ std::list<ParticleEmitter*> ParticleSystem::GetParticleEmitters(const std::strin
 
 void ParticleSystem::CreateInstancingResource()
 {
-	//Instancing用のWorldTransformリソースを作る
-	instancingResource_ = std::make_unique<StructuredBuffer>();
-	instancingResource_->Create(kMaxInstance, sizeof(ParticleForGPU));
+	//パーティクル共通の設定用のリソースを作る
+	particleConstBuffer_ = std::make_unique<UploadBuffer>();
+	particleConstBuffer_->Create(sizeof(ConstBuffDataParticle));
+	particleData_ = static_cast<ConstBuffDataParticle*>(particleConstBuffer_->Map());
+	particleData_->isBillboard = isBillboard_;
+}
+
+void ParticleSystem::UpdateGPU(float deltaTime)
+{
+	CommandContext* commandContext = GraphicsCore::GetInstance()->GetCommandContext();
+	Renderer* renderer = Renderer::GetInstance();
+	Model* model = model_ ? model_ : defaultModel_.get();
+	const float kFrameRate = 60.0f;
+	for (std::unique_ptr<ParticleEmitter>& emitter : particleEmitters_)
+	{
+		GPUParticleResource& resource = GetGPUParticleResource(emitter.get());
+
+		//生成の設定(書き込み用のメモリなので生成する数は戻り値で受け取る)
+		uint32_t popCount = emitter->EmitGPU(deltaTime, *resource.emitterData);
+
+		//移動の設定(速度と加速度は1/60秒あたりの量)
+		const AccelerationField& accelerationField = emitter->GetAccelerationField();
+		const GravityField& gravityField = emitter->GetGravityField();
+		ConstBuffDataGPUParticleSimulation* simulationData = resource.simulationData;
+		simulationData->acceleration = accelerationField.acceleration;
+		simulationData->isAccelerationEnable = accelerationField.isEnable;
+		simulationData->accelerationMin = accelerationField.area.min;
+		simulationData->accelerationMax = accelerationField.area.max;
+		simulationData->gravityCenter = gravityField.center;
+		simulationData->isGravityEnable = gravityField.isEnable;
+		simulationData->gravityMin = gravityField.area.min;
+		simulationData->gravityMax = gravityField.area.max;
+		simulationData->gravityStrength = gravityField.strength;
+		simulationData->gravityStopDistance = gravityField.stopDistance;
+		simulationData->deltaTime = deltaTime;
+		simulationData->timeScale = deltaTime * kFrameRate;
+		simulationData->maxParticleCount = resource.capacity;
+		simulationData->vertexCount = uint32_t(model->modelData_.vertices.size());
+
+		emitter->UpdateDeleteTimer(deltaTime);
+
+		//前のフレームの描画で読んだリソースに書き込めるようにする
+		commandContext->TransitionResource(*resource.instances, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+		commandContext->TransitionResource(*resource.drawArguments, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+		if (resource.isReset)
+		{
+			commandContext->TransitionResource(*resource.counters, D3D12_RESOURCE_STATE_COPY_DEST);
+			commandContext->TransitionResource(*resource.drawArguments, D3D12_RESOURCE_STATE_COPY_DEST);
+			commandContext->CopyBufferRegion(*resource.counters, 0, *resetBuffer_, 0, resource.counters->GetBufferSize());
+			commandContext->CopyBufferRegion(*resource.drawArguments, 0, *resetBuffer_, 0, resource.drawArguments->GetBufferSize());
+			commandContext->TransitionResource(*resource.counters, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+			commandContext->TransitionResource(*resource.drawArguments, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+			resource.isReset = false;
+		}
+
+		//同じルートシグネチャならPSOを切り替えても設定したルートパラメーターは残る
+		RWStructuredBuffer& sourceParticles = *resource.particles[resource.sourceIndex];
+		RWStructuredBuffer& destinationParticles = *resource.particles[resource.sourceIndex ^ 1];
+		renderer->SetGPUParticlePipelineState(Renderer::kGPUParticleEmit);
+		commandContext->SetComputeConstantBuffer(0, resource.emitterConstBuffer->GetGpuVirtualAddress());
+		commandContext->SetComputeConstantBuffer(1, resource.simulationConstBuffer->GetGpuVirtualAddress());
+		commandContext->SetComputeUnorderedAccessView(2, sourceParticles.GetGpuVirtualAddress());
+		commandContext->SetComputeUnorderedAccessView(3, destinationParticles.GetGpuVirtualAddress());
+		commandContext->SetComputeUnorderedAccessView(4, resource.instances->GetGpuVirtualAddress());
+		commandContext->SetComputeUnorderedAccessView(5, resource.counters->GetGpuVirtualAddress());
+		commandContext->SetComputeUnorderedAccessView(6, resource.drawArguments->GetGpuVirtualAddress());
+
+		//生成
+		if (popCount > 0)
+		{
+			commandContext->Dispatch(GPUParticleKernels::GetThreadGroupCount(popCount), 1, 1);
+			commandContext->InsertUAVBarrier(sourceParticles);
+			commandContext->InsertUAVBarrier(*resource.counters);
+		}
+
+		//移動(今いる数はGPUにしか無いので最大数分のスレッドを起動する)
+		renderer->SetGPUParticlePipelineState(Renderer::kGPUParticleSimulate);
+		commandContext->Dispatch(GPUParticleKernels::GetThreadGroupCount(resource.capacity), 1, 1);
+		commandContext->InsertUAVBarrier(*resource.counters);
+
+		//描画の引数の書き込み
+		renderer->SetGPUParticlePipelineState(Renderer::kGPUParticleFinish);
+		commandContext->Dispatch(1, 1, 1);
+
+		//同じフレームにもう一度更新しても書き込みが終わってから読む
+		commandContext->InsertUAVBarrier(*resource.counters);
+		commandContext->InsertUAVBarrier(destinationParticles);
+
+		//生き残ったパーティクルを次のフレームの移動前のパーティクルにする
+		resource.sourceIndex ^= 1;
+	}
+}
+
+void ParticleSystem::DrawGPU(const Camera& camera)
+{
+	numInstance_ = 0;
+	droppedInstanceCount_ = 0;
+	culledEmitterCount_ = 0;
+	culledParticleCount_ = 0;
+	particleData_->isBillboard = isBillboard_;
+	if (gpuParticleResources_.empty())
+	{
+		return;
+	}
+
+	CommandContext* commandContext = GraphicsCore::GetInstance()->GetCommandContext();
+	ID3D12CommandSignature* commandSignature = Renderer::GetInstance()->GetParticleCommandSignature();
+	Model* model = model_ ? model_ : defaultModel_.get();
+	commandContext->SetVertexBuffer(model->vertexBufferView_);
+	commandContext->SetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	commandContext->SetConstantBuffer(0, model->materialConstBuffer_->GetGpuVirtualAddress());
+	commandContext->SetConstantBuffer(2, camera.GetConstantBuffer()->GetGpuVirtualAddress());
+	commandContext->SetDescriptorTable(3, model->texture_->GetSRVHandle());
+	commandContext->SetConstantBuffer(4, particleConstBuffer_->GetGpuVirtualAddress());
+	for (auto& gpuParticleResource : gpuParticleResources_)
+	{
+		//インスタンス数はGPUが書き込んだ引数から読む
+		GPUParticleResource& resource = *gpuParticleResource.second;
+		commandContext->TransitionResource(*resource.instances, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		commandContext->TransitionResource(*resource.drawArguments, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT);
+		commandContext->SetDescriptorTable(1, resource.instances->GetSRVHandle());
+		commandContext->ExecuteIndirect(commandSignature, *resource.drawArguments);
+	}
+}
+
+ParticleSystem::GPUParticleResource& ParticleSystem::GetGPUParticleResource(ParticleEmitter* emitter)
+{
+	std::unique_ptr<GPUParticleResource>& resource = gpuParticleResources_[emitter];
+	if (!resource)
+	{
+		if (!freeGPUParticleResources_.empty())
+		{
+			//削除したエミッターのリソースを使いまわす
+			resource = std::move(freeGPUParticleResources_.back());
+			freeGPUParticleResources_.pop_back();
+		}
+		else
+		{
+			resource = std::make_unique<GPUParticleResource>();
+			resource->emitterConstBuffer = std::make_unique<UploadBuffer>();
+			resource->emitterConstBuffer->Create(sizeof(ConstBuffDataGPUParticleEmitter));
+			resource->emitterData = static_cast<ConstBuffDataGPUParticleEmitter*>(resource->emitterConstBuffer->Map());
+			resource->simulationConstBuffer = std::make_unique<UploadBuffer>();
+			resource->simulationConstBuffer->Create(sizeof(ConstBuffDataGPUParticleSimulation));
+			resource->simulationData = static_cast<ConstBuffDataGPUParticleSimulation*>(resource->simulationConstBuffer->Map());
+			resource->counters = std::make_unique<RWStructuredBuffer>();
+			resource->counters->Create(2, sizeof(uint32_t));
+			resource->drawArguments = std::make_unique<RWStructuredBuffer>();
+			resource->drawArguments->Create(4, sizeof(uint32_t));
+			resource->capacity = 0;
+		}
+
+		//前のエミッターのパーティクルを消す
+		resource->sourceIndex = 0;
+		resource->isReset = true;
+
+		if (!resetBuffer_)
+		{
+			resetBuffer_ = std::make_unique<UploadBuffer>();
+			resetBuffer_->Create(sizeof(uint32_t) * 4);
+			uint32_t* resetData = static_cast<uint32_t*>(resetBuffer_->Map());
+			std::fill(resetData, resetData + 4, 0);
+			resetBuffer_->Unmap();
+		}
+	}
+
+	//生成頻度と寿命を変更して足りなくなった場合は作り直す
+	ReserveGPUParticleResource(*resource, emitter->ComputeMaxParticleCount());
+	return *resource;
+}
+
+void ParticleSystem::ReserveGPUParticleResource(GPUParticleResource& resource, uint32_t capacity)
+{
+	//足りている場合は何もしない
+	if (resource.capacity >= capacity)
+	{
+		return;
+	}
 
-	//書き込むためのアドレスを取得
-	ParticleForGPU* instancingData_ = static_cast<ParticleForGPU*>(instancingResource_->Map());
-	//単位行列を書き込んでおく
-	for (uint32_t index = 0; index < kMaxInstance; ++index)
+	//前にこのリソースを使ったフレームのGPUの処理は終わっているのでそのまま作り直す
+	for (std::unique_ptr<RWStructuredBuffer>& particles : resource.particles)
 	{
-		instancingData_[index].world = Mathf::MakeIdentity4x4();
-		instancingData_[index].color = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+		if (!particles)
+		{
+			particles = std::make_unique<RWStructuredBuffer>();
+		}
+		particles->Create(capacity, sizeof(GPUParticle));
+	}
+	if (!resource.instances)
+	{
+		resource.instances = std::make_unique<RWStructuredBuffer>();
 	}
-	instancingResource_->Unmap();
+	resource.instances->Create(capacity, sizeof(ParticleForGPU), true);
+	resource.capacity = capacity;
+	resource.sourceIndex = 0;
+	resource.isReset = true;
+}
+
+void ParticleSystem::ReleaseGPUParticleResource(ParticleEmitter* emitter)
+{
+	auto it = gpuParticleResources_.find(emitter);
+	if (it != gpuParticleResources_.end())
+	{
+		freeGPUParticleResources_.push_back(std::move(it->second));
+		gpuParticleResources_.erase(it);
+	}
+}
+
+void ParticleSystem::ReserveInstancingFrame(InstancingFrame& instancingFrame, uint32_t instanceCount)
+{
+	//足りている場合は何もしない
+	if (instancingFrame.capacity >= instanceCount)
+	{
+		return;
+	}
+
+	//最大数まで倍々に増やす
+	uint32_t capacity = instancingFrame.capacity;
+	if (capacity < kInitialInstanceCount)
+	{
+		capacity = kInitialInstanceCount;
+	}
+	while (capacity < instanceCount && capacity < maxInstanceCount_)
+	{
+		capacity *= 2;
+	}
+	capacity = (std::min)(capacity, maxInstanceCount_);
+	if (capacity <= instancingFrame.capacity)
+	{
+		return;
+	}
+
+	//作り直してマップしたままにする(前にこのバッファを使ったフレームのGPUの処理は終わっている)
+	if (!instancingFrame.resource)
+	{
+		instancingFrame.resource = std::make_unique<StructuredBuffer>();
+	}
+	instancingFrame.resource->Create(capacity, sizeof(ParticleForGPU));
+	instancingFrame.data = static_cast<ParticleForGPU*>(instancingFrame.resource->Map());
+	instancingFrame.capacity = capacity;
 }
 
 void ParticleSystem::UpdateInstancingResource(const Camera& camera)
 {
+	//前のフレームのバッファはGPUが読んでいる可能性があるので次のバッファに書き込む
+	frameIndex_ = (frameIndex_ + 1) % kFrameCount;
+
+	//全てのパーティクルの数に合わせてバッファを確保する
+	uint32_t particleCount = 0;
+	for (std::unique_ptr<ParticleEmitter>& emitter : particleEmitters_)
+	{
+		particleCount += emitter->GetParticles().GetCount();
+	}
+	InstancingFrame& instancingFrame = instancingFrames_[frameIndex_];
+	ReserveInstancingFrame(instancingFrame, particleCount);
+
+	//ビルボードの計算は頂点シェーダーで行うので位置、スケール、回転、色だけを書き込む
+	//深度ソートする場合は一度CPU側の配列に書き込んでから並べ替えて書き込む
+	ParticleForGPU* instances = instancingFrame.data;
+	if (isDepthSorted_)
+	{
+		unsortedInstances_.resize(instancingFrame.capacity);
+		instances = unsortedInstances_.data();
+	}
 	numInstance_ = 0;
-	Matrix4x4 billboardMatrix{};
-	if (isBillboard_)
-	{
-		//Matrix4x4 backToFrontMatrix = Mathf::MakeRotateYMatrix(std::numbers::pi_v<float>);
-		//Matrix4x4 cameraMatrix = Mathf::MakeAffineMatrix({ 1.0f,1.0f,1.0f }, camera.rotation_, camera.translation_);
-		//billboardMatrix = backToFrontMatrix * cameraMatrix;
-		//billboardMatrix.m[3][0] = 0.0f;
-		//billboardMatrix.m[3][1] = 0.0f;
-		//billboardMatrix.m[3][2] = 0.0f;
-		billboardMatrix = Mathf::MakeAffineMatrix({ 1.0f,1.0f,1.0f }, camera.rotation_, camera.translation_);;
-		billboardMatrix.m[3][0] = 0.0f;
-		billboardMatrix.m[3][1] = 0.0f;
-		billboardMatrix.m[3][2] = 0.0f;
-	}
-	ParticleForGPU* instancingData = static_cast<ParticleForGPU*>(instancingResource_->Map());
-	for (std::list<std::unique_ptr<ParticleEmitter>>::iterator emitterIterator = particleEmitters_.begin(); emitterIterator != particleEmitters_.end();)
-	{
-		//パーティクルのリストを取得
-		std::list<std::unique_ptr<Particle>>& particles = emitterIterator->get()->GetParticles();
-		for (std::list<std::unique_ptr<Particle>>::iterator particleIterator = particles.begin(); particleIterator != particles.end();)
+	culledEmitterCount_ = 0;
+	culledParticleCount_ = 0;
+	if (isFrustumCulled_)
+	{
+		Frustum frustum = Mathf::MakeFrustum(camera.matView_ * camera.matProjection_);
+		float modelRadius = ComputeModelRadius(model_ ? model_ : defaultModel_.get());
+		for (std::unique_ptr<ParticleEmitter>& emitter : particleEmitters_)
 		{
-			Matrix4x4 worldMatrix{};
-			if (isBillboard_)
-			{
-				Matrix4x4 scaleMatrix = Mathf::MakeScaleMatrix(particleIterator->get()->GetScale());
-				Matrix4x4 translateMatrix = Mathf::MakeTranslateMatrix(particleIterator->get()->GetTranslation());
-				worldMatrix = scaleMatrix * billboardMatrix * translateMatrix;
-			}
-			else
+			const ParticlePool& particles = emitter->GetParticles();
+			if (particles.GetCount() == 0)
 			{
-				if (particleIterator->get()->GetRotation() != Vector3{ 0.0f,0.0f,0.0f })
-				{
-					worldMatrix = Mathf::MakeAffineMatrix(particleIterator->get()->GetScale(), particleIterator->get()->GetRotation(), particleIterator->get()->GetTranslation());
-				}
-				else
-				{
-					worldMatrix = Mathf::MakeAffineMatrix(particleIterator->get()->GetScale(), particleIterator->get()->GetQuaternion(), particleIterator->get()->GetTranslation());
-				}
+				continue;
 			}
 
-			if (numInstance_ < kMaxInstance)
+			//パーティクルの範囲を一番大きいパーティクルの半径だけ広げてエミッターごとに判定する
+			const Vector3& minScale = emitter->GetMinPopScale();
+			const Vector3& maxScale = emitter->GetMaxPopScale();
+			float maxScaleComponent = (std::max)({ std::abs(minScale.x),std::abs(minScale.y),std::abs(minScale.z),std::abs(maxScale.x),std::abs(maxScale.y),std::abs(maxScale.z) });
+			float radius = modelRadius * maxScaleComponent;
+			AABB bounds = emitter->GetBounds();
+			bounds.min = bounds.min - Vector3{ radius,radius,radius };
+			bounds.max = bounds.max + Vector3{ radius,radius,radius };
+			if (!IsCollision(frustum, bounds))
 			{
-				instancingData[numInstance_].world = worldMatrix;
-				instancingData[numInstance_].color = particleIterator->get()->GetColor();
-				numInstance_++;
+				++culledEmitterCount_;
+				culledParticleCount_ += particles.GetCount();
+				continue;
 			}
-			++particleIterator;
+
+			//映っているエミッターはパーティクルごとに判定する
+			uint32_t culledCount = 0;
+			numInstance_ += particles.WriteVisibleInstances(instances + numInstance_, instancingFrame.capacity - numInstance_, frustum, modelRadius, culledCount);
+			culledParticleCount_ += culledCount;
+		}
+	}
+	else
+	{
+		for (std::unique_ptr<ParticleEmitter>& emitter : particleEmitters_)
+		{
+			numInstance_ += emitter->GetParticles().WriteInstances(instances + numInstance_, instancingFrame.capacity - numInstance_);
+		}
+	}
+	droppedInstanceCount_ = particleCount - culledParticleCount_ - numInstance_;
+
+	if (isDepthSorted_)
+	{
+		//ビュー空間のZ座標だけを計算する
+		const Matrix4x4& view = camera.matView_;
+		depthKeys_.resize(numInstance_);
+		for (uint32_t i = 0; i < numInstance_; ++i)
+		{
+			const Vector3& translation = unsortedInstances_[i].translation;
+			float depth = translation.x * view.m[0][2] + translation.y * view.m[1][2] + translation.z * view.m[2][2] + view.m[3][2];
+			depthKeys_[i] = -depth;
+		}
+
+		//奥から手前の順に書き込む
+		const std::vector<uint32_t>& sortedIndices = radixSort_.SortByFloatKey(depthKeys_.data(), numInstance_);
+		for (uint32_t i = 0; i < numInstance_; ++i)
+		{
+			instancingFrame.data[i] = unsortedInstances_[sortedIndices[i]];
 		}
-		++emitterIterator;
 	}
-	instancingResource_->Unmap();
+
+	particleData_->isBillboard = isBillboard_;
+}
+
+float ParticleSystem::ComputeModelRadius(const Model* model)
+{
+	float maxLengthSquared = 0.0f;
+	for (const VertexDataPosUVNormal& vertex : model->modelData_.vertices)
+	{
+		const Vector4& position = vertex.position;
+		maxLengthSquared = (std::max)(maxLengthSquared, position.x * position.x + position.y * position.y + position.z * position.z);
+	}
+	return std::sqrt(maxLengthSquared);
+}
+
+bool ParticleSystem::IsCollision(const Frustum& frustum, const AABB& aabb)
+{
+	for (const Vector4& plane : frustum.planes)
+	{
+		//法線方向に一番遠い頂点が平面の外側なら全体が外側
+		Vector3 farthest = {
+			plane.x >= 0.0f ? aabb.max.x : aabb.min.x,
+			plane.y >= 0.0f ? aabb.max.y : aabb.min.y,
+			plane.z >= 0.0f ? aabb.max.z : aabb.min.z
+		};
+		if (plane.x * farthest.x + plane.y * farthest.y + plane.z * farthest.z + plane.w < 0.0f)
+		{
+			return false;
+		}
+	}
+	return true;
 }
 
 void ParticleSystem::Clear()
 {
+	//GPUのリソースは次のエミッターで使いまわす
+	for (std::unique_ptr<ParticleEmitter>& emitter : particleEmitters_)
+	{
+		ReleaseGPUParticleResource(emitter.get());
+	}
+
 	//エミッターのリストをクリア
 	particleEmitters_.clear();
 }
\ No newline at end of file
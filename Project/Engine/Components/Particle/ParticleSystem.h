@@ -1,19 +1,39 @@
 #pragma once
 #include "Engine/Base/StructuredBuffer.h"
+#include "Engine/Base/RWStructuredBuffer.h"
+#include "Engine/Base/UploadBuffer.h"
 #include "Engine/Base/DescriptorHandle.h"
 #include "Engine/3D/Model/ModelManager.h"
+#include "Engine/Utilities/RadixSort.h"
 #include "ParticleEmitterBuilder.h"
+#include <array>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 class ParticleSystem
 {
 public:
-	//パーティクルの最大数
-	const uint32_t kMaxInstance = 1000;
+	//描画用のバッファを最初に確保する数
+	static const uint32_t kInitialInstanceCount = 1024;
+
+	//描画用のバッファを同時に使うフレームの数
+	static const uint32_t kFrameCount = 2;
 
 	void Initialize();
 
+	//前のフレームからの経過時間で更新する
 	void Update();
 
+	void Update(float deltaTime);
+
+	//寿命が尽きたエミッターを削除する
+	void RemoveDeadEmitters();
+
+	//生きているエミッターを配列の後ろに追加する(GPUで移動させる場合は追加しない)
+	void AppendParticleEmitters(std::vector<ParticleEmitter*>& particleEmitters);
+
 	void Draw(const Camera& camera);
 
 	void Clear();
@@ -32,22 +52,142 @@ public:
 
 	void SetTexture(const std::string& name) { model_ ? model_->SetTexture(name) : defaultModel_->SetTexture(name); };
 
+	const bool GetIsDepthSorted() const { return isDepthSorted_; };
+
+	//半透明のパーティクルを正しく合成するためにカメラから遠い順に描画する
+	void SetIsDepthSorted(bool isDepthSorted) { isDepthSorted_ = isDepthSorted; };
+
+	const uint32_t GetMaxInstanceCount() const { return maxInstanceCount_; };
+
+	//描画用のバッファはこの数まで必要に応じて増やす
+	void SetMaxInstanceCount(uint32_t maxInstanceCount) { maxInstanceCount_ = maxInstanceCount; };
+
+	//直前のDrawで描画した数
+	const uint32_t GetInstanceCount() const { return numInstance_; };
+
+	//直前のDrawで最大数を超えて描画できなかった数
+	const uint32_t GetDroppedInstanceCount() const { return droppedInstanceCount_; };
+
+	const bool GetIsFrustumCulled() const { return isFrustumCulled_; };
+
+	//カメラに映らないエミッターとパーティクルを描画しない
+	void SetIsFrustumCulled(bool isFrustumCulled) { isFrustumCulled_ = isFrustumCulled; };
+
+	//直前のDrawで視錐台の外にあったエミッターの数
+	const uint32_t GetCulledEmitterCount() const { return culledEmitterCount_; };
+
+	//直前のDrawで視錐台の外にあったパーティクルの数(カリングしたエミッターのパーティクルも含む)
+	const uint32_t GetCulledParticleCount() const { return culledParticleCount_; };
+
+	const bool GetIsGPUSimulated() const { return isGPUSimulated_; };
+
+	//生成と移動をコンピュートシェーダーで行い、GPUが書き込んだ数で描画する(エミッターを追加する前に設定すること)
+	//パーティクルはCPUに戻さないので深度ソート、カリング、ParticleManagerの上限と描画数の集計は行わない
+	void SetIsGPUSimulated(bool isGPUSimulated) { isGPUSimulated_ = isGPUSimulated; };
+
 private:
+	//フレームごとの描画用のバッファ(マップしたままにする)
+	struct InstancingFrame
+	{
+		std::unique_ptr<StructuredBuffer> resource;
+		ParticleForGPU* data;
+		uint32_t capacity;
+	};
+
+	//GPUで移動させるエミッターごとのリソース
+	struct GPUParticleResource
+	{
+		//移動前と移動後のパーティクルを毎フレーム入れ替える
+		std::array<std::unique_ptr<RWStructuredBuffer>, 2> particles;
+		std::unique_ptr<RWStructuredBuffer> instances;
+		//[0]が今いる数、[1]が移動後に生き残った数
+		std::unique_ptr<RWStructuredBuffer> counters;
+		std::unique_ptr<RWStructuredBuffer> drawArguments;
+		std::unique_ptr<UploadBuffer> emitterConstBuffer;
+		ConstBuffDataGPUParticleEmitter* emitterData;
+		std::unique_ptr<UploadBuffer> simulationConstBuffer;
+		ConstBuffDataGPUParticleSimulation* simulationData;
+		uint32_t capacity;
+		//移動前のパーティクルが入っているバッファの番号
+		uint32_t sourceIndex;
+		//作り直したり使いまわしたりした後はカウンターと描画の引数を0に戻す
+		bool isReset;
+	};
+
 	void CreateInstancingResource();
 
+	//エミッターごとにコンピュートシェーダーで生成、移動、描画の引数の書き込みを行う
+	void UpdateGPU(float deltaTime);
+
+	void DrawGPU(const Camera& camera);
+
+	//エミッターのリソースを返す(無ければ削除したエミッターのリソースを使いまわすか作る)
+	GPUParticleResource& GetGPUParticleResource(ParticleEmitter* emitter);
+
+	//足りない場合は作り直す(今いるパーティクルは消える)
+	void ReserveGPUParticleResource(GPUParticleResource& resource, uint32_t capacity);
+
+	//エミッターのリソースを使いまわせるようにする
+	void ReleaseGPUParticleResource(ParticleEmitter* emitter);
+
+	void ReserveInstancingFrame(InstancingFrame& instancingFrame, uint32_t instanceCount);
+
 	void UpdateInstancingResource(const Camera& camera);
 
+	//モデルの原点から一番遠い頂点までの距離
+	static float ComputeModelRadius(const Model* model);
+
+	//AABBが視錐台と少しでも重なっていればtrue
+	static bool IsCollision(const Frustum& frustum, const AABB& aabb);
+
 private:
-	std::unique_ptr<StructuredBuffer> instancingResource_ = nullptr;
+	std::array<InstancingFrame, kFrameCount> instancingFrames_{};
+
+	//今フレームに書き込んでいるバッファの番号
+	uint32_t frameIndex_ = 0;
 
 	uint32_t numInstance_ = 0;
 
+	uint32_t droppedInstanceCount_ = 0;
+
+	uint32_t maxInstanceCount_ = 1 << 20;
+
+	uint32_t culledEmitterCount_ = 0;
+
+	uint32_t culledParticleCount_ = 0;
+
+	std::unique_ptr<UploadBuffer> particleConstBuffer_ = nullptr;
+
+	ConstBuffDataParticle* particleData_ = nullptr;
+
+	//深度ソート用に並べ替える前の描画用のデータ
+	std::vector<ParticleForGPU> unsortedInstances_{};
+
+	//ビュー空間の深度の符号を反転したもの(昇順に並べると奥から手前になる)
+	std::vector<float> depthKeys_{};
+
+	RadixSort radixSort_{};
+
 	std::list<std::unique_ptr<ParticleEmitter>> particleEmitters_{};
 
+	std::unordered_map<ParticleEmitter*, std::unique_ptr<GPUParticleResource>> gpuParticleResources_{};
+
+	//削除したエミッターのリソース(新しいエミッターで使いまわしてディスクリプタを節約する)
+	std::vector<std::unique_ptr<GPUParticleResource>> freeGPUParticleResources_{};
+
+	//カウンターと描画の引数を0に戻すためのコピー元
+	std::unique_ptr<UploadBuffer> resetBuffer_ = nullptr;
+
 	std::unique_ptr<Model> defaultModel_ = nullptr;
 
 	Model* model_ = nullptr;
 
 	bool isBillboard_ = true;
+
+	bool isDepthSorted_ = false;
+
+	bool isFrustumCulled_ = true;
+
+	bool isGPUSimulated_ = false;
 };
 
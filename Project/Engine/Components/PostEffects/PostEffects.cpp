@@ -127,13 +127,15 @@ void PostEffects::Draw()
 
 void PostEffects::CreateVertexBuffer()
 {
-	//頂点の作成
-	vertices_[0] = VertexDataPosUV{ {-1.0f,-1.0f,1.0,1.0f},{0.0f,1.0f} };
-	vertices_[1] = VertexDataPosUV{ {-1.0f,1.0f,1.0f,1.0f},{0.0f,0.0f} };
-	vertices_[2] = VertexDataPosUV{ {1.0f,-1.0f,1.0f,1.0f},{1.0f,1.0f} };
-	vertices_[3] = VertexDataPosUV{ {-1.0f,1.0f,1.0f,1.0f},{0.0f,0.0f} };
-	vertices_[4] = VertexDataPosUV{ {1.0f,1.0f,1.0f,1.0f},{1.0f,0.0f} };
-	vertices_[5] = VertexDataPosUV{ {1.0f,-1.0f,1.0f,1.0f},{1.0f,1.0f} };
+	//頂点の作成(コンパイル時に作っておく)
+	static constexpr std::array<VertexDataPosUV, 6> kVertices = {
+		VertexDataPosUV{ {-1.0f,-1.0f,1.0,1.0f},{0.0f,1.0f} },
+		VertexDataPosUV{ {-1.0f,1.0f,1.0f,1.0f},{0.0f,0.0f} },
+		VertexDataPosUV{ {1.0f,-1.0f,1.0f,1.0f},{1.0f,1.0f} },
+		VertexDataPosUV{ {-1.0f,1.0f,1.0f,1.0f},{0.0f,0.0f} },
+		VertexDataPosUV{ {1.0f,1.0f,1.0f,1.0f},{1.0f,0.0f} },
+		VertexDataPosUV{ {1.0f,-1.0f,1.0f,1.0f},{1.0f,1.0f} }
+	};
 
 	//頂点リソースを作る
 	vertexBuffer_ = std::make_unique<UploadBuffer>();
@@ -147,7 +149,7 @@ void PostEffects::CreateVertexBuffer()
 
 	//頂点バッファにデータを書き込む
 	VertexDataPosUV* vertexData = static_cast<VertexDataPosUV*>(vertexBuffer_->Map());
-	std::memcpy(vertexData, vertices_.data(), sizeof(VertexDataPosUV) * vertices_.size());
+	std::memcpy(vertexData, kVertices.data(), sizeof(VertexDataPosUV) * kVertices.size());
 	vertexBuffer_->Unmap();
 }
 
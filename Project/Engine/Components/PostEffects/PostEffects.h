@@ -49,8 +49,6 @@ private:
 
 	std::unique_ptr<UploadBuffer> vertexBuffer_ = nullptr;
 
-	std::array<VertexDataPosUV, 6> vertices_{};
-
 	D3D12_VERTEX_BUFFER_VIEW vertexBufferView_{};
 
 	RootSignature rootSignature_{};
@@ -1,6 +1,7 @@
 #include "GameCore.h"
 #include "Engine/Utilities/GlobalVariables.h"
 #include "Engine/Utilities/RandomGenerator.h"
+#include "Engine/Utilities/ThreadPool.h"
 
 void GameCore::Initialize()
 {
@@ -89,6 +90,9 @@ void GameCore::Finalize()
 	//GraphicsCoreの解放
 	GraphicsCore::Destroy();
 
+	//ThreadPoolの解放
+	ThreadPool::Destroy();
+
 	//ゲームウィンドウを閉じる
 	application_->CloseGameWindow();
 }
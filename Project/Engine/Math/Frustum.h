@@ -0,0 +1,7 @@
+#pragma once
+#include "Vector4.h"
+
+struct Frustum
+{
+	Vector4 planes[6];//左,右,下,上,近,遠の平面。xyzが内向きの単位法線、wが距離。dot(n,p)+w>=0なら内側
+};
@@ -1,28 +1,105 @@
 #include "MathFunction.h"
 #include <cassert>
 
-namespace Mathf
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define MATHFUNCTION_USE_SSE
+#endif
+
+#ifdef MATHFUNCTION_USE_SSE
+namespace
 {
-	float Dot(const Vector3& v1, const Vector3& v2) 
+	//(v[x],v[y],v[z],v[w])
+	template <int x, int y, int z, int w>
+	__m128 Swizzle(__m128 v)
 	{
-		float result{};
-		result = v1.x * v2.x + v1.y * v2.y + v1.z * v2.z;
-		return result;
+		return _mm_shuffle_ps(v, v, _MM_SHUFFLE(w, z, y, x));
 	}
 
+	//(v1[x],v1[y],v2[z],v2[w])
+	template <int x, int y, int z, int w>
+	__m128 Shuffle(__m128 v1, __m128 v2)
+	{
+		return _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(w, z, y, x));
+	}
 
-	float Length(const Vector3& v) 
+	//2x2行列を(m00,m01,m10,m11)の順に1つのレジスタに入れて計算する
+	//a * b
+	__m128 Mat2Mul(__m128 a, __m128 b)
 	{
-		float result{};
-		result = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
-		return result;
+		return _mm_add_ps(_mm_mul_ps(a, Swizzle<0, 3, 0, 3>(b)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+	}
+
+	//adj(a) * b
+	__m128 Mat2AdjMul(__m128 a, __m128 b)
+	{
+		return _mm_sub_ps(_mm_mul_ps(Swizzle<3, 3, 0, 0>(a), b), _mm_mul_ps(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b)));
 	}
 
+	//a * adj(b)
+	__m128 Mat2MulAdj(__m128 a, __m128 b)
+	{
+		return _mm_sub_ps(_mm_mul_ps(a, Swizzle<3, 0, 3, 0>(b)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+	}
 
-	float Lerp(const float& v1, const float& v2, float t)
+	//xyzの外積(wが0なら結果のwも0になる)
+	__m128 Cross3(__m128 v1, __m128 v2)
+	{
+		return _mm_sub_ps(_mm_mul_ps(Swizzle<1, 2, 0, 3>(v1), Swizzle<2, 0, 1, 3>(v2)), _mm_mul_ps(Swizzle<2, 0, 1, 3>(v1), Swizzle<1, 2, 0, 3>(v2)));
+	}
+
+	static_assert(sizeof(Vector3) == sizeof(float) * 3, "Vector3 must be tightly packed");
+
+	//4つのVector3(12個のfloat)を成分ごとのレジスタに並べ替える
+	void LoadVector3x4(const Vector3* v, __m128& x, __m128& y, __m128& z)
+	{
+		__m128 a = _mm_loadu_ps(&v[0].x);//x0,y0,z0,x1
+		__m128 b = _mm_loadu_ps(&v[1].y);//y1,z1,x2,y2
+		__m128 c = _mm_loadu_ps(&v[2].z);//z2,x3,y3,z3
+		x = Shuffle<0, 3, 0, 2>(a, Shuffle<2, 2, 1, 1>(b, c));
+		y = Shuffle<0, 2, 0, 2>(Shuffle<1, 1, 0, 0>(a, b), Shuffle<3, 3, 2, 2>(b, c));
+		z = Shuffle<0, 2, 0, 1>(Shuffle<2, 2, 1, 1>(a, b), Swizzle<0, 3, 0, 3>(c));
+	}
+
+	//LoadVector3x4の逆
+	void StoreVector3x4(Vector3* v, __m128 x, __m128 y, __m128 z)
+	{
+		_mm_storeu_ps(&v[0].x, Shuffle<0, 2, 0, 2>(Shuffle<0, 0, 0, 0>(x, y), Shuffle<0, 0, 1, 1>(z, x)));
+		_mm_storeu_ps(&v[1].y, Shuffle<0, 2, 0, 2>(Shuffle<1, 1, 1, 1>(y, z), Shuffle<2, 2, 2, 2>(x, y)));
+		_mm_storeu_ps(&v[2].z, Shuffle<0, 2, 0, 2>(Shuffle<2, 2, 3, 3>(z, x), Shuffle<3, 3, 3, 3>(y, z)));
+	}
+
+	//成分ごとに並べた4つの座標をTransformと同じ計算順で変換する
+	void TransformPoints4(__m128& x, __m128& y, __m128& z, const Matrix4x4& m)
+	{
+		__m128 resultX = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(m.m[0][0])), _mm_mul_ps(y, _mm_set1_ps(m.m[1][0]))), _mm_mul_ps(z, _mm_set1_ps(m.m[2][0]))), _mm_set1_ps(m.m[3][0]));
+		__m128 resultY = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(m.m[0][1])), _mm_mul_ps(y, _mm_set1_ps(m.m[1][1]))), _mm_mul_ps(z, _mm_set1_ps(m.m[2][1]))), _mm_set1_ps(m.m[3][1]));
+		__m128 resultZ = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(m.m[0][2])), _mm_mul_ps(y, _mm_set1_ps(m.m[1][2]))), _mm_mul_ps(z, _mm_set1_ps(m.m[2][2]))), _mm_set1_ps(m.m[3][2]));
+		__m128 w = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(m.m[0][3])), _mm_mul_ps(y, _mm_set1_ps(m.m[1][3]))), _mm_mul_ps(z, _mm_set1_ps(m.m[2][3]))), _mm_set1_ps(m.m[3][3]));
+		assert(_mm_movemask_ps(_mm_cmpeq_ps(w, _mm_setzero_ps())) == 0);
+		x = _mm_div_ps(resultX, w);
+		y = _mm_div_ps(resultY, w);
+		z = _mm_div_ps(resultZ, w);
+	}
+
+	//(x,y,z,w)の順に入れたクォータニオンの積(Quaternion::operator*と同じ計算順)
+	__m128 QuaternionMul(__m128 lhs, __m128 rhs)
+	{
+		__m128 sum = _mm_mul_ps(Swizzle<3, 3, 3, 3>(lhs), rhs);
+		sum = _mm_add_ps(sum, _mm_mul_ps(Swizzle<0, 0, 0, 0>(lhs), _mm_xor_ps(Swizzle<3, 2, 1, 0>(rhs), _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f))));
+		sum = _mm_add_ps(sum, _mm_mul_ps(Swizzle<1, 1, 1, 1>(lhs), _mm_xor_ps(Swizzle<2, 3, 0, 1>(rhs), _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f))));
+		sum = _mm_add_ps(sum, _mm_mul_ps(Swizzle<2, 2, 2, 2>(lhs), _mm_xor_ps(Swizzle<1, 0, 3, 2>(rhs), _mm_setr_ps(-0.0f, 0.0f, 0.0f, -0.0f))));
+		return sum;
+	}
+}
+#endif
+
+namespace Mathf
+{
+	float Length(const Vector3& v) 
 	{
 		float result{};
-		result = v1 + t * (v2 - v1);
+		result = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
 		return result;
 	}
 
@@ -72,19 +149,23 @@ namespace Mathf
 	}
 
 
-	Vector3 Cross(const Vector3& v1, const Vector3& v2) 
-	{
-		Vector3 result{};
-		result.x = (v1.y * v2.z) - (v1.z * v2.y);
-		result.y = (v1.z * v2.x) - (v1.x * v2.z);
-		result.z = (v1.x * v2.y) - (v1.y * v2.x);
-		return result;
-	}
-
-
 	Vector3 Transform(const Vector3& v, const Matrix4x4& m)
 	{
 		Vector3 result{};
+#ifdef MATHFUNCTION_USE_SSE
+		//行ベクトルなので各行を成分で重み付けして足す(スカラー版と同じ計算順なので結果も同じ)
+		__m128 sum = _mm_mul_ps(_mm_set1_ps(v.x), _mm_loadu_ps(m.m[0]));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(v.y), _mm_loadu_ps(m.m[1])));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(v.z), _mm_loadu_ps(m.m[2])));
+		sum = _mm_add_ps(sum, _mm_loadu_ps(m.m[3]));
+		__m128 w = _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(3, 3, 3, 3));
+		assert(_mm_cvtss_f32(w) != 0.0f);
+		float elements[4];
+		_mm_storeu_ps(elements, _mm_div_ps(sum, w));
+		result.x = elements[0];
+		result.y = elements[1];
+		result.z = elements[2];
+#else
 		result.x = v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0] +
 			1.0f * m.m[3][0];
 		result.y = v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1] +
@@ -97,6 +178,7 @@ namespace Mathf
 		result.x /= w;
 		result.y /= w;
 		result.z /= w;
+#endif
 
 		return result;
 	}
@@ -105,19 +187,20 @@ namespace Mathf
 	Vector3 TransformNormal(const Vector3& vector, const Matrix4x4& matrix)
 	{
 		Vector3 result;
+#ifdef MATHFUNCTION_USE_SSE
+		__m128 sum = _mm_mul_ps(_mm_set1_ps(vector.x), _mm_loadu_ps(matrix.m[0]));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(vector.y), _mm_loadu_ps(matrix.m[1])));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(vector.z), _mm_loadu_ps(matrix.m[2])));
+		float elements[4];
+		_mm_storeu_ps(elements, sum);
+		result.x = elements[0];
+		result.y = elements[1];
+		result.z = elements[2];
+#else
 		result.x = vector.x * matrix.m[0][0] + vector.y * matrix.m[1][0] + vector.z * matrix.m[2][0];
 		result.y = vector.x * matrix.m[0][1] + vector.y * matrix.m[1][1] + vector.z * matrix.m[2][1];
 		result.z = vector.x * matrix.m[0][2] + vector.y * matrix.m[1][2] + vector.z * matrix.m[2][2];
-		return result;
-	}
-
-
-	Vector3 Lerp(const Vector3& v1, const Vector3& v2, float t)
-	{
-		Vector3 result{};
-		result.x = v1.x + t * (v2.x - v1.x);
-		result.y = v1.y + t * (v2.y - v1.y);
-		result.z = v1.z + t * (v2.z - v1.z);
+#endif
 		return result;
 	}
 
@@ -140,12 +223,24 @@ namespace Mathf
 	Vector3 RotateVector(const Vector3& vector, const Quaternion& quaternion)
 	{
 		Vector3 result{};
+#ifdef MATHFUNCTION_USE_SSE
+		//途中のクォータニオンをメモリに書き戻さずにレジスタのまま2回掛ける
+		__m128 q = _mm_loadu_ps(&quaternion.x);
+		__m128 conj = _mm_xor_ps(q, _mm_setr_ps(-0.0f, -0.0f, -0.0f, 0.0f));
+		__m128 rotate = QuaternionMul(QuaternionMul(q, _mm_setr_ps(vector.x, vector.y, vector.z, 0.0f)), conj);
+		alignas(16) float rotated[4];
+		_mm_store_ps(rotated, rotate);
+		result.x = rotated[0];
+		result.y = rotated[1];
+		result.z = rotated[2];
+#else
 		Quaternion vectorToQuaternion = { vector.x,vector.y,vector.z,0.0f };
 		Quaternion conj = Conjugate(quaternion);
 		Quaternion rotate = quaternion * vectorToQuaternion * conj;
 		result.x = rotate.x;
 		result.y = rotate.y;
 		result.z = rotate.z;
+#endif
 		return result;
 	}
 
@@ -153,6 +248,52 @@ namespace Mathf
 	Matrix4x4 Inverse(const Matrix4x4& m) 
 	{
 		Matrix4x4 result{};
+#ifdef MATHFUNCTION_USE_SSE
+		//2x2のブロック行列に分けて逆行列を求める
+		__m128 row0 = _mm_loadu_ps(m.m[0]);
+		__m128 row1 = _mm_loadu_ps(m.m[1]);
+		__m128 row2 = _mm_loadu_ps(m.m[2]);
+		__m128 row3 = _mm_loadu_ps(m.m[3]);
+		__m128 a = _mm_movelh_ps(row0, row1);
+		__m128 b = _mm_movehl_ps(row1, row0);
+		__m128 c = _mm_movelh_ps(row2, row3);
+		__m128 d = _mm_movehl_ps(row3, row2);
+
+		//各ブロックの行列式(|A|,|B|,|C|,|D|)
+		__m128 determinantSub = _mm_sub_ps(
+			_mm_mul_ps(Shuffle<0, 2, 0, 2>(row0, row2), Shuffle<1, 3, 1, 3>(row1, row3)),
+			_mm_mul_ps(Shuffle<1, 3, 1, 3>(row0, row2), Shuffle<0, 2, 0, 2>(row1, row3)));
+		__m128 determinantA = Swizzle<0, 0, 0, 0>(determinantSub);
+		__m128 determinantB = Swizzle<1, 1, 1, 1>(determinantSub);
+		__m128 determinantC = Swizzle<2, 2, 2, 2>(determinantSub);
+		__m128 determinantD = Swizzle<3, 3, 3, 3>(determinantSub);
+
+		__m128 dc = Mat2AdjMul(d, c);
+		__m128 ab = Mat2AdjMul(a, b);
+		__m128 x = _mm_sub_ps(_mm_mul_ps(determinantD, a), Mat2Mul(b, dc));
+		__m128 w = _mm_sub_ps(_mm_mul_ps(determinantA, d), Mat2Mul(c, ab));
+		__m128 y = _mm_sub_ps(_mm_mul_ps(determinantB, c), Mat2MulAdj(d, ab));
+		__m128 z = _mm_sub_ps(_mm_mul_ps(determinantC, b), Mat2MulAdj(a, dc));
+
+		//|M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+		__m128 trace = _mm_mul_ps(ab, Swizzle<0, 2, 1, 3>(dc));
+		trace = _mm_add_ps(trace, Swizzle<2, 3, 0, 1>(trace));
+		trace = _mm_add_ps(trace, Swizzle<1, 0, 3, 2>(trace));
+		__m128 determinant = _mm_add_ps(_mm_mul_ps(determinantA, determinantD), _mm_mul_ps(determinantB, determinantC));
+		determinant = _mm_sub_ps(determinant, trace);
+		assert(_mm_cvtss_f32(determinant) != 0.0f);
+
+		//余因子の符号を掛けて行列式で割る
+		__m128 determinantRecp = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+		x = _mm_mul_ps(x, determinantRecp);
+		y = _mm_mul_ps(y, determinantRecp);
+		z = _mm_mul_ps(z, determinantRecp);
+		w = _mm_mul_ps(w, determinantRecp);
+		_mm_storeu_ps(result.m[0], Shuffle<3, 1, 3, 1>(x, y));
+		_mm_storeu_ps(result.m[1], Shuffle<2, 0, 2, 0>(x, y));
+		_mm_storeu_ps(result.m[2], Shuffle<3, 1, 3, 1>(z, w));
+		_mm_storeu_ps(result.m[3], Shuffle<2, 0, 2, 0>(z, w));
+#else
 		float determinant = m.m[0][0] * m.m[1][1] * m.m[2][2] * m.m[3][3] +
 			m.m[0][0] * m.m[1][2] * m.m[2][3] * m.m[3][1] +
 			m.m[0][0] * m.m[1][3] * m.m[2][1] * m.m[3][2] -
@@ -202,122 +343,150 @@ namespace Mathf
 		result.m[2][2] = (m.m[0][0] * m.m[1][1] * m.m[3][3] + m.m[0][1] * m.m[1][3] * m.m[3][0] + m.m[0][3] * m.m[1][0] * m.m[3][1] - m.m[0][3] * m.m[1][1] * m.m[3][0] - m.m[0][1] * m.m[1][0] * m.m[3][3] - m.m[0][0] * m.m[1][3] * m.m[3][1]) * determinantRecp;
 		result.m[2][3] = (-m.m[0][0] * m.m[1][1] * m.m[2][3] - m.m[0][1] * m.m[1][3] * m.m[2][0] - m.m[0][3] * m.m[1][0] * m.m[2][1] + m.m[0][3] * m.m[1][1] * m.m[2][0] + m.m[0][1] * m.m[1][0] * m.m[2][3] + m.m[0][0] * m.m[1][3] * m.m[2][1]) * determinantRecp;
 
-		result.m[3][0] = (-m.m[1][0] * m.m[2][1] * m.m[3][2] - m.m[1][1] * m.m[2][2] * m.m[3][0] - m.m[1][2] * m.m[2][0] * m.m[3][1] + m.m[1][2] * m.m[3][2] * m.m[3][0] + m.m[1][1] * m.m[2][0] * m.m[3][2] + m.m[1][0] * m.m[2][2] * m.m[3][1]) * determinantRecp;
+		result.m[3][0] = (-m.m[1][0] * m.m[2][1] * m.m[3][2] - m.m[1][1] * m.m[2][2] * m.m[3][0] - m.m[1][2] * m.m[2][0] * m.m[3][1] + m.m[1][2] * m.m[2][1] * m.m[3][0] + m.m[1][1] * m.m[2][0] * m.m[3][2] + m.m[1][0] * m.m[2][2] * m.m[3][1]) * determinantRecp;
 		result.m[3][1] = (m.m[0][0] * m.m[2][1] * m.m[3][2] + m.m[0][1] * m.m[2][2] * m.m[3][0] + m.m[0][2] * m.m[2][0] * m.m[3][1] - m.m[0][2] * m.m[2][1] * m.m[3][0] - m.m[0][1] * m.m[2][0] * m.m[3][2] - m.m[0][0] * m.m[2][2] * m.m[3][1]) * determinantRecp;
 		result.m[3][2] = (-m.m[0][0] * m.m[1][1] * m.m[3][2] - m.m[0][1] * m.m[1][2] * m.m[3][0] - m.m[0][2] * m.m[1][0] * m.m[3][1] + m.m[0][2] * m.m[1][1] * m.m[3][0] + m.m[0][1] * m.m[1][0] * m.m[3][2] + m.m[0][0] * m.m[1][2] * m.m[3][1]) * determinantRecp;
 		result.m[3][3] = (m.m[0][0] * m.m[1][1] * m.m[2][2] + m.m[0][1] * m.m[1][2] * m.m[2][0] + m.m[0][2] * m.m[1][0] * m.m[2][1] - m.m[0][2] * m.m[1][1] * m.m[2][0] - m.m[0][1] * m.m[1][0] * m.m[2][2] - m.m[0][0] * m.m[1][2] * m.m[2][1]) * determinantRecp;
+#endif
 
 		return result;
 	}
 
 
-	Matrix4x4 Transpose(const Matrix4x4& m) 
+	Matrix4x4 InverseAffine(const Matrix4x4& m)
 	{
-		Matrix4x4 result{};
-		result.m[0][0] = m.m[0][0];
-		result.m[0][1] = m.m[1][0];
-		result.m[0][2] = m.m[2][0];
-		result.m[0][3] = m.m[3][0];
-
-		result.m[1][0] = m.m[0][1];
-		result.m[1][1] = m.m[1][1];
-		result.m[1][2] = m.m[2][1];
-		result.m[1][3] = m.m[3][1];
-
-		result.m[2][0] = m.m[0][2];
-		result.m[2][1] = m.m[1][2];
-		result.m[2][2] = m.m[2][2];
-		result.m[2][3] = m.m[3][2];
-
-		result.m[3][0] = m.m[0][3];
-		result.m[3][1] = m.m[1][3];
-		result.m[3][2] = m.m[2][3];
-		result.m[3][3] = m.m[3][3];
-
-		return result;
-	}
-
+		Matrix4x4 result;
+#ifdef MATHFUNCTION_USE_SSE
+		//3x3部分の余因子行列の行は2行ずつの外積になる(4列目は0なので外積のwも0)
+		__m128 row0 = _mm_loadu_ps(m.m[0]);
+		__m128 row1 = _mm_loadu_ps(m.m[1]);
+		__m128 row2 = _mm_loadu_ps(m.m[2]);
+		__m128 cofactor0 = Cross3(row1, row2);
+		__m128 cofactor1 = Cross3(row2, row0);
+		__m128 cofactor2 = Cross3(row0, row1);
+		__m128 cofactor3 = _mm_setzero_ps();
+		__m128 product = _mm_mul_ps(row0, cofactor0);
+		__m128 determinant = _mm_add_ps(_mm_add_ps(Swizzle<0, 0, 0, 0>(product), Swizzle<1, 1, 1, 1>(product)), Swizzle<2, 2, 2, 2>(product));
+		assert(_mm_cvtss_f32(determinant) != 0.0f);
+		__m128 inverseDeterminant = _mm_div_ps(_mm_set1_ps(1.0f), determinant);
+
+		//3x3部分は余因子行列の転置を行列式で割ったもの、平行移動は-translation*3x3部分の逆行列
+		_MM_TRANSPOSE4_PS(cofactor0, cofactor1, cofactor2, cofactor3);
+		__m128 column0 = _mm_mul_ps(cofactor0, inverseDeterminant);
+		__m128 column1 = _mm_mul_ps(cofactor1, inverseDeterminant);
+		__m128 column2 = _mm_mul_ps(cofactor2, inverseDeterminant);
+		__m128 translation = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m.m[3][0]), column0), _mm_mul_ps(_mm_set1_ps(m.m[3][1]), column1)), _mm_mul_ps(_mm_set1_ps(m.m[3][2]), column2));
+		_mm_storeu_ps(result.m[0], column0);
+		_mm_storeu_ps(result.m[1], column1);
+		_mm_storeu_ps(result.m[2], column2);
+		_mm_storeu_ps(result.m[3], _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), translation));
+#else
+		//3x3部分の余因子行列の行は2行ずつの外積になる
+		Vector3 row0 = { m.m[0][0],m.m[0][1],m.m[0][2] };
+		Vector3 row1 = { m.m[1][0],m.m[1][1],m.m[1][2] };
+		Vector3 row2 = { m.m[2][0],m.m[2][1],m.m[2][2] };
+		Vector3 translation = { m.m[3][0],m.m[3][1],m.m[3][2] };
+		Vector3 cofactor0 = Cross(row1, row2);
+		Vector3 cofactor1 = Cross(row2, row0);
+		Vector3 cofactor2 = Cross(row0, row1);
+		float determinant = Dot(row0, cofactor0);
+		assert(determinant != 0.0f);
+		float inverseDeterminant = 1.0f / determinant;
 
-	Matrix4x4 MakeIdentity4x4() 
-	{
-		Matrix4x4 result{};
-		result.m[0][0] = 1.0f;
-		result.m[0][1] = 0.0f;
-		result.m[0][2] = 0.0f;
+		//3x3部分は余因子行列の転置を行列式で割ったもの、平行移動は-translation*3x3部分の逆行列
+		result.m[0][0] = cofactor0.x * inverseDeterminant;
+		result.m[0][1] = cofactor1.x * inverseDeterminant;
+		result.m[0][2] = cofactor2.x * inverseDeterminant;
 		result.m[0][3] = 0.0f;
 
-		result.m[1][0] = 0.0f;
-		result.m[1][1] = 1.0f;
-		result.m[1][2] = 0.0f;
+		result.m[1][0] = cofactor0.y * inverseDeterminant;
+		result.m[1][1] = cofactor1.y * inverseDeterminant;
+		result.m[1][2] = cofactor2.y * inverseDeterminant;
 		result.m[1][3] = 0.0f;
 
-		result.m[2][0] = 0.0f;
-		result.m[2][1] = 0.0f;
-		result.m[2][2] = 1.0f;
+		result.m[2][0] = cofactor0.z * inverseDeterminant;
+		result.m[2][1] = cofactor1.z * inverseDeterminant;
+		result.m[2][2] = cofactor2.z * inverseDeterminant;
 		result.m[2][3] = 0.0f;
 
-		result.m[3][0] = 0.0f;
-		result.m[3][1] = 0.0f;
-		result.m[3][2] = 0.0f;
+		result.m[3][0] = -Dot(translation, cofactor0) * inverseDeterminant;
+		result.m[3][1] = -Dot(translation, cofactor1) * inverseDeterminant;
+		result.m[3][2] = -Dot(translation, cofactor2) * inverseDeterminant;
 		result.m[3][3] = 1.0f;
-
+#endif
 		return result;
 	}
 
 
-	Matrix4x4 MakeScaleMatrix(const Vector3& scale) 
+	Matrix4x4 InverseAffine(const Matrix4x4& m, const Vector3& scale)
 	{
-		Matrix4x4 result;
-		result.m[0][0] = scale.x;
-		result.m[0][1] = 0;
-		result.m[0][2] = 0;
-		result.m[0][3] = 0;
-
-		result.m[1][0] = 0;
-		result.m[1][1] = scale.y;
-		result.m[1][2] = 0;
-		result.m[1][3] = 0;
-
-		result.m[2][0] = 0;
-		result.m[2][1] = 0;
-		result.m[2][2] = scale.z;
-		result.m[2][3] = 0;
+		//i行目は拡縮のi成分*回転のi行目なので、拡縮の2乗で割ると回転のi行目/拡縮のi成分(逆行列のi列目)になる
+		float inverseScaleSquared[3]{};
+		if (scale.x == scale.y && scale.y == scale.z)
+		{
+			//均等な拡縮なら除算は1回で済む
+			assert(scale.x != 0.0f);
+			inverseScaleSquared[0] = 1.0f / (scale.x * scale.x);
+			inverseScaleSquared[1] = inverseScaleSquared[0];
+			inverseScaleSquared[2] = inverseScaleSquared[0];
+		}
+		else
+		{
+			assert(scale.x != 0.0f && scale.y != 0.0f && scale.z != 0.0f);
+			inverseScaleSquared[0] = 1.0f / (scale.x * scale.x);
+			inverseScaleSquared[1] = 1.0f / (scale.y * scale.y);
+			inverseScaleSquared[2] = 1.0f / (scale.z * scale.z);
+		}
 
-		result.m[3][0] = 0;
-		result.m[3][1] = 0;
-		result.m[3][2] = 0;
+		Matrix4x4 result;
+#ifdef MATHFUNCTION_USE_SSE
+		//3x3部分を転置して列ごとに拡縮の2乗で割る(4列目は0なので転置後のwも0)
+		__m128 row0 = _mm_loadu_ps(m.m[0]);
+		__m128 row1 = _mm_loadu_ps(m.m[1]);
+		__m128 row2 = _mm_loadu_ps(m.m[2]);
+		__m128 row3 = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+		__m128 inverse = _mm_setr_ps(inverseScaleSquared[0], inverseScaleSquared[1], inverseScaleSquared[2], 0.0f);
+		__m128 column0 = _mm_mul_ps(row0, inverse);
+		__m128 column1 = _mm_mul_ps(row1, inverse);
+		__m128 column2 = _mm_mul_ps(row2, inverse);
+		__m128 translation = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m.m[3][0]), column0), _mm_mul_ps(_mm_set1_ps(m.m[3][1]), column1)), _mm_mul_ps(_mm_set1_ps(m.m[3][2]), column2));
+		_mm_storeu_ps(result.m[0], column0);
+		_mm_storeu_ps(result.m[1], column1);
+		_mm_storeu_ps(result.m[2], column2);
+		_mm_storeu_ps(result.m[3], _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), translation));
+#else
+		//平行移動は-translation*3x3部分の逆行列
+		Vector3 translation = { m.m[3][0],m.m[3][1],m.m[3][2] };
+		for (int i = 0; i < 3; ++i)
+		{
+			Vector3 row = { m.m[i][0],m.m[i][1],m.m[i][2] };
+			result.m[0][i] = row.x * inverseScaleSquared[i];
+			result.m[1][i] = row.y * inverseScaleSquared[i];
+			result.m[2][i] = row.z * inverseScaleSquared[i];
+			result.m[3][i] = -Dot(translation, row) * inverseScaleSquared[i];
+		}
+		result.m[0][3] = 0.0f;
+		result.m[1][3] = 0.0f;
+		result.m[2][3] = 0.0f;
 		result.m[3][3] = 1.0f;
-
+#endif
 		return result;
 	}
 
 
-	Matrix4x4 MakeTranslateMatrix(const Vector3& translate) 
+	Matrix4x4 InverseTransposeAffine(const Matrix4x4& m)
 	{
-		Matrix4x4 result;
-		result.m[0][0] = 1.0f;
-		result.m[0][1] = 0;
-		result.m[0][2] = 0;
-		result.m[0][3] = 0;
-
-		result.m[1][0] = 0;
-		result.m[1][1] = 1.0f;
-		result.m[1][2] = 0;
-		result.m[1][3] = 0;
-
-		result.m[2][0] = 0;
-		result.m[2][1] = 0;
-		result.m[2][2] = 1.0f;
-		result.m[2][3] = 0;
+		return Transpose(InverseAffine(m));
+	}
 
-		result.m[3][0] = translate.x;
-		result.m[3][1] = translate.y;
-		result.m[3][2] = translate.z;
-		result.m[3][3] = 1.0f;
 
-		return result;
+	Matrix4x4 InverseTransposeAffine(const Matrix4x4& m, const Vector3& scale)
+	{
+		return Transpose(InverseAffine(m, scale));
 	}
 
+
 	Matrix4x4 MakeRotateXMatrix(float radian)
 	{
 		Matrix4x4 result{};
@@ -401,26 +570,7 @@ namespace Mathf
 
 	Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate) 
 	{
-		Matrix4x4 result{};
-		Matrix4x4 scaleMatrix = MakeScaleMatrix(scale);
-		Matrix4x4 rotateXMatrix = MakeRotateXMatrix(rotate.x);
-		Matrix4x4 rotateYMatrix = MakeRotateYMatrix(rotate.y);
-		Matrix4x4 rotateZMatrix = MakeRotateZMatrix(rotate.z);
-		Matrix4x4 rotateXYZMatrix = rotateXMatrix * rotateYMatrix * rotateZMatrix;
-		Matrix4x4 translateMatrix = MakeTranslateMatrix(translate);
-		result = scaleMatrix * rotateXYZMatrix * translateMatrix;
-		return result;
-	}
-
-
-	Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Quaternion& quaternion, const Vector3& translation)
-	{
-		Matrix4x4 result{};
-		Matrix4x4 scaleMatrix = MakeScaleMatrix(scale);
-		Matrix4x4 rotateMatrix = MakeRotateMatrix(quaternion);
-		Matrix4x4 translateMatrix = MakeTranslateMatrix(translation);
-		result = scaleMatrix * rotateMatrix * translateMatrix;
-		return result;
+		return MakeAffineMatrix(scale, MakeRotateQuaternion(rotate), translate);
 	}
 
 
@@ -451,57 +601,37 @@ namespace Mathf
 	}
 
 
-	Matrix4x4 MakeOrthographicMatrix(float left, float top, float right, float bottom, float nearClip, float farClip)
+	Frustum MakeFrustum(const Matrix4x4& viewProjection)
 	{
-		assert(left != right);
-		assert(top != bottom);
-		Matrix4x4 result;
-		result.m[0][0] = 2.0f / (right - left);
-		result.m[0][1] = 0.0f;
-		result.m[0][2] = 0.0f;
-		result.m[0][3] = 0.0f;
-
-		result.m[1][0] = 0.0f;
-		result.m[1][1] = 2.0f / (top - bottom);
-		result.m[1][2] = 0.0f;
-		result.m[1][3] = 0.0f;
-
-		result.m[2][0] = 0.0f;
-		result.m[2][1] = 0.0f;
-		result.m[2][2] = 1.0f / (farClip - nearClip);
-		result.m[2][3] = 0.0f;
-
-		result.m[3][0] = (left + right) / (left - right);
-		result.m[3][1] = (top + bottom) / (bottom - top);
-		result.m[3][2] = nearClip / (nearClip - farClip);
-		result.m[3][3] = 1.0f;
-
-		return result;
-	}
-
-
-	Matrix4x4 MakeViewportMatrix(float left, float top, float width, float height, float minDepth, float maxDepth) 
-	{
-		Matrix4x4 result{};
-		result.m[0][0] = width / 2;
-		result.m[0][1] = 0;
-		result.m[0][2] = 0;
-		result.m[0][3] = 0;
-
-		result.m[1][0] = 0;
-		result.m[1][1] = -height / 2;
-		result.m[1][2] = 0;
-		result.m[1][3] = 0;
-
-		result.m[2][0] = 0;
-		result.m[2][1] = 0;
-		result.m[2][2] = maxDepth - minDepth;
-		result.m[2][3] = 0;
+		//行ベクトルなのでクリップ座標の各成分は行列の列との内積になる
+		const Matrix4x4& m = viewProjection;
+		Vector4 column[4]{};
+		for (int i = 0; i < 4; ++i)
+		{
+			column[i] = { m.m[0][i],m.m[1][i],m.m[2][i],m.m[3][i] };
+		}
 
-		result.m[3][0] = left + (width / 2);
-		result.m[3][1] = top + (height / 2);
-		result.m[3][2] = minDepth;
-		result.m[3][3] = 1;
+		//-w<=x<=w,-w<=y<=w,0<=z<=w
+		Frustum result{};
+		result.planes[0] = column[3] + column[0];
+		result.planes[1] = column[3] - column[0];
+		result.planes[2] = column[3] + column[1];
+		result.planes[3] = column[3] - column[1];
+		result.planes[4] = column[2];
+		result.planes[5] = column[3] - column[2];
+
+		//距離で比較できるように正規化する
+		for (Vector4& plane : result.planes)
+		{
+			float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+			if (length != 0.0f)
+			{
+				plane.x /= length;
+				plane.y /= length;
+				plane.z /= length;
+				plane.w /= length;
+			}
+		}
 
 		return result;
 	}
@@ -570,51 +700,6 @@ namespace Mathf
 	}
 
 
-	Matrix4x4 MakeRotateMatrix(const Quaternion& quaternion) 
-	{
-		Matrix4x4 result{};
-		result.m[0][0] = quaternion.w * quaternion.w + quaternion.x * quaternion.x - quaternion.y * quaternion.y - quaternion.z * quaternion.z;
-		result.m[0][1] = 2.0f * (quaternion.x * quaternion.y + quaternion.w * quaternion.z);
-		result.m[0][2] = 2.0f * (quaternion.x * quaternion.z - quaternion.w * quaternion.y);
-		result.m[0][3] = 0.0f;
-		result.m[1][0] = 2.0f * (quaternion.x * quaternion.y - quaternion.w * quaternion.z);
-		result.m[1][1] = quaternion.w * quaternion.w - quaternion.x * quaternion.x + quaternion.y * quaternion.y - quaternion.z * quaternion.z;
-		result.m[1][2] = 2.0f * (quaternion.y * quaternion.z + quaternion.w * quaternion.x);
-		result.m[1][3] = 0.0f;
-		result.m[2][0] = 2.0f * (quaternion.x * quaternion.z + quaternion.w * quaternion.y);
-		result.m[2][1] = 2.0f * (quaternion.y * quaternion.z - quaternion.w * quaternion.x);
-		result.m[2][2] = quaternion.w * quaternion.w - quaternion.x * quaternion.x - quaternion.y * quaternion.y + quaternion.z * quaternion.z;
-		result.m[2][3] = 0.0f;
-		result.m[3][0] = 0.0f;
-		result.m[3][1] = 0.0f;
-		result.m[3][2] = 0.0f;
-		result.m[3][3] = 1.0f;
-		return result;
-	}
-
-
-	Quaternion IdentityQuaternion() 
-	{
-		Quaternion result{};
-		result.x = 0.0f;
-		result.y = 0.0f;
-		result.z = 0.0f;
-		result.w = 1.0f;
-		return result;
-	}
-
-
-	Quaternion Conjugate(const Quaternion& quaternion)
-	{
-		Quaternion result{};
-		result.x = quaternion.x * -1.0f;
-		result.y = quaternion.y * -1.0f;
-		result.z = quaternion.z * -1.0f;
-		result.w = quaternion.w;
-		return result;
-	}
-
-
 	Quaternion Normalize(const Quaternion& quaternion)
 	{
 		Quaternion result{};
@@ -660,6 +745,16 @@ namespace Mathf
 	}
 
 
+	Quaternion MakeRotateQuaternion(const Vector3& rotate)
+	{
+		Quaternion rotateX = MakeRotateAxisAngleQuaternion({ 1.0f,0.0f,0.0f }, rotate.x);
+		Quaternion rotateY = MakeRotateAxisAngleQuaternion({ 0.0f,1.0f,0.0f }, rotate.y);
+		Quaternion rotateZ = MakeRotateAxisAngleQuaternion({ 0.0f,0.0f,1.0f }, rotate.z);
+		Quaternion result = rotateZ * rotateY * rotateX;
+		return result;
+	}
+
+
 	Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t) 
 	{
 		Quaternion result{};
@@ -688,4 +783,266 @@ namespace Mathf
 		result.w = scale0 * localQ0.w + scale1 * localQ1.w;
 		return result;
 	}
+
+
+
+	Quaternion Nlerp(const Quaternion& q0, const Quaternion& q1, float t)
+	{
+		//遠回りしないように内積が負なら片方を反転する
+		Quaternion localQ0 = q0;
+		float dot = q0.x * q1.x + q0.y * q1.y + q0.z * q1.z + q0.w * q1.w;
+		if (dot < 0.0f)
+		{
+			localQ0 = { -q0.x,-q0.y,-q0.z,-q0.w };
+		}
+		Quaternion result{};
+		result.x = (1.0f - t) * localQ0.x + t * q1.x;
+		result.y = (1.0f - t) * localQ0.y + t * q1.y;
+		result.z = (1.0f - t) * localQ0.z + t * q1.z;
+		result.w = (1.0f - t) * localQ0.w + t * q1.w;
+		return Normalize(result);
+	}
+
+	void TransformPoints(std::span<const Vector3> points, const Matrix4x4& m, std::span<Vector3> output)
+	{
+		assert(output.size() >= points.size());
+		size_t index = 0;
+#ifdef MATHFUNCTION_USE_SSE
+		for (; index + 4 <= points.size(); index += 4)
+		{
+			__m128 x, y, z;
+			LoadVector3x4(&points[index], x, y, z);
+			TransformPoints4(x, y, z, m);
+			StoreVector3x4(&output[index], x, y, z);
+		}
+#endif
+		for (; index < points.size(); ++index)
+		{
+			output[index] = Transform(points[index], m);
+		}
+	}
+
+
+	void TransformPoints(std::span<const float> x, std::span<const float> y, std::span<const float> z, const Matrix4x4& m, std::span<float> outputX, std::span<float> outputY, std::span<float> outputZ)
+	{
+		assert(y.size() == x.size() && z.size() == x.size());
+		assert(outputX.size() >= x.size() && outputY.size() >= x.size() && outputZ.size() >= x.size());
+		size_t index = 0;
+#ifdef MATHFUNCTION_USE_SSE
+		for (; index + 4 <= x.size(); index += 4)
+		{
+			__m128 vx = _mm_loadu_ps(&x[index]);
+			__m128 vy = _mm_loadu_ps(&y[index]);
+			__m128 vz = _mm_loadu_ps(&z[index]);
+			TransformPoints4(vx, vy, vz, m);
+			_mm_storeu_ps(&outputX[index], vx);
+			_mm_storeu_ps(&outputY[index], vy);
+			_mm_storeu_ps(&outputZ[index], vz);
+		}
+#endif
+		for (; index < x.size(); ++index)
+		{
+			Vector3 result = Transform(Vector3{ x[index],y[index],z[index] }, m);
+			outputX[index] = result.x;
+			outputY[index] = result.y;
+			outputZ[index] = result.z;
+		}
+	}
+
+
+	void TransformNormals(std::span<const Vector3> vectors, const Matrix4x4& m, std::span<Vector3> output)
+	{
+		assert(output.size() >= vectors.size());
+		size_t index = 0;
+#ifdef MATHFUNCTION_USE_SSE
+		__m128 m00 = _mm_set1_ps(m.m[0][0]), m01 = _mm_set1_ps(m.m[0][1]), m02 = _mm_set1_ps(m.m[0][2]);
+		__m128 m10 = _mm_set1_ps(m.m[1][0]), m11 = _mm_set1_ps(m.m[1][1]), m12 = _mm_set1_ps(m.m[1][2]);
+		__m128 m20 = _mm_set1_ps(m.m[2][0]), m21 = _mm_set1_ps(m.m[2][1]), m22 = _mm_set1_ps(m.m[2][2]);
+		for (; index + 4 <= vectors.size(); index += 4)
+		{
+			__m128 x, y, z;
+			LoadVector3x4(&vectors[index], x, y, z);
+			__m128 resultX = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m00), _mm_mul_ps(y, m10)), _mm_mul_ps(z, m20));
+			__m128 resultY = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m01), _mm_mul_ps(y, m11)), _mm_mul_ps(z, m21));
+			__m128 resultZ = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m02), _mm_mul_ps(y, m12)), _mm_mul_ps(z, m22));
+			StoreVector3x4(&output[index], resultX, resultY, resultZ);
+		}
+#endif
+		for (; index < vectors.size(); ++index)
+		{
+			output[index] = TransformNormal(vectors[index], m);
+		}
+	}
+
+
+	void MultiplyMatrices(std::span<const Matrix4x4> lhs, const Matrix4x4& rhs, std::span<Matrix4x4> output)
+	{
+		assert(output.size() >= lhs.size());
+#ifdef MATHFUNCTION_USE_SSE
+		//右の行列はループの外で読み込んでおく(Matrix4x4::operator*と同じ計算順)
+		__m128 row0 = _mm_loadu_ps(rhs.m[0]);
+		__m128 row1 = _mm_loadu_ps(rhs.m[1]);
+		__m128 row2 = _mm_loadu_ps(rhs.m[2]);
+		__m128 row3 = _mm_loadu_ps(rhs.m[3]);
+		for (size_t index = 0; index < lhs.size(); ++index)
+		{
+			const Matrix4x4& m = lhs[index];
+			for (int i = 0; i < 4; ++i)
+			{
+				__m128 sum = _mm_mul_ps(_mm_set1_ps(m.m[i][0]), row0);
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(m.m[i][1]), row1));
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(m.m[i][2]), row2));
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(m.m[i][3]), row3));
+				_mm_storeu_ps(output[index].m[i], sum);
+			}
+		}
+#else
+		for (size_t index = 0; index < lhs.size(); ++index)
+		{
+			output[index] = lhs[index] * rhs;
+		}
+#endif
+	}
+
+
+	void MultiplyMatrices(std::span<const Matrix4x4> lhs, std::span<const Matrix4x4> rhs, std::span<Matrix4x4> output)
+	{
+		assert(rhs.size() == lhs.size() && output.size() >= lhs.size());
+		for (size_t index = 0; index < lhs.size(); ++index)
+		{
+			output[index] = lhs[index] * rhs[index];
+		}
+	}
+
+
+	void MakeAffineMatrices(std::span<const Vector3> scales, std::span<const Quaternion> quaternions, std::span<const Vector3> translations, std::span<Matrix4x4> output)
+	{
+		assert(quaternions.size() == scales.size() && translations.size() == scales.size() && output.size() >= scales.size());
+		size_t index = 0;
+#ifdef MATHFUNCTION_USE_SSE
+		//4つずつ成分ごとに並べて、MakeRotateMatrixと同じ計算順で回転行列を求めて行ごとに拡縮を掛ける
+		__m128 two = _mm_set1_ps(2.0f);
+		for (; index + 4 <= scales.size(); index += 4)
+		{
+			__m128 x = _mm_loadu_ps(&quaternions[index].x);
+			__m128 y = _mm_loadu_ps(&quaternions[index + 1].x);
+			__m128 z = _mm_loadu_ps(&quaternions[index + 2].x);
+			__m128 w = _mm_loadu_ps(&quaternions[index + 3].x);
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+			__m128 scaleX, scaleY, scaleZ;
+			LoadVector3x4(&scales[index], scaleX, scaleY, scaleZ);
+			__m128 translationX, translationY, translationZ;
+			LoadVector3x4(&translations[index], translationX, translationY, translationZ);
+
+			__m128 ww = _mm_mul_ps(w, w), xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+			__m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+			__m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+			__m128 m00 = _mm_mul_ps(scaleX, _mm_sub_ps(_mm_sub_ps(_mm_add_ps(ww, xx), yy), zz));
+			__m128 m01 = _mm_mul_ps(scaleX, _mm_mul_ps(two, _mm_add_ps(xy, wz)));
+			__m128 m02 = _mm_mul_ps(scaleX, _mm_mul_ps(two, _mm_sub_ps(xz, wy)));
+			__m128 m03 = _mm_setzero_ps();
+			__m128 m10 = _mm_mul_ps(scaleY, _mm_mul_ps(two, _mm_sub_ps(xy, wz)));
+			__m128 m11 = _mm_mul_ps(scaleY, _mm_sub_ps(_mm_add_ps(_mm_sub_ps(ww, xx), yy), zz));
+			__m128 m12 = _mm_mul_ps(scaleY, _mm_mul_ps(two, _mm_add_ps(yz, wx)));
+			__m128 m13 = _mm_setzero_ps();
+			__m128 m20 = _mm_mul_ps(scaleZ, _mm_mul_ps(two, _mm_add_ps(xz, wy)));
+			__m128 m21 = _mm_mul_ps(scaleZ, _mm_mul_ps(two, _mm_sub_ps(yz, wx)));
+			__m128 m22 = _mm_mul_ps(scaleZ, _mm_add_ps(_mm_sub_ps(_mm_sub_ps(ww, xx), yy), zz));
+			__m128 m23 = _mm_setzero_ps();
+			__m128 m33 = _mm_set1_ps(1.0f);
+
+			//成分ごとの並びから行列ごとの行に戻す
+			_MM_TRANSPOSE4_PS(m00, m01, m02, m03);
+			_MM_TRANSPOSE4_PS(m10, m11, m12, m13);
+			_MM_TRANSPOSE4_PS(m20, m21, m22, m23);
+			_MM_TRANSPOSE4_PS(translationX, translationY, translationZ, m33);
+			__m128 rows[4][4] = {
+				{ m00,m10,m20,translationX },
+				{ m01,m11,m21,translationY },
+				{ m02,m12,m22,translationZ },
+				{ m03,m13,m23,m33 }
+			};
+			for (int i = 0; i < 4; ++i)
+			{
+				for (int j = 0; j < 4; ++j)
+				{
+					_mm_storeu_ps(output[index + i].m[j], rows[i][j]);
+				}
+			}
+		}
+#endif
+		for (; index < scales.size(); ++index)
+		{
+			output[index] = MakeAffineMatrix(scales[index], quaternions[index], translations[index]);
+		}
+	}
+
+
+	void Slerp(std::span<const Quaternion> q0, std::span<const Quaternion> q1, float t, std::span<Quaternion> output)
+	{
+		//acosとsinを使うのでSIMDにはせずに1つずつ補間する
+		assert(q1.size() == q0.size() && output.size() >= q0.size());
+		for (size_t index = 0; index < q0.size(); ++index)
+		{
+			output[index] = Slerp(q0[index], q1[index], t);
+		}
+	}
+
+
+	void Nlerp(std::span<const Quaternion> q0, std::span<const Quaternion> q1, float t, std::span<Quaternion> output)
+	{
+		assert(q1.size() == q0.size() && output.size() >= q0.size());
+		size_t index = 0;
+#ifdef MATHFUNCTION_USE_SSE
+		//4つずつ成分ごとに並べてNlerpと同じ計算順で補間する
+		__m128 t0 = _mm_set1_ps(1.0f - t);
+		__m128 t1 = _mm_set1_ps(t);
+		__m128 zero = _mm_setzero_ps();
+		for (; index + 4 <= q0.size(); index += 4)
+		{
+			__m128 x0 = _mm_loadu_ps(&q0[index].x);
+			__m128 y0 = _mm_loadu_ps(&q0[index + 1].x);
+			__m128 z0 = _mm_loadu_ps(&q0[index + 2].x);
+			__m128 w0 = _mm_loadu_ps(&q0[index + 3].x);
+			_MM_TRANSPOSE4_PS(x0, y0, z0, w0);
+			__m128 x1 = _mm_loadu_ps(&q1[index].x);
+			__m128 y1 = _mm_loadu_ps(&q1[index + 1].x);
+			__m128 z1 = _mm_loadu_ps(&q1[index + 2].x);
+			__m128 w1 = _mm_loadu_ps(&q1[index + 3].x);
+			_MM_TRANSPOSE4_PS(x1, y1, z1, w1);
+
+			//内積が負の要素だけ符号を反転する
+			__m128 dot = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x0, x1), _mm_mul_ps(y0, y1)), _mm_mul_ps(z0, z1)), _mm_mul_ps(w0, w1));
+			__m128 sign = _mm_and_ps(_mm_cmplt_ps(dot, zero), _mm_set1_ps(-0.0f));
+			x0 = _mm_xor_ps(x0, sign);
+			y0 = _mm_xor_ps(y0, sign);
+			z0 = _mm_xor_ps(z0, sign);
+			w0 = _mm_xor_ps(w0, sign);
+
+			__m128 x = _mm_add_ps(_mm_mul_ps(t0, x0), _mm_mul_ps(t1, x1));
+			__m128 y = _mm_add_ps(_mm_mul_ps(t0, y0), _mm_mul_ps(t1, y1));
+			__m128 z = _mm_add_ps(_mm_mul_ps(t0, z0), _mm_mul_ps(t1, z1));
+			__m128 w = _mm_add_ps(_mm_mul_ps(t0, w0), _mm_mul_ps(t1, w1));
+
+			//Normalizeと同じくノルムが0の要素は0にする
+			__m128 norm = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)), _mm_mul_ps(w, w)));
+			__m128 isValid = _mm_cmpneq_ps(norm, zero);
+			x = _mm_and_ps(_mm_div_ps(x, norm), isValid);
+			y = _mm_and_ps(_mm_div_ps(y, norm), isValid);
+			z = _mm_and_ps(_mm_div_ps(z, norm), isValid);
+			w = _mm_and_ps(_mm_div_ps(w, norm), isValid);
+
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+			_mm_storeu_ps(&output[index].x, x);
+			_mm_storeu_ps(&output[index + 1].x, y);
+			_mm_storeu_ps(&output[index + 2].x, z);
+			_mm_storeu_ps(&output[index + 3].x, w);
+		}
+#endif
+		for (; index < q0.size(); ++index)
+		{
+			output[index] = Nlerp(q0[index], q1[index], t);
+		}
+	}
 }
\ No newline at end of file
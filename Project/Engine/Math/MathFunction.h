@@ -4,15 +4,28 @@
 #include "Vector4.h"
 #include "Matrix4x4.h"
 #include "Quaternion.h"
+#include "Frustum.h"
+#include <cassert>
 #include <cmath>
+#include <span>
 
 namespace Mathf
 {
-	float Dot(const Vector3& v1, const Vector3& v2);
+	constexpr float Dot(const Vector3& v1, const Vector3& v2) noexcept
+	{
+		float result{};
+		result = v1.x * v2.x + v1.y * v2.y + v1.z * v2.z;
+		return result;
+	}
 
 	float Length(const Vector3& v);
 
-	float Lerp(const float& v1, const float& v2, float t);
+	constexpr float Lerp(const float& v1, const float& v2, float t) noexcept
+	{
+		float result{};
+		result = v1 + t * (v2 - v1);
+		return result;
+	}
 
 	float LerpShortAngle(const float& a, const float& b, float t);
 
@@ -20,13 +33,27 @@ namespace Mathf
 
 	Vector3 Normalize(const Vector3& v);
 
-	Vector3 Cross(const Vector3& v1, const Vector3& v2);
+	constexpr Vector3 Cross(const Vector3& v1, const Vector3& v2) noexcept
+	{
+		Vector3 result{};
+		result.x = (v1.y * v2.z) - (v1.z * v2.y);
+		result.y = (v1.z * v2.x) - (v1.x * v2.z);
+		result.z = (v1.x * v2.y) - (v1.y * v2.x);
+		return result;
+	}
 
 	Vector3 Transform(const Vector3& v, const Matrix4x4& m);
 
 	Vector3 TransformNormal(const Vector3& v, const Matrix4x4& m);
 
-	Vector3 Lerp(const Vector3& v1, const Vector3& v2, float t);
+	constexpr Vector3 Lerp(const Vector3& v1, const Vector3& v2, float t) noexcept
+	{
+		Vector3 result{};
+		result.x = v1.x + t * (v2.x - v1.x);
+		result.y = v1.y + t * (v2.y - v1.y);
+		result.z = v1.z + t * (v2.z - v1.z);
+		return result;
+	}
 
 	Vector3 Slerp(const Vector3& v1, const Vector3& v2, float t);
 
@@ -34,13 +61,121 @@ namespace Mathf
 
 	Matrix4x4 Inverse(const Matrix4x4& m);
 
-	Matrix4x4 Transpose(const Matrix4x4& m);
-
-	Matrix4x4 MakeIdentity4x4();
-
-	Matrix4x4 MakeScaleMatrix(const Vector3& scale);
-
-	Matrix4x4 MakeTranslateMatrix(const Vector3& translate);
+	//4列目が(0,0,0,1)のアフィン行列の逆行列(3x3部分だけ逆行列を求めるのでInverseより速い)
+	Matrix4x4 InverseAffine(const Matrix4x4& m);
+
+	//mが拡縮*回転*平行移動の行列のとき、拡縮から逆行列を求める(回転は転置するだけで済む)
+	Matrix4x4 InverseAffine(const Matrix4x4& m, const Vector3& scale);
+
+	//Transpose(Inverse(m))と同じ結果をアフィン行列用の計算で求める
+	Matrix4x4 InverseTransposeAffine(const Matrix4x4& m);
+
+	//mが拡縮*回転*平行移動の行列のとき、拡縮からTranspose(Inverse(m))を求める
+	Matrix4x4 InverseTransposeAffine(const Matrix4x4& m, const Vector3& scale);
+
+	constexpr Matrix4x4 Transpose(const Matrix4x4& m) noexcept
+	{
+		Matrix4x4 result{};
+		result.m[0][0] = m.m[0][0];
+		result.m[0][1] = m.m[1][0];
+		result.m[0][2] = m.m[2][0];
+		result.m[0][3] = m.m[3][0];
+
+		result.m[1][0] = m.m[0][1];
+		result.m[1][1] = m.m[1][1];
+		result.m[1][2] = m.m[2][1];
+		result.m[1][3] = m.m[3][1];
+
+		result.m[2][0] = m.m[0][2];
+		result.m[2][1] = m.m[1][2];
+		result.m[2][2] = m.m[2][2];
+		result.m[2][3] = m.m[3][2];
+
+		result.m[3][0] = m.m[0][3];
+		result.m[3][1] = m.m[1][3];
+		result.m[3][2] = m.m[2][3];
+		result.m[3][3] = m.m[3][3];
+
+		return result;
+	}
+
+	constexpr Matrix4x4 MakeIdentity4x4() noexcept
+	{
+		Matrix4x4 result{};
+		result.m[0][0] = 1.0f;
+		result.m[0][1] = 0.0f;
+		result.m[0][2] = 0.0f;
+		result.m[0][3] = 0.0f;
+
+		result.m[1][0] = 0.0f;
+		result.m[1][1] = 1.0f;
+		result.m[1][2] = 0.0f;
+		result.m[1][3] = 0.0f;
+
+		result.m[2][0] = 0.0f;
+		result.m[2][1] = 0.0f;
+		result.m[2][2] = 1.0f;
+		result.m[2][3] = 0.0f;
+
+		result.m[3][0] = 0.0f;
+		result.m[3][1] = 0.0f;
+		result.m[3][2] = 0.0f;
+		result.m[3][3] = 1.0f;
+
+		return result;
+	}
+
+	constexpr Matrix4x4 MakeScaleMatrix(const Vector3& scale) noexcept
+	{
+		Matrix4x4 result;
+		result.m[0][0] = scale.x;
+		result.m[0][1] = 0;
+		result.m[0][2] = 0;
+		result.m[0][3] = 0;
+
+		result.m[1][0] = 0;
+		result.m[1][1] = scale.y;
+		result.m[1][2] = 0;
+		result.m[1][3] = 0;
+
+		result.m[2][0] = 0;
+		result.m[2][1] = 0;
+		result.m[2][2] = scale.z;
+		result.m[2][3] = 0;
+
+		result.m[3][0] = 0;
+		result.m[3][1] = 0;
+		result.m[3][2] = 0;
+		result.m[3][3] = 1.0f;
+
+		return result;
+	}
+
+	constexpr Matrix4x4 MakeTranslateMatrix(const Vector3& translate) noexcept
+	{
+		Matrix4x4 result;
+		result.m[0][0] = 1.0f;
+		result.m[0][1] = 0;
+		result.m[0][2] = 0;
+		result.m[0][3] = 0;
+
+		result.m[1][0] = 0;
+		result.m[1][1] = 1.0f;
+		result.m[1][2] = 0;
+		result.m[1][3] = 0;
+
+		result.m[2][0] = 0;
+		result.m[2][1] = 0;
+		result.m[2][2] = 1.0f;
+		result.m[2][3] = 0;
+
+		result.m[3][0] = translate.x;
+		result.m[3][1] = translate.y;
+		result.m[3][2] = translate.z;
+		result.m[3][3] = 1.0f;
+
+		return result;
+	}
 
 	Matrix4x4 MakeRotateXMatrix(float radian);
 
@@ -48,25 +183,147 @@ namespace Mathf
 
 	Matrix4x4 MakeRotateZMatrix(float radian);
 
+	//オイラー角をクォータニオンに変換してから行列を作る
 	Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate);
 
-	Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Quaternion& quaternion, const Vector3& translation);
+	constexpr Matrix4x4 MakeRotateMatrix(const Quaternion& quaternion) noexcept
+	{
+		Matrix4x4 result{};
+		result.m[0][0] = quaternion.w * quaternion.w + quaternion.x * quaternion.x - quaternion.y * quaternion.y - quaternion.z * quaternion.z;
+		result.m[0][1] = 2.0f * (quaternion.x * quaternion.y + quaternion.w * quaternion.z);
+		result.m[0][2] = 2.0f * (quaternion.x * quaternion.z - quaternion.w * quaternion.y);
+		result.m[0][3] = 0.0f;
+		result.m[1][0] = 2.0f * (quaternion.x * quaternion.y - quaternion.w * quaternion.z);
+		result.m[1][1] = quaternion.w * quaternion.w - quaternion.x * quaternion.x + quaternion.y * quaternion.y - quaternion.z * quaternion.z;
+		result.m[1][2] = 2.0f * (quaternion.y * quaternion.z + quaternion.w * quaternion.x);
+		result.m[1][3] = 0.0f;
+		result.m[2][0] = 2.0f * (quaternion.x * quaternion.z + quaternion.w * quaternion.y);
+		result.m[2][1] = 2.0f * (quaternion.y * quaternion.z - quaternion.w * quaternion.x);
+		result.m[2][2] = quaternion.w * quaternion.w - quaternion.x * quaternion.x - quaternion.y * quaternion.y + quaternion.z * quaternion.z;
+		result.m[2][3] = 0.0f;
+		result.m[3][0] = 0.0f;
+		result.m[3][1] = 0.0f;
+		result.m[3][2] = 0.0f;
+		result.m[3][3] = 1.0f;
+		return result;
+	}
+
+	//回転行列の各行に拡縮を掛けて平行移動を入れる(行列の積を2回するより速い)
+	constexpr Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Quaternion& quaternion, const Vector3& translation) noexcept
+	{
+		Matrix4x4 result = MakeRotateMatrix(quaternion);
+		result.m[0][0] *= scale.x;
+		result.m[0][1] *= scale.x;
+		result.m[0][2] *= scale.x;
+
+		result.m[1][0] *= scale.y;
+		result.m[1][1] *= scale.y;
+		result.m[1][2] *= scale.y;
+
+		result.m[2][0] *= scale.z;
+		result.m[2][1] *= scale.z;
+		result.m[2][2] *= scale.z;
+
+		result.m[3][0] = translation.x;
+		result.m[3][1] = translation.y;
+		result.m[3][2] = translation.z;
+		return result;
+	}
+
+	//orientationで回転してpositionにあるカメラのビュー行列(ワールド行列の逆行列を直接求める)
+	constexpr Matrix4x4 MakeViewMatrix(const Quaternion& orientation, const Vector3& position) noexcept
+	{
+		//回転行列の逆行列は転置、平行移動は-position*回転の転置
+		Matrix4x4 rotateMatrix = MakeRotateMatrix(orientation);
+		Matrix4x4 result = Transpose(rotateMatrix);
+		result.m[3][0] = -Dot(position, Vector3{ rotateMatrix.m[0][0],rotateMatrix.m[0][1],rotateMatrix.m[0][2] });
+		result.m[3][1] = -Dot(position, Vector3{ rotateMatrix.m[1][0],rotateMatrix.m[1][1],rotateMatrix.m[1][2] });
+		result.m[3][2] = -Dot(position, Vector3{ rotateMatrix.m[2][0],rotateMatrix.m[2][1],rotateMatrix.m[2][2] });
+		return result;
+	}
 
 	Matrix4x4 MakePerspectiveFovMatrix(float fovY, float aspectRatio, float nearClip, float farClip);
 
-	Matrix4x4 MakeOrthographicMatrix(float left, float top, float right, float bottom, float nearClip, float farClip);
-
-	Matrix4x4 MakeViewportMatrix(float left, float top, float width, float height, float minDepth, float maxDepth);
+	constexpr Matrix4x4 MakeOrthographicMatrix(float left, float top, float right, float bottom, float nearClip, float farClip) noexcept
+	{
+		assert(left != right);
+		assert(top != bottom);
+		Matrix4x4 result;
+		result.m[0][0] = 2.0f / (right - left);
+		result.m[0][1] = 0.0f;
+		result.m[0][2] = 0.0f;
+		result.m[0][3] = 0.0f;
+
+		result.m[1][0] = 0.0f;
+		result.m[1][1] = 2.0f / (top - bottom);
+		result.m[1][2] = 0.0f;
+		result.m[1][3] = 0.0f;
+
+		result.m[2][0] = 0.0f;
+		result.m[2][1] = 0.0f;
+		result.m[2][2] = 1.0f / (farClip - nearClip);
+		result.m[2][3] = 0.0f;
+
+		result.m[3][0] = (left + right) / (left - right);
+		result.m[3][1] = (top + bottom) / (bottom - top);
+		result.m[3][2] = nearClip / (nearClip - farClip);
+		result.m[3][3] = 1.0f;
+
+		return result;
+	}
+
+	constexpr Matrix4x4 MakeViewportMatrix(float left, float top, float width, float height, float minDepth, float maxDepth) noexcept
+	{
+		Matrix4x4 result{};
+		result.m[0][0] = width / 2;
+		result.m[0][1] = 0;
+		result.m[0][2] = 0;
+		result.m[0][3] = 0;
+
+		result.m[1][0] = 0;
+		result.m[1][1] = -height / 2;
+		result.m[1][2] = 0;
+		result.m[1][3] = 0;
+
+		result.m[2][0] = 0;
+		result.m[2][1] = 0;
+		result.m[2][2] = maxDepth - minDepth;
+		result.m[2][3] = 0;
+
+		result.m[3][0] = left + (width / 2);
+		result.m[3][1] = top + (height / 2);
+		result.m[3][2] = minDepth;
+		result.m[3][3] = 1;
+
+		return result;
+	}
 
 	Matrix4x4 DirectionToDirection(const Vector3& from, const Vector3& to);
 
-	Matrix4x4 MakeRotateAxisAngle(Vector3 axis, float angle);
+	//ビュープロジェクション行列から視錐台の平面を取り出す
+	Frustum MakeFrustum(const Matrix4x4& viewProjection);
 
-	Matrix4x4 MakeRotateMatrix(const Quaternion& quaternion);
-
-	Quaternion IdentityQuaternion();
+	Matrix4x4 MakeRotateAxisAngle(Vector3 axis, float angle);
 
-	Quaternion Conjugate(const Quaternion& quaternion);
+	constexpr Quaternion IdentityQuaternion() noexcept
+	{
+		Quaternion result{};
+		result.x = 0.0f;
+		result.y = 0.0f;
+		result.z = 0.0f;
+		result.w = 1.0f;
+		return result;
+	}
+
+	constexpr Quaternion Conjugate(const Quaternion& quaternion) noexcept
+	{
+		Quaternion result{};
+		result.x = quaternion.x * -1.0f;
+		result.y = quaternion.y * -1.0f;
+		result.z = quaternion.z * -1.0f;
+		result.w = quaternion.w;
+		return result;
+	}
 
 	Quaternion Normalize(const Quaternion& quaternion);
 
@@ -74,6 +331,38 @@ namespace Mathf
 
 	Quaternion MakeRotateAxisAngleQuaternion(const Vector3& axis, float angle);
 
+	//MakeAffineMatrixと同じX→Y→Zの順に回転するクォータニオン
+	Quaternion MakeRotateQuaternion(const Vector3& rotate);
+
 	Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t);
+
+	//線形補間して正規化する(Slerpより速いが角速度は一定にならない)
+	Quaternion Nlerp(const Quaternion& q0, const Quaternion& q1, float t);
+
+	//以下は配列をまとめて処理する(1つずつ呼んだ場合と同じ結果)。outputは入力と同じ数以上の要素が必要
+
+	//pointsをTransformで変換する
+	void TransformPoints(std::span<const Vector3> points, const Matrix4x4& m, std::span<Vector3> output);
+
+	//成分ごとに並べた座標をTransformで変換する
+	void TransformPoints(std::span<const float> x, std::span<const float> y, std::span<const float> z, const Matrix4x4& m, std::span<float> outputX, std::span<float> outputY, std::span<float> outputZ);
+
+	//vectorsをTransformNormalで変換する
+	void TransformNormals(std::span<const Vector3> vectors, const Matrix4x4& m, std::span<Vector3> output);
+
+	//lhs[i] * rhs
+	void MultiplyMatrices(std::span<const Matrix4x4> lhs, const Matrix4x4& rhs, std::span<Matrix4x4> output);
+
+	//lhs[i] * rhs[i]
+	void MultiplyMatrices(std::span<const Matrix4x4> lhs, std::span<const Matrix4x4> rhs, std::span<Matrix4x4> output);
+
+	//MakeAffineMatrix(scales[i], quaternions[i], translations[i])
+	void MakeAffineMatrices(std::span<const Vector3> scales, std::span<const Quaternion> quaternions, std::span<const Vector3> translations, std::span<Matrix4x4> output);
+
+	//Slerp(q0[i], q1[i], t)
+	void Slerp(std::span<const Quaternion> q0, std::span<const Quaternion> q1, float t, std::span<Quaternion> output);
+
+	//Nlerp(q0[i], q1[i], t)
+	void Nlerp(std::span<const Quaternion> q0, std::span<const Quaternion> q1, float t, std::span<Quaternion> output);
 }
 
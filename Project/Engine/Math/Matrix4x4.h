@@ -1,10 +1,16 @@
 #pragma once
+#include <type_traits>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define MATRIX4X4_USE_SSE
+#endif
 
 struct Matrix4x4
 {
 	float m[4][4];
 
-	Matrix4x4 operator+(const Matrix4x4& rhs) const
+	constexpr Matrix4x4 operator+(const Matrix4x4& rhs) const noexcept
 	{
 		Matrix4x4 result{};
 		for (int i = 0; i < 4; ++i)
@@ -17,7 +23,7 @@ struct Matrix4x4
 		return result;
 	}
 
-	Matrix4x4 operator-(const Matrix4x4& rhs) const
+	constexpr Matrix4x4 operator-(const Matrix4x4& rhs) const noexcept
 	{
 		Matrix4x4 result{};
 		for (int i = 0; i < 4; ++i)
@@ -30,9 +36,28 @@ struct Matrix4x4
 		return result;
 	}
 
-	Matrix4x4 operator*(const Matrix4x4& rhs) const
+	constexpr Matrix4x4 operator*(const Matrix4x4& rhs) const noexcept
 	{
-		Matrix4x4 result{};
+		Matrix4x4 result;
+#ifdef MATRIX4X4_USE_SSE
+		if (!std::is_constant_evaluated())
+		{
+			//行ごとに右の行列の4行を要素で重み付けして足す(スカラー版と同じ計算順なので結果も同じ)
+			__m128 row0 = _mm_loadu_ps(rhs.m[0]);
+			__m128 row1 = _mm_loadu_ps(rhs.m[1]);
+			__m128 row2 = _mm_loadu_ps(rhs.m[2]);
+			__m128 row3 = _mm_loadu_ps(rhs.m[3]);
+			for (int i = 0; i < 4; ++i)
+			{
+				__m128 sum = _mm_mul_ps(_mm_set1_ps(m[i][0]), row0);
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(m[i][1]), row1));
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(m[i][2]), row2));
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(m[i][3]), row3));
+				_mm_storeu_ps(result.m[i], sum);
+			}
+			return result;
+		}
+#endif
 		for (int i = 0; i < 4; ++i)
 		{
 			for (int j = 0; j < 4; ++j)
@@ -43,25 +68,25 @@ struct Matrix4x4
 		return result;
 	}
 
-	Matrix4x4 operator+=(const Matrix4x4& rhs)
+	constexpr Matrix4x4 operator+=(const Matrix4x4& rhs) noexcept
 	{
 		*this = *this + rhs;
 		return *this;
 	}
 
-	Matrix4x4 operator-=(const Matrix4x4& rhs)
+	constexpr Matrix4x4 operator-=(const Matrix4x4& rhs) noexcept
 	{
 		*this = *this - rhs;
 		return *this;
 	}
 
-	Matrix4x4 operator*=(const Matrix4x4& rhs)
+	constexpr Matrix4x4 operator*=(const Matrix4x4& rhs) noexcept
 	{
 		*this = *this * rhs;
 		return *this;
 	}
 
-	bool operator==(const Matrix4x4& rhs) const
+	constexpr bool operator==(const Matrix4x4& rhs) const noexcept
 	{
 		for (int i = 0; i < 4; ++i)
 		{
@@ -76,7 +101,7 @@ struct Matrix4x4
 		return true;
 	}
 
-	bool operator!=(const Matrix4x4& rhs) const
+	constexpr bool operator!=(const Matrix4x4& rhs) const noexcept
 	{
 		return !(*this == rhs);
 	}
@@ -1,6 +1,12 @@
 #pragma once
 #include <cmath>
 #include <limits>
+#include <type_traits>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define QUATERNION_USE_SSE
+#endif
 
 struct Quaternion
 {
@@ -9,18 +15,32 @@ struct Quaternion
 	float z;
 	float w;
 
-	Quaternion operator+(const Quaternion rhs) const
+	constexpr Quaternion operator+(const Quaternion rhs) const noexcept
 	{
 		return Quaternion(x + rhs.x, y + rhs.y, z + rhs.z, w + rhs.w);
 	}
 
-	Quaternion operator-(const Quaternion rhs) const
+	constexpr Quaternion operator-(const Quaternion rhs) const noexcept
 	{
 		return Quaternion(x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w);
 	}
 
-	Quaternion operator*(const Quaternion rhs) const
+	constexpr Quaternion operator*(const Quaternion rhs) const noexcept
 	{
+#ifdef QUATERNION_USE_SSE
+		if (!std::is_constant_evaluated())
+		{
+			//左の各成分と並べ替えた右を掛けて符号を付けて足す(スカラー版と同じ計算順なので結果も同じ)
+			__m128 r = _mm_loadu_ps(&rhs.x);
+			__m128 sum = _mm_mul_ps(_mm_set1_ps(w), r);
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(x), _mm_xor_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(0, 1, 2, 3)), _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f))));
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(y), _mm_xor_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 0, 3, 2)), _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f))));
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(z), _mm_xor_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_ps(-0.0f, 0.0f, 0.0f, -0.0f))));
+			Quaternion result;
+			_mm_storeu_ps(&result.x, sum);
+			return result;
+		}
+#endif
 		return Quaternion(
 			w * rhs.x + x * rhs.w + y * rhs.z - z * rhs.y,
 			w * rhs.y - x * rhs.z + y * rhs.w + z * rhs.x,
@@ -29,33 +49,35 @@ struct Quaternion
 		);
 	}
 
-	Quaternion operator+=(const Quaternion rhs)
+	constexpr Quaternion operator+=(const Quaternion rhs) noexcept
 	{
 		*this = *this + rhs;
 		return *this;
 	}
 
-	Quaternion operator-=(const Quaternion rhs)
+	constexpr Quaternion operator-=(const Quaternion rhs) noexcept
 	{
 		*this = *this - rhs;
 		return *this;
 	}
 
-	Quaternion operator*=(const Quaternion rhs)
+	constexpr Quaternion operator*=(const Quaternion rhs) noexcept
 	{
 		*this = *this * rhs;
 		return *this;
 	}
 
-	bool operator==(const Quaternion rhs) const
+	constexpr bool operator==(const Quaternion rhs) const noexcept
 	{
-		return std::fabs(x - rhs.x) < std::numeric_limits<float>::epsilon() &&
-			std::fabs(y - rhs.y) < std::numeric_limits<float>::epsilon() &&
-			std::fabs(z - rhs.z) < std::numeric_limits<float>::epsilon() &&
-			std::fabs(w - rhs.w) < std::numeric_limits<float>::epsilon();
+		//std::fabsはconstexprではないので差が(-epsilon,epsilon)に入っているかで比べる
+		const float epsilon = std::numeric_limits<float>::epsilon();
+		return -epsilon < x - rhs.x && x - rhs.x < epsilon &&
+			-epsilon < y - rhs.y && y - rhs.y < epsilon &&
+			-epsilon < z - rhs.z && z - rhs.z < epsilon &&
+			-epsilon < w - rhs.w && w - rhs.w < epsilon;
 	}
 
-	bool operator!=(const Quaternion rhs) const
+	constexpr bool operator!=(const Quaternion rhs) const noexcept
 	{
 		return !(*this == rhs);
 	}
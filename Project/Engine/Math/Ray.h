@@ -0,0 +1,8 @@
+#pragma once
+#include "Vector3.h"
+
+struct Ray
+{
+	Vector3 origin;//始点
+	Vector3 direction;//向き。正規化必須
+};
\ No newline at end of file
@@ -4,7 +4,7 @@ struct Vector2
 	float x;
 	float y;
 
-	Vector2 operator+(const Vector2& rhs) const
+	constexpr Vector2 operator+(const Vector2& rhs) const noexcept
 	{
 		Vector2 result{};
 		result.x = x + rhs.x;
@@ -12,7 +12,7 @@ struct Vector2
 		return result;
 	}
 
-	Vector2 operator-(const Vector2& rhs) const
+	constexpr Vector2 operator-(const Vector2& rhs) const noexcept
 	{
 		Vector2 result{};
 		result.x = x - rhs.x;
@@ -20,7 +20,7 @@ struct Vector2
 		return result;
 	}
 
-	Vector2 operator*(const Vector2& rhs) const
+	constexpr Vector2 operator*(const Vector2& rhs) const noexcept
 	{
 		Vector2 result{};
 		result.x = x * rhs.x;
@@ -28,7 +28,7 @@ struct Vector2
 		return result;
 	}
 
-	Vector2 operator*(float scalar) const
+	constexpr Vector2 operator*(float scalar) const noexcept
 	{
 		Vector2 result{};
 		result.x = x * scalar;
@@ -36,7 +36,7 @@ struct Vector2
 		return result;
 	}
 
-	Vector2 operator/(float scalar) const
+	constexpr Vector2 operator/(float scalar) const noexcept
 	{
 		Vector2 result{};
 		if (scalar != 0.0f)
@@ -47,42 +47,42 @@ struct Vector2
 		return result;
 	}
 
-	Vector2 operator+=(const Vector2& rhs)
+	constexpr Vector2 operator+=(const Vector2& rhs) noexcept
 	{
 		*this = *this + rhs;
 		return *this;
 	}
 
-	Vector2 operator-=(const Vector2& rhs)
+	constexpr Vector2 operator-=(const Vector2& rhs) noexcept
 	{
 		*this = *this - rhs;
 		return *this;
 	}
 
-	Vector2 operator*=(const Vector2& rhs)
+	constexpr Vector2 operator*=(const Vector2& rhs) noexcept
 	{
 		*this = *this * rhs;
 		return *this;
 	}
 
-	Vector2 operator*=(float scalar)
+	constexpr Vector2 operator*=(float scalar) noexcept
 	{
 		*this = *this * scalar;
 		return *this;
 	}
 
-	Vector2 operator/=(float scalar)
+	constexpr Vector2 operator/=(float scalar) noexcept
 	{
 		*this = *this / scalar;
 		return *this;
 	}
 
-	bool operator==(const Vector2& rhs) const
+	constexpr bool operator==(const Vector2& rhs) const noexcept
 	{
 		return x == rhs.x && y == rhs.y;
 	}
 
-	bool operator!=(const Vector2& rhs) const
+	constexpr bool operator!=(const Vector2& rhs) const noexcept
 	{
 		return !(*this == rhs);
 	}
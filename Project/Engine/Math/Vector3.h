@@ -5,7 +5,7 @@ struct Vector3
 	float y;
 	float z;
 
-	Vector3 operator+(const Vector3& rhs) const
+	constexpr Vector3 operator+(const Vector3& rhs) const noexcept
 	{
 		Vector3 result{};
 		result.x = x + rhs.x;
@@ -14,7 +14,7 @@ struct Vector3
 		return result;
 	}
 
-	Vector3 operator-(const Vector3& rhs) const
+	constexpr Vector3 operator-(const Vector3& rhs) const noexcept
 	{
 		Vector3 result{};
 		result.x = x - rhs.x;
@@ -23,7 +23,7 @@ struct Vector3
 		return result;
 	}
 
-	Vector3 operator*(const Vector3& rhs) const
+	constexpr Vector3 operator*(const Vector3& rhs) const noexcept
 	{
 		Vector3 result{};
 		result.x = x * rhs.x;
@@ -32,7 +32,7 @@ struct Vector3
 		return result;
 	}
 
-	Vector3 operator*(float scalar) const
+	constexpr Vector3 operator*(float scalar) const noexcept
 	{
 		Vector3 result{};
 		result.x = x * scalar;
@@ -41,7 +41,7 @@ struct Vector3
 		return result;
 	}
 
-	Vector3 operator/(float scalar) const
+	constexpr Vector3 operator/(float scalar) const noexcept
 	{
 		Vector3 result{};
 		if (scalar != 0.0f)
@@ -53,42 +53,42 @@ struct Vector3
 		return result;
 	}
 
-	Vector3 operator+=(const Vector3& rhs)
+	constexpr Vector3 operator+=(const Vector3& rhs) noexcept
 	{
 		*this = *this + rhs;
 		return *this;
 	}
 
-	Vector3 operator-=(const Vector3& rhs)
+	constexpr Vector3 operator-=(const Vector3& rhs) noexcept
 	{
 		*this = *this - rhs;
 		return *this;
 	}
 
-	Vector3 operator*=(const Vector3& rhs)
+	constexpr Vector3 operator*=(const Vector3& rhs) noexcept
 	{
 		*this = *this * rhs;
 		return *this;
 	}
 
-	Vector3 operator*=(float scalar)
+	constexpr Vector3 operator*=(float scalar) noexcept
 	{
 		*this = *this * scalar;
 		return *this;
 	}
 
-	Vector3 operator/=(float scalar)
+	constexpr Vector3 operator/=(float scalar) noexcept
 	{
 		*this = *this / scalar;
 		return *this;
 	}
 
-	bool operator==(const Vector3& rhs) const
+	constexpr bool operator==(const Vector3& rhs) const noexcept
 	{
 		return x == rhs.x && y == rhs.y && z == rhs.z;
 	}
 
-	bool operator!=(const Vector3& rhs) const
+	constexpr bool operator!=(const Vector3& rhs) const noexcept
 	{
 		return !(*this == rhs);
 	}
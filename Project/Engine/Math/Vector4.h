@@ -6,7 +6,7 @@ struct Vector4
 	float z;
 	float w;
 
-	Vector4 operator+(const Vector4& rhs) const
+	constexpr Vector4 operator+(const Vector4& rhs) const noexcept
 	{
 		Vector4 result{};
 		result.x = x + rhs.x;
@@ -16,7 +16,7 @@ struct Vector4
 		return result;
 	}
 
-	Vector4 operator-(const Vector4& rhs) const
+	constexpr Vector4 operator-(const Vector4& rhs) const noexcept
 	{
 		Vector4 result{};
 		result.x = x - rhs.x;
@@ -26,7 +26,7 @@ struct Vector4
 		return result;
 	}
 
-	Vector4 operator*(const Vector4& rhs) const
+	constexpr Vector4 operator*(const Vector4& rhs) const noexcept
 	{
 		Vector4 result{};
 		result.x = x * rhs.x;
@@ -36,7 +36,7 @@ struct Vector4
 		return result;
 	}
 
-	Vector4 operator*(float scalar) const
+	constexpr Vector4 operator*(float scalar) const noexcept
 	{
 		Vector4 result{};
 		result.x = x * scalar;
@@ -46,7 +46,7 @@ struct Vector4
 		return result;
 	}
 
-	Vector4 operator/(float scalar) const
+	constexpr Vector4 operator/(float scalar) const noexcept
 	{
 		Vector4 result{};
 		if (scalar != 0.0f)
@@ -59,42 +59,42 @@ struct Vector4
 		return result;
 	}
 
-	Vector4 operator+=(const Vector4& rhs)
+	constexpr Vector4 operator+=(const Vector4& rhs) noexcept
 	{
 		*this = *this + rhs;
 		return *this;
 	}
 
-	Vector4 operator-=(const Vector4& rhs)
+	constexpr Vector4 operator-=(const Vector4& rhs) noexcept
 	{
 		*this = *this - rhs;
 		return *this;
 	}
 
-	Vector4 operator*=(const Vector4& rhs)
+	constexpr Vector4 operator*=(const Vector4& rhs) noexcept
 	{
 		*this = *this * rhs;
 		return *this;
 	}
 
-	Vector4 operator*=(float scalar)
+	constexpr Vector4 operator*=(float scalar) noexcept
 	{
 		*this = *this * scalar;
 		return *this;
 	}
 
-	Vector4 operator/=(float scalar)
+	constexpr Vector4 operator/=(float scalar) noexcept
 	{
 		*this = *this / scalar;
 		return *this;
 	}
 
-	bool operator==(const Vector4& rhs) const
+	constexpr bool operator==(const Vector4& rhs) const noexcept
 	{
 		return x == rhs.x && y == rhs.y && z == rhs.z && w == rhs.w;
 	}
 
-	bool operator!=(const Vector4& rhs) const
+	constexpr bool operator!=(const Vector4& rhs) const noexcept
 	{
 		return !(*this == rhs);
 	}
@@ -0,0 +1,64 @@
+#include "RadixSort.h"
+#include <bit>
+
+const std::vector<uint32_t>& RadixSort::SortByFloatKey(const float* keys, uint32_t count)
+{
+	items_.resize(count);
+	tempItems_.resize(count);
+	indices_.resize(count);
+	if (count == 0)
+	{
+		return indices_;
+	}
+
+	//負の数は全てのビットを反転、正の数は符号ビットだけ反転すると整数として比較できる
+	//4桁分の出現数は変換と同時に数えておく
+	uint32_t histograms[4][256]{};
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		uint32_t bits = std::bit_cast<uint32_t>(keys[i]);
+		bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+		items_[i] = (uint64_t(bits) << 32) | i;
+		++histograms[0][bits & 0xFF];
+		++histograms[1][(bits >> 8) & 0xFF];
+		++histograms[2][(bits >> 16) & 0xFF];
+		++histograms[3][bits >> 24];
+	}
+
+	//下位の桁から8ビットずつ安定に並べ替える
+	for (uint32_t pass = 0; pass < 4; ++pass)
+	{
+		uint32_t shift = 32 + pass * 8;
+		uint32_t* histogram = histograms[pass];
+
+		//全てのキーで同じ値の桁は並べ替えなくてよい
+		if (histogram[(items_[0] >> shift) & 0xFF] == count)
+		{
+			continue;
+		}
+
+		//出現数から書き込み先の先頭を計算
+		uint32_t offset = 0;
+		for (uint32_t digit = 0; digit < 256; ++digit)
+		{
+			uint32_t digitCount = histogram[digit];
+			histogram[digit] = offset;
+			offset += digitCount;
+		}
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			uint64_t item = items_[i];
+			tempItems_[histogram[(item >> shift) & 0xFF]++] = item;
+		}
+		items_.swap(tempItems_);
+	}
+
+	//インデックスだけを取り出す
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		indices_[i] = uint32_t(items_[i]);
+	}
+
+	return indices_;
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+class RadixSort
+{
+public:
+	//キーの昇順に並べたインデックスを返す(同じキーは元の順番を保つ)
+	//返した配列は次に呼び出すまで有効
+	const std::vector<uint32_t>& SortByFloatKey(const float* keys, uint32_t count);
+
+private:
+	//上位32ビットに大小関係を保ったまま符号なし整数に変換したキー、下位32ビットにインデックスを入れる
+	std::vector<uint64_t> items_{};
+
+	//並べ替えの書き込み先
+	std::vector<uint64_t> tempItems_{};
+
+	std::vector<uint32_t> indices_{};
+};
@@ -1,4 +1,5 @@
 #include "RandomGenerator.h"
+#include <bit>
 
 std::mt19937 RandomGenerator::randomEngine_;
 
@@ -9,6 +10,11 @@ void RandomGenerator::Initialize()
 	randomEngine_ = std::mt19937(seedGenerator());
 }
 
+void RandomGenerator::Initialize(uint32_t seed)
+{
+	randomEngine_ = std::mt19937(seed);
+}
+
 int RandomGenerator::GetRandomInt(int min, int max)
 {
 	std::uniform_int_distribution<int> distribution(min, max);
@@ -19,4 +25,52 @@ float RandomGenerator::GetRandomFloat(float min, float max)
 {
 	std::uniform_real_distribution<float> distribution(min, max);
 	return distribution(randomEngine_);
+}
+
+uint32_t RandomGenerator::GetRandomSeed()
+{
+	return uint32_t(randomEngine_());
+}
+
+void RandomStream::SetSeed(uint64_t seed)
+{
+	//splitmix64でシード値を内部状態に広げる(全て0にはならない)
+	for (uint32_t i = 0; i < 4; i += 2)
+	{
+		seed += 0x9E3779B97F4A7C15ull;
+		uint64_t z = seed;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		z = z ^ (z >> 31);
+		state_[i] = uint32_t(z);
+		state_[i + 1] = uint32_t(z >> 32);
+	}
+}
+
+uint32_t RandomStream::NextUInt()
+{
+	uint32_t result = state_[0] + state_[3];
+	uint32_t t = state_[1] << 9;
+	state_[2] ^= state_[0];
+	state_[3] ^= state_[1];
+	state_[1] ^= state_[2];
+	state_[0] ^= state_[3];
+	state_[2] ^= t;
+	state_[3] = std::rotl(state_[3], 11);
+	return result;
+}
+
+float RandomStream::NextFloat()
+{
+	//下位ビットは質が低いので上位24ビットを使う
+	return float(NextUInt() >> 8) * (1.0f / 16777216.0f);
+}
+
+void RandomStream::FillUniform(float* out, size_t count, float min, float max)
+{
+	float range = max - min;
+	for (size_t i = 0; i < count; ++i)
+	{
+		out[i] = min + range * NextFloat();
+	}
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <random>
 
 class RandomGenerator
@@ -6,11 +8,42 @@ class RandomGenerator
 public:
 	static void Initialize();
 
+	//シード値を固定して初期化する
+	static void Initialize(uint32_t seed);
+
 	static int GetRandomInt(int min, int max);
 
 	static float GetRandomFloat(float min, float max);
 
+	//別の乱数エンジンを初期化するためのシード値
+	static uint32_t GetRandomSeed();
+
 private:
 	static std::mt19937 randomEngine_;
 };
 
+//インスタンスごとに独立した系列を持つ高速な乱数(xoshiro128+)
+//同じシード値なら同じ順番で同じ値を返す。1つのインスタンスを複数のスレッドで共有しないこと
+class RandomStream
+{
+public:
+	RandomStream() { SetSeed(0); };
+
+	explicit RandomStream(uint64_t seed) { SetSeed(seed); };
+
+	void SetSeed(uint64_t seed);
+
+	uint32_t NextUInt();
+
+	//[0,1)の一様乱数
+	float NextFloat();
+
+	//[min,max)の一様乱数
+	float NextFloat(float min, float max) { return min + (max - min) * NextFloat(); };
+
+	//[min,max)の一様乱数をまとめて書き込む
+	void FillUniform(float* out, size_t count, float min, float max);
+
+private:
+	uint32_t state_[4]{};
+};
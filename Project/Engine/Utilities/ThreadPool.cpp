@@ -0,0 +1,157 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+ThreadPool* ThreadPool::instance_ = nullptr;
+
+namespace
+{
+	//ワーカースレッドの中から呼ばれたかどうか
+	thread_local bool isWorkerThread = false;
+}
+
+ThreadPool* ThreadPool::GetInstance()
+{
+	if (instance_ == nullptr)
+	{
+		instance_ = new ThreadPool();
+	}
+	return instance_;
+}
+
+void ThreadPool::Destroy()
+{
+	if (instance_)
+	{
+		delete instance_;
+		instance_ = nullptr;
+	}
+}
+
+ThreadPool::ThreadPool()
+{
+	//論理コア数から呼び出し元の分を引いた数だけワーカーを作る
+	uint32_t hardwareThreads = std::thread::hardware_concurrency();
+	StartWorkers(hardwareThreads > 1 ? hardwareThreads - 1 : 0);
+}
+
+ThreadPool::~ThreadPool()
+{
+	StopWorkers();
+}
+
+void ThreadPool::ParallelFor(uint32_t count, uint32_t chunkSize, const Function& function)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	chunkSize = (std::max)(chunkSize, 1u);
+
+	//ワーカーがいない、分割できない、ワーカーの中から呼ばれた場合はその場で実行する
+	if (workers_.empty() || count <= chunkSize || isWorkerThread)
+	{
+		function(0, count, 0);
+		return;
+	}
+
+	std::lock_guard<std::mutex> parallelForLock(parallelForMutex_);
+
+	//ジョブを設定してワーカーを起こす
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		function_ = &function;
+		count_ = count;
+		chunkSize_ = chunkSize;
+		chunkCount_ = (count + chunkSize - 1) / chunkSize;
+		nextChunk_.store(0);
+		pendingWorkers_ = uint32_t(workers_.size());
+		++generation_;
+	}
+	startCondition_.notify_all();
+
+	//呼び出し元のスレッドも処理する
+	RunChunks(0);
+
+	//全てのワーカーがこのジョブを抜けるまで待つ
+	std::unique_lock<std::mutex> lock(mutex_);
+	finishCondition_.wait(lock, [this]() { return pendingWorkers_ == 0; });
+	function_ = nullptr;
+}
+
+void ThreadPool::SetThreadCount(uint32_t threadCount)
+{
+	std::lock_guard<std::mutex> parallelForLock(parallelForMutex_);
+	StopWorkers();
+	StartWorkers(threadCount > 1 ? threadCount - 1 : 0);
+}
+
+void ThreadPool::StartWorkers(uint32_t workerCount)
+{
+	stop_ = false;
+	for (uint32_t i = 0; i < workerCount; ++i)
+	{
+		//ジョブが無い間に作るので、今の世代を渡せば作成前のジョブと区別できる
+		workers_.emplace_back(&ThreadPool::WorkerMain, this, i + 1, generation_);
+	}
+}
+
+void ThreadPool::StopWorkers()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = true;
+	}
+	startCondition_.notify_all();
+
+	for (std::thread& worker : workers_)
+	{
+		worker.join();
+	}
+	workers_.clear();
+}
+
+void ThreadPool::WorkerMain(uint32_t threadIndex, uint64_t generation)
+{
+	isWorkerThread = true;
+
+	while (true)
+	{
+		//新しいジョブか終了要求が来るまで待つ
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			startCondition_.wait(lock, [&]() { return stop_ || generation_ != generation; });
+			if (stop_)
+			{
+				return;
+			}
+			generation = generation_;
+		}
+
+		RunChunks(threadIndex);
+
+		//処理が終わったことを通知
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			--pendingWorkers_;
+		}
+		finishCondition_.notify_one();
+	}
+}
+
+void ThreadPool::RunChunks(uint32_t threadIndex)
+{
+	//残っているチャンクを取り出して処理する
+	while (true)
+	{
+		uint32_t chunk = nextChunk_.fetch_add(1);
+		if (chunk >= chunkCount_)
+		{
+			break;
+		}
+
+		uint32_t begin = chunk * chunkSize_;
+		uint32_t end = (std::min)(begin + chunkSize_, count_);
+		(*function_)(begin, end, threadIndex);
+	}
+}
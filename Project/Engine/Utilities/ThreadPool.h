@@ -0,0 +1,72 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+	//処理する範囲[begin,end)と実行しているスレッドの番号(0が呼び出し元)
+	using Function = std::function<void(uint32_t begin, uint32_t end, uint32_t threadIndex)>;
+
+	static ThreadPool* GetInstance();
+
+	static void Destroy();
+
+	void ParallelFor(uint32_t count, uint32_t chunkSize, const Function& function);
+
+	//呼び出し元のスレッドを含めたスレッド数
+	const uint32_t GetThreadCount() const { return uint32_t(workers_.size()) + 1; };
+
+	void SetThreadCount(uint32_t threadCount);
+
+private:
+	ThreadPool();
+	~ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	void StartWorkers(uint32_t workerCount);
+
+	void StopWorkers();
+
+	//generationは作成時点のジョブの世代
+	void WorkerMain(uint32_t threadIndex, uint64_t generation);
+
+	void RunChunks(uint32_t threadIndex);
+
+private:
+	static ThreadPool* instance_;
+
+	std::vector<std::thread> workers_{};
+
+	std::mutex mutex_{};
+
+	std::condition_variable startCondition_{};
+
+	std::condition_variable finishCondition_{};
+
+	//ParallelForの同時呼び出しを防ぐ
+	std::mutex parallelForMutex_{};
+
+	const Function* function_ = nullptr;
+
+	uint32_t count_ = 0;
+
+	uint32_t chunkSize_ = 1;
+
+	uint32_t chunkCount_ = 0;
+
+	std::atomic<uint32_t> nextChunk_ = 0;
+
+	//今のジョブを抜けていないワーカーの数
+	uint32_t pendingWorkers_ = 0;
+
+	uint64_t generation_ = 0;
+
+	bool stop_ = false;
+};
@@ -0,0 +1,257 @@
+#include "TestFramework.h"
+#include "Engine/Components/Collision/CollisionManager.h"
+#include "Engine/Math/MathFunction.h"
+#include <memory>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <utility>
+
+namespace
+{
+	//OnCollisionが呼ばれた順番を記録するコライダー
+	class TestCollider : public Collider
+	{
+	public:
+		TestCollider(uint32_t id, std::vector<std::pair<uint32_t, uint32_t>>* log) : id_(id), log_(log) {};
+
+		void OnCollision(Collider* collider) override { log_->push_back({ id_,static_cast<TestCollider*>(collider)->id_ }); };
+
+		const Vector3 GetWorldPosition() const override { return worldTransform_.translation_; };
+
+		const WorldTransform& GetWorldTransform() const override { return worldTransform_; };
+
+		WorldTransform worldTransform_{};
+
+	private:
+		uint32_t id_ = 0;
+
+		std::vector<std::pair<uint32_t, uint32_t>>* log_ = nullptr;
+	};
+
+	const CollisionManager::BroadPhaseType kBroadPhaseTypes[] = {
+		CollisionManager::kBroadPhaseBruteForce,
+		CollisionManager::kBroadPhaseDynamicAABBTree,
+		CollisionManager::kBroadPhaseSpatialHash,
+	};
+
+	//全てのブロードフェーズで同じ順番で同じコールバックが呼ばれるか調べる
+	void CheckBroadPhasesMatch(std::vector<std::unique_ptr<TestCollider>>& colliders, std::vector<std::pair<uint32_t, uint32_t>>& log, size_t expectedCount)
+	{
+		std::vector<std::pair<uint32_t, uint32_t>> bruteForceLog{};
+		for (CollisionManager::BroadPhaseType broadPhaseType : kBroadPhaseTypes)
+		{
+			CollisionManager collisionManager{};
+			collisionManager.SetIsMultithreaded(false);
+			collisionManager.SetBroadPhaseType(broadPhaseType);
+			for (std::unique_ptr<TestCollider>& collider : colliders)
+			{
+				collisionManager.SetColliderList(collider.get());
+			}
+
+			log.clear();
+			collisionManager.CheckAllCollisions();
+			if (broadPhaseType == CollisionManager::kBroadPhaseBruteForce)
+			{
+				bruteForceLog = log;
+				if (expectedCount != size_t(-1))
+				{
+					TEST_CHECK(log.size() == expectedCount);
+				}
+			}
+			else
+			{
+				TEST_CHECK(log == bruteForceLog);
+			}
+		}
+	}
+}
+
+TEST_CASE(CollisionMultiPrimitiveIgnoresUndeclaredShapes)
+{
+	std::vector<std::pair<uint32_t, uint32_t>> log{};
+	std::vector<std::unique_ptr<TestCollider>> colliders{};
+
+	//判定はコライダーAの形状から選ぶので、複数の形状を持つ方を先に登録する
+	AABB aabb = { {-0.4f,-0.4f,-0.4f},{0.4f,0.4f,0.4f} };
+	OBB obb = { {0.0f,0.0f,0.0f},{{1.0f,0.0f,0.0f},{0.0f,1.0f,0.0f},{0.0f,0.0f,1.0f}},{0.6f,0.6f,0.6f} };
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		colliders.push_back(std::make_unique<TestCollider>(i, &log));
+		colliders[i]->worldTransform_.matWorld_ = Mathf::MakeIdentity4x4();
+	}
+
+	//球とAABBを持つコライダー。球は相手の初期値のAABBにだけ重なる
+	colliders[0]->worldTransform_.translation_ = { 1.5f,0.0f,0.0f };
+	colliders[0]->SetRadius(0.6f);
+	colliders[0]->SetAABB(aabb);
+	colliders[0]->SetCollisionPrimitive(kCollisionPrimitiveSphere | kCollisionPrimitiveAABB);
+
+	//AABBとOBBを持つコライダー。AABBは相手の初期値のOBBにだけ重なる
+	colliders[1]->worldTransform_.translation_ = { -1.5f,3.0f,0.0f };
+	colliders[1]->SetAABB(aabb);
+	colliders[1]->SetOBB(obb);
+	colliders[1]->SetCollisionPrimitive(kCollisionPrimitiveAABB | kCollisionPrimitiveOBB);
+
+	//球だけのコライダー(AABBは初期値の大きさのまま)
+	colliders[2]->SetRadius(0.25f);
+	colliders[2]->SetCollisionPrimitive(kCollisionPrimitiveSphere);
+
+	//AABBだけのコライダー(OBBは初期値の大きさのまま)
+	colliders[3]->worldTransform_.translation_ = { -1.5f,4.3f,0.0f };
+	colliders[3]->SetAABB(aabb);
+	colliders[3]->SetCollisionPrimitive(kCollisionPrimitiveAABB);
+
+	//宣言していない形状とは判定しないのでどのブロードフェーズでも当たらない
+	CheckBroadPhasesMatch(colliders, log, 0);
+}
+
+TEST_CASE(CollisionBroadPhasesMatchWithMultiPrimitiveColliders)
+{
+	std::vector<std::pair<uint32_t, uint32_t>> log{};
+	std::vector<std::unique_ptr<TestCollider>> colliders{};
+
+	std::mt19937 randomEngine(12345);
+	std::uniform_real_distribution<float> positionDistribution(-20.0f, 20.0f);
+	std::uniform_real_distribution<float> sizeDistribution(0.2f, 2.0f);
+	std::uniform_real_distribution<float> angleDistribution(-3.14f, 3.14f);
+
+	//形状の全ての組み合わせ
+	const uint32_t kPrimitives[] = {
+		kCollisionPrimitiveSphere,
+		kCollisionPrimitiveAABB,
+		kCollisionPrimitiveOBB,
+		kCollisionPrimitiveSphere | kCollisionPrimitiveAABB,
+		kCollisionPrimitiveSphere | kCollisionPrimitiveOBB,
+		kCollisionPrimitiveAABB | kCollisionPrimitiveOBB,
+		kCollisionPrimitiveSphere | kCollisionPrimitiveAABB | kCollisionPrimitiveOBB,
+	};
+
+	for (uint32_t i = 0; i < 600; ++i)
+	{
+		std::unique_ptr<TestCollider> collider = std::make_unique<TestCollider>(i, &log);
+		Vector3 translation = { positionDistribution(randomEngine),positionDistribution(randomEngine),positionDistribution(randomEngine) };
+		Vector3 rotation = { angleDistribution(randomEngine),angleDistribution(randomEngine),angleDistribution(randomEngine) };
+		collider->worldTransform_.translation_ = translation;
+		collider->worldTransform_.matWorld_ = Mathf::MakeAffineMatrix(Vector3{ 1.0f,1.0f,1.0f }, rotation, translation);
+
+		//持っている形状だけ設定し、それ以外は初期値のままにする
+		uint32_t primitive = kPrimitives[i % std::size(kPrimitives)];
+		float size = sizeDistribution(randomEngine);
+		if (primitive & kCollisionPrimitiveSphere)
+		{
+			collider->SetRadius(size);
+		}
+		if (primitive & kCollisionPrimitiveAABB)
+		{
+			AABB aabb = { {-size,-size * 0.5f,-size},{size,size,size * 0.7f} };
+			collider->SetAABB(aabb);
+		}
+		if (primitive & kCollisionPrimitiveOBB)
+		{
+			OBB obb = { {0.0f,0.0f,0.0f},{{1.0f,0.0f,0.0f},{0.0f,1.0f,0.0f},{0.0f,0.0f,1.0f}},{size,size * 0.5f,size} };
+			collider->SetOBB(obb);
+		}
+		collider->SetCollisionPrimitive(primitive);
+		colliders.push_back(std::move(collider));
+	}
+
+	//数フレーム動かして毎フレーム比べる
+	for (uint32_t frame = 0; frame < 3; ++frame)
+	{
+		for (std::unique_ptr<TestCollider>& collider : colliders)
+		{
+			collider->worldTransform_.translation_.x += 0.5f;
+			collider->worldTransform_.matWorld_.m[3][0] += 0.5f;
+		}
+		CheckBroadPhasesMatch(colliders, log, size_t(-1));
+	}
+
+	TEST_CHECK(!log.empty());
+}
+
+TEST_CASE(CollisionQueriesMatchAcrossBroadPhases)
+{
+	std::vector<std::pair<uint32_t, uint32_t>> log{};
+	std::vector<std::unique_ptr<TestCollider>> colliders{};
+
+	std::mt19937 randomEngine(777);
+	std::uniform_real_distribution<float> positionDistribution(-30.0f, 30.0f);
+	std::uniform_real_distribution<float> sizeDistribution(0.2f, 2.0f);
+	std::uniform_real_distribution<float> directionDistribution(-1.0f, 1.0f);
+
+	for (uint32_t i = 0; i < 500; ++i)
+	{
+		std::unique_ptr<TestCollider> collider = std::make_unique<TestCollider>(i, &log);
+		collider->worldTransform_.translation_ = { positionDistribution(randomEngine),positionDistribution(randomEngine),positionDistribution(randomEngine) };
+		collider->worldTransform_.matWorld_ = Mathf::MakeIdentity4x4();
+
+		//セルに入りきらない大きいコライダーも混ぜる
+		float size = sizeDistribution(randomEngine) * (i % 50 == 0 ? 20.0f : 1.0f);
+		collider->SetRadius(size);
+		AABB aabb = { {-size,-size * 0.5f,-size},{size,size,size * 0.7f} };
+		collider->SetAABB(aabb);
+		collider->SetCollisionPrimitive(i % 2 == 0 ? kCollisionPrimitiveSphere : kCollisionPrimitiveAABB);
+		collider->SetCollisionAttribute(i % 3 == 0 ? kCollisionAttributePlayer : kCollisionAttributeEnemy);
+		colliders.push_back(std::move(collider));
+	}
+
+	CollisionManager collisionManagers[std::size(kBroadPhaseTypes)]{};
+	for (size_t i = 0; i < std::size(kBroadPhaseTypes); ++i)
+	{
+		collisionManagers[i].SetIsMultithreaded(false);
+		collisionManagers[i].SetBroadPhaseType(kBroadPhaseTypes[i]);
+		for (std::unique_ptr<TestCollider>& collider : colliders)
+		{
+			collisionManagers[i].SetColliderList(collider.get());
+		}
+		collisionManagers[i].CheckAllCollisions();
+	}
+
+	//総当たりと同じコライダーに同じ距離で当たるか調べる
+	uint32_t hitCount = 0;
+	for (uint32_t i = 0; i < 300; ++i)
+	{
+		Vector3 origin = { positionDistribution(randomEngine),positionDistribution(randomEngine),positionDistribution(randomEngine) };
+		Vector3 direction = Mathf::Normalize(Vector3{ directionDistribution(randomEngine),directionDistribution(randomEngine),directionDistribution(randomEngine) });
+		Ray ray = { .origin{origin},.direction{direction} };
+		float radius = float(i % 3) * 0.75f;
+
+		RaycastHit bruteForceHit{};
+		bool isBruteForceHit = collisionManagers[0].SphereCast(ray, radius, 80.0f, kCollisionAttributePlayer, bruteForceHit);
+		hitCount += isBruteForceHit ? 1 : 0;
+		for (size_t k = 1; k < std::size(kBroadPhaseTypes); ++k)
+		{
+			RaycastHit hit{};
+			bool isHit = collisionManagers[k].SphereCast(ray, radius, 80.0f, kCollisionAttributePlayer, hit);
+			TEST_CHECK(isHit == isBruteForceHit);
+			TEST_CHECK(hit.distance == bruteForceHit.distance);
+			//始点が中に入っている場合は距離0で複数当たるのでどれを返すかは決まらない
+			TEST_CHECK(hit.distance == 0.0f || hit.collider == bruteForceHit.collider);
+		}
+
+		//複数のセルにまたがるコライダーも1回だけ返す
+		std::vector<RaycastHit> bruteForceHits{};
+		collisionManagers[0].RaycastAll(ray, 80.0f, 0xffffffff, bruteForceHits);
+		for (size_t k = 1; k < std::size(kBroadPhaseTypes); ++k)
+		{
+			std::vector<RaycastHit> hits{};
+			collisionManagers[k].RaycastAll(ray, 80.0f, 0xffffffff, hits);
+			TEST_CHECK(hits.size() == bruteForceHits.size());
+		}
+
+		Sphere sphere = { .center{origin},.radius{sizeDistribution(randomEngine) * 3.0f} };
+		std::vector<Collider*> bruteForceColliders{};
+		collisionManagers[0].OverlapSphere(sphere, kCollisionAttributeEnemy, bruteForceColliders);
+		std::sort(bruteForceColliders.begin(), bruteForceColliders.end());
+		for (size_t k = 1; k < std::size(kBroadPhaseTypes); ++k)
+		{
+			std::vector<Collider*> overlapColliders{};
+			collisionManagers[k].OverlapSphere(sphere, kCollisionAttributeEnemy, overlapColliders);
+			std::sort(overlapColliders.begin(), overlapColliders.end());
+			TEST_CHECK(overlapColliders == bruteForceColliders);
+		}
+	}
+
+	TEST_CHECK(hitCount > 0);
+}
\ No newline at end of file
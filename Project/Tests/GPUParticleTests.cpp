@@ -0,0 +1,207 @@
+#include "TestFramework.h"
+#include "Engine/Components/Particle/GPUParticleKernels.h"
+#include "Engine/Components/Particle/ParticlePool.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+	//浮動小数点の値がビット単位で一致するか調べる
+	template <typename T>
+	bool IsBitwiseEqual(const T& lhs, const T& rhs)
+	{
+		return std::memcmp(&lhs, &rhs, sizeof(T)) == 0;
+	}
+
+	ConstBuffDataGPUParticleEmitter MakeEmitterData(uint32_t seed, uint32_t popCount)
+	{
+		ConstBuffDataGPUParticleEmitter emitter{};
+		emitter.translation = { 1.0f,2.0f,3.0f };
+		emitter.popCount = popCount;
+		emitter.seed = seed;
+		emitter.minPopArea = { -4.0f,-4.0f,-4.0f };
+		emitter.maxPopArea = { 4.0f,4.0f,4.0f };
+		emitter.minPopRotation = { 0.0f,0.0f,0.0f };
+		emitter.maxPopRotation = { 1.0f,2.0f,3.0f };
+		emitter.minPopScale = { 0.5f,0.5f,0.5f };
+		emitter.maxPopScale = { 1.5f,1.5f,1.5f };
+		emitter.minPopAzimuth = 0.0f;
+		emitter.maxPopAzimuth = 360.0f;
+		emitter.minPopElevation = 0.0f;
+		emitter.maxPopElevation = 180.0f;
+		emitter.minPopVelocity = { 0.01f,0.01f,0.01f };
+		emitter.maxPopVelocity = { 0.1f,0.1f,0.1f };
+		emitter.minPopColor = { 0.0f,0.0f,0.0f,0.5f };
+		emitter.maxPopColor = { 1.0f,1.0f,1.0f,1.0f };
+		emitter.minPopLifeTime = 0.1f;
+		emitter.maxPopLifeTime = 0.5f;
+		emitter.lifeTimeScale = 1.0f;
+		emitter.popQuaternion = { 0.0f,0.0f,0.0f,1.0f };
+		return emitter;
+	}
+
+	ConstBuffDataGPUParticleSimulation MakeSimulationData(uint32_t maxParticleCount)
+	{
+		//ParticlePoolと同じく1/60秒あたりの量として進める
+		const float kDeltaTime = 1.0f / 60.0f;
+		ConstBuffDataGPUParticleSimulation simulation{};
+		simulation.acceleration = { 0.0f,-0.01f,0.002f };
+		simulation.isAccelerationEnable = true;
+		simulation.accelerationMin = { -10.0f,-10.0f,-10.0f };
+		simulation.accelerationMax = { 10.0f,2.0f,10.0f };
+		simulation.deltaTime = kDeltaTime;
+		simulation.timeScale = kDeltaTime * 60.0f;
+		simulation.gravityCenter = { 1.0f,2.0f,3.0f };
+		simulation.isGravityEnable = true;
+		simulation.gravityMin = { -2.0f,-10.0f,-10.0f };
+		simulation.gravityMax = { 10.0f,10.0f,10.0f };
+		simulation.gravityStrength = 0.004f;
+		simulation.gravityStopDistance = 1.0f;
+		simulation.maxParticleCount = maxParticleCount;
+		simulation.vertexCount = 6;
+		return simulation;
+	}
+}
+
+TEST_CASE(GPUParticleThreadGroupCount)
+{
+	TEST_CHECK(GPUParticleKernels::GetThreadGroupCount(0) == 0);
+	TEST_CHECK(GPUParticleKernels::GetThreadGroupCount(1) == 1);
+	TEST_CHECK(GPUParticleKernels::GetThreadGroupCount(GPUParticleKernels::kThreadGroupSize) == 1);
+	TEST_CHECK(GPUParticleKernels::GetThreadGroupCount(GPUParticleKernels::kThreadGroupSize + 1) == 2);
+}
+
+TEST_CASE(GPUParticleMakeParticleIsDeterministic)
+{
+	//シェーダーと同じPCGハッシュになっているか確認する
+	TEST_CHECK(GPUParticleKernels::Hash(0) == 129708002u);
+	TEST_CHECK(GPUParticleKernels::Hash(1) == 2831084092u);
+
+	//同じシード値と番号からは同じパーティクルができ、番号が違えば別の値になる
+	ConstBuffDataGPUParticleEmitter emitter = MakeEmitterData(77, 64);
+	bool isMatched = true;
+	bool isInRange = true;
+	uint32_t sameCount = 0;
+	for (uint32_t i = 0; i < emitter.popCount; ++i)
+	{
+		GPUParticle particle = GPUParticleKernels::MakeParticle(emitter, i);
+		isMatched &= IsBitwiseEqual(particle, GPUParticleKernels::MakeParticle(emitter, i));
+		sameCount += IsBitwiseEqual(particle.translation, GPUParticleKernels::MakeParticle(emitter, i + 1).translation) ? 1 : 0;
+
+		Vector3 offset = particle.translation - emitter.translation;
+		isInRange &= emitter.minPopArea.x <= offset.x && offset.x <= emitter.maxPopArea.x;
+		isInRange &= emitter.minPopArea.y <= offset.y && offset.y <= emitter.maxPopArea.y;
+		isInRange &= emitter.minPopArea.z <= offset.z && offset.z <= emitter.maxPopArea.z;
+		isInRange &= emitter.minPopLifeTime <= particle.lifeTime && particle.lifeTime < emitter.maxPopLifeTime;
+		isInRange &= particle.currentTime == 0.0f && particle.alpha == particle.color.w;
+	}
+	TEST_CHECK(isMatched);
+	TEST_CHECK(isInRange);
+	TEST_CHECK(sameCount == 0);
+
+	//シード値が変われば別のパーティクルになる
+	ConstBuffDataGPUParticleEmitter otherEmitter = MakeEmitterData(78, 64);
+	TEST_CHECK(!IsBitwiseEqual(GPUParticleKernels::MakeParticle(emitter, 0).translation, GPUParticleKernels::MakeParticle(otherEmitter, 0).translation));
+}
+
+TEST_CASE(GPUParticleUpdateMatchesParticlePool)
+{
+	//同じパーティクルをParticlePoolのスカラー版で更新した結果と比べる
+	ConstBuffDataGPUParticleEmitter emitter = MakeEmitterData(5, 200);
+	ConstBuffDataGPUParticleSimulation simulation = MakeSimulationData(200);
+	AccelerationField accelerationField = { .acceleration{simulation.acceleration},.area{simulation.accelerationMin,simulation.accelerationMax},.isEnable{true} };
+	GravityField gravityField = { .center{simulation.gravityCenter},.area{simulation.gravityMin,simulation.gravityMax},.strength{simulation.gravityStrength},.stopDistance{simulation.gravityStopDistance},.isEnable{true} };
+
+	std::vector<GPUParticle> particles(emitter.popCount);
+	ParticlePool pool{};
+	pool.Reserve(emitter.popCount);
+	for (uint32_t i = 0; i < emitter.popCount; ++i)
+	{
+		particles[i] = GPUParticleKernels::MakeParticle(emitter, i);
+		pool.Add(particles[i].translation, { 0.0f,0.0f,0.0f }, particles[i].rotation, particles[i].scale, particles[i].velocity, particles[i].color, particles[i].lifeTime);
+	}
+
+	bool isMatched = true;
+	for (uint32_t frame = 0; frame < 40; ++frame)
+	{
+		for (uint32_t i = 0; i < emitter.popCount; ++i)
+		{
+			bool isAlive = GPUParticleKernels::UpdateParticle(particles[i], simulation);
+			pool.UpdateParticle(i, accelerationField, gravityField, simulation.deltaTime);
+			isMatched &= IsBitwiseEqual(particles[i].translation, pool.GetTranslation(i));
+			isMatched &= IsBitwiseEqual(particles[i].velocity, pool.GetVelocity(i));
+			isMatched &= IsBitwiseEqual(particles[i].color, pool.GetColor(i));
+			isMatched &= isAlive == !pool.GetIsDead(i);
+		}
+	}
+	TEST_CHECK(isMatched);
+}
+
+TEST_CASE(GPUParticleDispatchCountersAndDrawArguments)
+{
+	const uint32_t kMaxParticleCount = 256;
+	ConstBuffDataGPUParticleSimulation simulation = MakeSimulationData(kMaxParticleCount);
+	std::vector<GPUParticle> particles[2] = { std::vector<GPUParticle>(kMaxParticleCount),std::vector<GPUParticle>(kMaxParticleCount) };
+	std::vector<ParticleForGPU> instances(kMaxParticleCount);
+	uint32_t counters[2] = { 0,0 };
+	uint32_t drawArguments[4] = {};
+
+	//最大数を超えて生成しても書き込むのは最大数まで
+	ConstBuffDataGPUParticleEmitter emitter = MakeEmitterData(9, 300);
+	GPUParticleKernels::Emit(emitter, simulation, particles[0].data(), counters);
+	TEST_CHECK(counters[0] == 300);
+	TEST_CHECK(IsBitwiseEqual(particles[0][kMaxParticleCount - 1], GPUParticleKernels::MakeParticle(emitter, kMaxParticleCount - 1)));
+
+	//生き残った数と描画の引数はCPUで1つずつ更新した数と一致する
+	uint32_t current = 0;
+	uint32_t totalAliveCount = 0;
+	for (uint32_t frame = 0; frame < 60; ++frame)
+	{
+		uint32_t count = (std::min)(counters[0], kMaxParticleCount);
+		uint32_t expectedAliveCount = 0;
+		std::vector<GPUParticle> expectedParticles{};
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			GPUParticle particle = particles[current][i];
+			if (GPUParticleKernels::UpdateParticle(particle, simulation))
+			{
+				expectedParticles.push_back(particle);
+				++expectedAliveCount;
+			}
+		}
+
+		GPUParticleKernels::Simulate(simulation, particles[current].data(), particles[current ^ 1].data(), instances.data(), counters);
+		TEST_CHECK(counters[1] == expectedAliveCount);
+		bool isMatched = true;
+		for (uint32_t i = 0; i < expectedAliveCount; ++i)
+		{
+			isMatched &= IsBitwiseEqual(particles[current ^ 1][i], expectedParticles[i]);
+			isMatched &= IsBitwiseEqual(instances[i], GPUParticleKernels::MakeInstance(expectedParticles[i]));
+		}
+		TEST_CHECK(isMatched);
+
+		GPUParticleKernels::Finish(simulation, counters, drawArguments);
+		TEST_CHECK(drawArguments[0] == simulation.vertexCount);
+		TEST_CHECK(drawArguments[1] == expectedAliveCount);
+		TEST_CHECK(drawArguments[2] == 0 && drawArguments[3] == 0);
+		TEST_CHECK(counters[0] == expectedAliveCount && counters[1] == 0);
+		totalAliveCount += expectedAliveCount;
+		current ^= 1;
+
+		//途中で生成しても今いるパーティクルの後ろに追加される
+		if (frame == 10)
+		{
+			ConstBuffDataGPUParticleEmitter secondEmitter = MakeEmitterData(10, 20);
+			uint32_t begin = counters[0];
+			GPUParticleKernels::Emit(secondEmitter, simulation, particles[current].data(), counters);
+			TEST_CHECK(counters[0] == begin + 20);
+			TEST_CHECK(IsBitwiseEqual(particles[current][begin], GPUParticleKernels::MakeParticle(secondEmitter, 0)));
+		}
+	}
+
+	//寿命は0.5秒までなので途中で生成した分も60フレームで全て消える
+	TEST_CHECK(totalAliveCount > 0);
+	TEST_CHECK(counters[0] == 0);
+	TEST_CHECK(drawArguments[1] == 0);
+}
\ No newline at end of file
@@ -0,0 +1,455 @@
+#include "TestFramework.h"
+#include "Engine/Math/MathFunction.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	//浮動小数点の値がビット単位で一致するか調べる
+	template <typename T>
+	bool IsBitwiseEqual(const T& lhs, const T& rhs)
+	{
+		return std::memcmp(&lhs, &rhs, sizeof(T)) == 0;
+	}
+
+	//値の大きさが1以下なら絶対誤差、それより大きければ相対誤差で比べる
+	bool IsNear(double value, double expected, double tolerance)
+	{
+		return std::abs(value - expected) <= tolerance * (std::max)(1.0, std::abs(expected));
+	}
+
+	bool IsNear(const Matrix4x4& m, const double (&expected)[4][4], double tolerance)
+	{
+		bool result = true;
+		for (int i = 0; i < 4; ++i)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				result &= IsNear(m.m[i][j], expected[i][j], tolerance);
+			}
+		}
+		return result;
+	}
+
+	bool IsNear(const Matrix4x4& m, const Matrix4x4& expected, double tolerance)
+	{
+		bool result = true;
+		for (int i = 0; i < 4; ++i)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				result &= IsNear(m.m[i][j], expected.m[i][j], tolerance);
+			}
+		}
+		return result;
+	}
+
+	bool IsNear(const Quaternion& q, const Quaternion& expected, double tolerance)
+	{
+		return IsNear(q.x, expected.x, tolerance) && IsNear(q.y, expected.y, tolerance) && IsNear(q.z, expected.z, tolerance) && IsNear(q.w, expected.w, tolerance);
+	}
+
+	//以下はSIMDを使わないスカラーの参照実装(エンジンのSIMD版と同じ計算順)
+
+	Matrix4x4 MultiplyScalar(const Matrix4x4& lhs, const Matrix4x4& rhs)
+	{
+		Matrix4x4 result{};
+		for (int i = 0; i < 4; ++i)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				result.m[i][j] = lhs.m[i][0] * rhs.m[0][j] + lhs.m[i][1] * rhs.m[1][j] + lhs.m[i][2] * rhs.m[2][j] + lhs.m[i][3] * rhs.m[3][j];
+			}
+		}
+		return result;
+	}
+
+	Quaternion MultiplyScalar(const Quaternion& lhs, const Quaternion& rhs)
+	{
+		return Quaternion(
+			lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y,
+			lhs.w * rhs.y - lhs.x * rhs.z + lhs.y * rhs.w + lhs.z * rhs.x,
+			lhs.w * rhs.z + lhs.x * rhs.y - lhs.y * rhs.x + lhs.z * rhs.w,
+			lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z
+		);
+	}
+
+	Vector3 TransformScalar(const Vector3& v, const Matrix4x4& m)
+	{
+		Vector3 result{};
+		result.x = v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0] + 1.0f * m.m[3][0];
+		result.y = v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1] + 1.0f * m.m[3][1];
+		result.z = v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2] + 1.0f * m.m[3][2];
+		float w = v.x * m.m[0][3] + v.y * m.m[1][3] + v.z * m.m[2][3] + 1.0f * m.m[3][3];
+		result.x /= w;
+		result.y /= w;
+		result.z /= w;
+		return result;
+	}
+
+	Vector3 TransformNormalScalar(const Vector3& v, const Matrix4x4& m)
+	{
+		Vector3 result{};
+		result.x = v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0];
+		result.y = v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1];
+		result.z = v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2];
+		return result;
+	}
+
+	Vector3 RotateVectorScalar(const Vector3& v, const Quaternion& q)
+	{
+		Quaternion rotate = MultiplyScalar(MultiplyScalar(q, Quaternion(v.x, v.y, v.z, 0.0f)), Mathf::Conjugate(q));
+		return { rotate.x,rotate.y,rotate.z };
+	}
+
+	//倍精度のガウス・ジョルダン法で求めた逆行列
+	void InverseReference(const Matrix4x4& m, double (&result)[4][4])
+	{
+		double a[4][8]{};
+		for (int i = 0; i < 4; ++i)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				a[i][j] = m.m[i][j];
+			}
+			a[i][i + 4] = 1.0;
+		}
+		for (int column = 0; column < 4; ++column)
+		{
+			int pivot = column;
+			for (int i = column + 1; i < 4; ++i)
+			{
+				if (std::abs(a[i][column]) > std::abs(a[pivot][column]))
+				{
+					pivot = i;
+				}
+			}
+			for (int j = 0; j < 8; ++j)
+			{
+				std::swap(a[column][j], a[pivot][j]);
+			}
+			double inversePivot = 1.0 / a[column][column];
+			for (int j = 0; j < 8; ++j)
+			{
+				a[column][j] *= inversePivot;
+			}
+			for (int i = 0; i < 4; ++i)
+			{
+				if (i != column)
+				{
+					double factor = a[i][column];
+					for (int j = 0; j < 8; ++j)
+					{
+						a[i][j] -= factor * a[column][j];
+					}
+				}
+			}
+		}
+		for (int i = 0; i < 4; ++i)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				result[i][j] = a[i][j + 4];
+			}
+		}
+	}
+
+	struct RandomInputs
+	{
+		std::vector<Matrix4x4> matrices;
+		std::vector<Matrix4x4> affineMatrices;
+		std::vector<Vector3> scales;
+		std::vector<Quaternion> quaternions;
+		std::vector<Vector3> translations;
+		std::vector<Vector3> vectors;
+	};
+
+	RandomInputs MakeRandomInputs(uint32_t count, uint32_t seed)
+	{
+		std::mt19937 randomEngine(seed);
+		std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> scaleDistribution(0.2f, 5.0f);
+		std::uniform_real_distribution<float> translationDistribution(-100.0f, 100.0f);
+
+		RandomInputs inputs{};
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			//対角成分を大きくして逆行列の誤差が大きくなりすぎないようにする
+			Matrix4x4 m{};
+			for (int row = 0; row < 4; ++row)
+			{
+				for (int column = 0; column < 4; ++column)
+				{
+					m.m[row][column] = distribution(randomEngine) + (row == column ? 3.0f : 0.0f);
+				}
+			}
+			inputs.matrices.push_back(m);
+
+			//拡縮が均等なものとそうでないものを混ぜる
+			Vector3 scale = { scaleDistribution(randomEngine),scaleDistribution(randomEngine),scaleDistribution(randomEngine) };
+			if (i % 3 == 0)
+			{
+				scale = { scale.x,scale.x,scale.x };
+			}
+			Quaternion quaternion = Mathf::Normalize(Quaternion(distribution(randomEngine), distribution(randomEngine), distribution(randomEngine), distribution(randomEngine)));
+			Vector3 translation = { translationDistribution(randomEngine),translationDistribution(randomEngine),translationDistribution(randomEngine) };
+			inputs.scales.push_back(scale);
+			inputs.quaternions.push_back(quaternion);
+			inputs.translations.push_back(translation);
+			inputs.affineMatrices.push_back(Mathf::MakeAffineMatrix(scale, quaternion, translation));
+			inputs.vectors.push_back({ translationDistribution(randomEngine),translationDistribution(randomEngine),translationDistribution(randomEngine) });
+		}
+		return inputs;
+	}
+
+	//constexprで使える比較(std::absはC++20ではconstexprではない)
+	constexpr bool IsNearIdentity(const Matrix4x4& m, float tolerance)
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				float difference = m.m[i][j] - (i == j ? 1.0f : 0.0f);
+				if (difference > tolerance || difference < -tolerance)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+}
+
+//コンパイル時に計算できることを確認する
+static_assert(Vector3{ 1.0f,2.0f,3.0f } + Vector3{ 1.0f,1.0f,1.0f } == Vector3{ 2.0f,3.0f,4.0f });
+static_assert(Vector3{ 1.0f,2.0f,3.0f } / 0.0f == Vector3{ 0.0f,0.0f,0.0f });
+static_assert(Vector2{ 1.0f,2.0f } * 2.0f == Vector2{ 2.0f,4.0f });
+static_assert(Vector4{ 1.0f,2.0f,3.0f,4.0f } - Vector4{ 1.0f,2.0f,3.0f,4.0f } == Vector4{ 0.0f,0.0f,0.0f,0.0f });
+static_assert(Mathf::Dot(Vector3{ 1.0f,2.0f,3.0f }, Vector3{ 4.0f,5.0f,6.0f }) == 32.0f);
+static_assert(Mathf::Cross(Vector3{ 1.0f,0.0f,0.0f }, Vector3{ 0.0f,1.0f,0.0f }) == Vector3{ 0.0f,0.0f,1.0f });
+static_assert(Mathf::Lerp(Vector3{ 0.0f,0.0f,0.0f }, Vector3{ 2.0f,4.0f,6.0f }, 0.5f) == Vector3{ 1.0f,2.0f,3.0f });
+static_assert(Mathf::MakeIdentity4x4() * Mathf::MakeIdentity4x4() == Mathf::MakeIdentity4x4());
+static_assert(Mathf::MakeScaleMatrix(Vector3{ 2.0f,2.0f,2.0f }) * Mathf::MakeTranslateMatrix(Vector3{ 1.0f,2.0f,3.0f }) == Mathf::MakeAffineMatrix(Vector3{ 2.0f,2.0f,2.0f }, Mathf::IdentityQuaternion(), Vector3{ 1.0f,2.0f,3.0f }));
+static_assert(Mathf::Transpose(Mathf::MakeTranslateMatrix(Vector3{ 1.0f,2.0f,3.0f })).m[0][3] == 1.0f);
+static_assert(Mathf::MakeOrthographicMatrix(0.0f, 0.0f, 1280.0f, 720.0f, 0.0f, 100.0f).m[0][0] == 2.0f / 1280.0f);
+static_assert(Mathf::MakeViewportMatrix(0.0f, 0.0f, 1280.0f, 720.0f, 0.0f, 1.0f).m[3][0] == 640.0f);
+static_assert(Quaternion{ 0.0f,0.0f,1.0f,0.0f } * Mathf::Conjugate(Quaternion{ 0.0f,0.0f,1.0f,0.0f }) == Mathf::IdentityQuaternion());
+static_assert(Mathf::MakeRotateMatrix(Quaternion{ 0.0f,0.0f,1.0f,0.0f }).m[0][0] == -1.0f);
+
+//x,y,z軸を入れ替える回転(全ての成分を確かめる)
+static_assert(Mathf::MakeRotateMatrix(Quaternion{ 0.5f,0.5f,0.5f,0.5f }) == Matrix4x4{ { {0.0f,1.0f,0.0f,0.0f},{0.0f,0.0f,1.0f,0.0f},{1.0f,0.0f,0.0f,0.0f},{0.0f,0.0f,0.0f,1.0f} } });
+
+//ビュー行列はカメラのワールド行列の逆行列になる(1つ目は回転行列の成分が0と±1だけなので誤差なく一致する)
+static_assert(Mathf::MakeViewMatrix(Quaternion{ 0.5f,0.5f,0.5f,0.5f }, Vector3{ 1.0f,-2.0f,3.0f }) * Mathf::MakeAffineMatrix(Vector3{ 1.0f,1.0f,1.0f }, Quaternion{ 0.5f,0.5f,0.5f,0.5f }, Vector3{ 1.0f,-2.0f,3.0f }) == Mathf::MakeIdentity4x4());
+static_assert(IsNearIdentity(Mathf::MakeViewMatrix(Quaternion{ 0.1f,0.7f,0.1f,0.7f }, Vector3{ -4.0f,2.5f,10.0f }) * Mathf::MakeAffineMatrix(Vector3{ 1.0f,1.0f,1.0f }, Quaternion{ 0.1f,0.7f,0.1f,0.7f }, Vector3{ -4.0f,2.5f,10.0f }), 1.0e-5f));
+static_assert(IsNearIdentity(Mathf::MakeRotateMatrix(Quaternion{ 0.1f,0.7f,0.1f,0.7f }) * Mathf::Transpose(Mathf::MakeRotateMatrix(Quaternion{ 0.1f,0.7f,0.1f,0.7f })), 1.0e-5f));
+
+TEST_CASE(MathSimdKernelsMatchScalar)
+{
+	//SIMD版はスカラー版と同じ計算順なのでビット単位で一致する
+	RandomInputs inputs = MakeRandomInputs(512, 1);
+	bool isMultiplyMatched = true;
+	bool isTransformMatched = true;
+	bool isQuaternionMatched = true;
+	for (size_t i = 0; i < inputs.matrices.size(); ++i)
+	{
+		const Matrix4x4& m = inputs.matrices[i];
+		const Matrix4x4& affine = inputs.affineMatrices[i];
+		const Quaternion& q = inputs.quaternions[i];
+		const Quaternion& otherQ = inputs.quaternions[(i + 1) % inputs.quaternions.size()];
+		const Vector3& v = inputs.vectors[i];
+
+		isMultiplyMatched &= IsBitwiseEqual(m * affine, MultiplyScalar(m, affine));
+		isMultiplyMatched &= IsBitwiseEqual(affine * m, MultiplyScalar(affine, m));
+		isTransformMatched &= IsBitwiseEqual(Mathf::Transform(v, m), TransformScalar(v, m));
+		isTransformMatched &= IsBitwiseEqual(Mathf::Transform(v, affine), TransformScalar(v, affine));
+		isTransformMatched &= IsBitwiseEqual(Mathf::TransformNormal(v, m), TransformNormalScalar(v, m));
+		isQuaternionMatched &= IsBitwiseEqual(q * otherQ, MultiplyScalar(q, otherQ));
+		isQuaternionMatched &= IsBitwiseEqual(Mathf::RotateVector(v, q), RotateVectorScalar(v, q));
+	}
+	TEST_CHECK(isMultiplyMatched);
+	TEST_CHECK(isTransformMatched);
+	TEST_CHECK(isQuaternionMatched);
+
+	//コンパイル時に計算した場合(スカラー版)とも一致する
+	constexpr Matrix4x4 kLhs = Mathf::MakeAffineMatrix(Vector3{ 1.5f,0.5f,2.0f }, Quaternion(0.1f, 0.7f, -0.3f, 0.64f), Vector3{ 3.0f,-4.0f,5.0f });
+	constexpr Matrix4x4 kRhs = Mathf::MakeViewMatrix(Quaternion(-0.2f, 0.4f, 0.5f, 0.74f), Vector3{ -1.0f,2.0f,8.0f });
+	constexpr Matrix4x4 kProduct = kLhs * kRhs;
+	constexpr Quaternion kQuaternionProduct = Quaternion(0.1f, 0.7f, -0.3f, 0.64f) * Quaternion(-0.2f, 0.4f, 0.5f, 0.74f);
+	Matrix4x4 lhs = kLhs;
+	Quaternion q = Quaternion(0.1f, 0.7f, -0.3f, 0.64f);
+	TEST_CHECK(IsBitwiseEqual(lhs * kRhs, kProduct));
+	TEST_CHECK(IsBitwiseEqual(q * Quaternion(-0.2f, 0.4f, 0.5f, 0.74f), kQuaternionProduct));
+}
+
+TEST_CASE(MathInverseAccuracy)
+{
+	RandomInputs inputs = MakeRandomInputs(512, 2);
+	bool isInverseAccurate = true;
+	bool isAffineAccurate = true;
+	bool isScaleAccurate = true;
+	bool isTransposeMatched = true;
+	for (size_t i = 0; i < inputs.matrices.size(); ++i)
+	{
+		//一般の行列は2x2ブロックで求めるので誤差が少し大きい
+		double expected[4][4]{};
+		InverseReference(inputs.matrices[i], expected);
+		isInverseAccurate &= IsNear(Mathf::Inverse(inputs.matrices[i]), expected, 1.0e-5);
+
+		//アフィン行列は3つの求め方が全て倍精度の結果に近い
+		const Matrix4x4& affine = inputs.affineMatrices[i];
+		InverseReference(affine, expected);
+		isInverseAccurate &= IsNear(Mathf::Inverse(affine), expected, 1.0e-4);
+		Matrix4x4 inverseAffine = Mathf::InverseAffine(affine);
+		isAffineAccurate &= IsNear(inverseAffine, expected, 1.0e-5);
+		isScaleAccurate &= IsNear(Mathf::InverseAffine(affine, inputs.scales[i]), expected, 1.0e-5);
+
+		//4列目は正確に(0,0,0,1)になる
+		isAffineAccurate &= inverseAffine.m[0][3] == 0.0f && inverseAffine.m[1][3] == 0.0f && inverseAffine.m[2][3] == 0.0f && inverseAffine.m[3][3] == 1.0f;
+
+		//逆転置は逆行列を転置したものと同じ
+		isTransposeMatched &= IsBitwiseEqual(Mathf::InverseTransposeAffine(affine), Mathf::Transpose(inverseAffine));
+		isTransposeMatched &= IsBitwiseEqual(Mathf::InverseTransposeAffine(affine, inputs.scales[i]), Mathf::Transpose(Mathf::InverseAffine(affine, inputs.scales[i])));
+	}
+	TEST_CHECK(isInverseAccurate);
+	TEST_CHECK(isAffineAccurate);
+	TEST_CHECK(isScaleAccurate);
+	TEST_CHECK(isTransposeMatched);
+
+	//逆行列を掛けると単位行列に戻る
+	Matrix4x4 affine = inputs.affineMatrices[0];
+	TEST_CHECK(IsNear(affine * Mathf::InverseAffine(affine), Mathf::MakeIdentity4x4(), 1.0e-5));
+	TEST_CHECK(IsNear(inputs.matrices[0] * Mathf::Inverse(inputs.matrices[0]), Mathf::MakeIdentity4x4(), 1.0e-5));
+}
+
+TEST_CASE(MathQuaternionAccuracy)
+{
+	RandomInputs inputs = MakeRandomInputs(512, 3);
+	bool isRotationMatched = true;
+	bool isInterpolationAccurate = true;
+	for (size_t i = 0; i < inputs.quaternions.size(); ++i)
+	{
+		const Quaternion& q0 = inputs.quaternions[i];
+		const Quaternion& q1 = inputs.quaternions[(i + 1) % inputs.quaternions.size()];
+		const Vector3& v = inputs.vectors[i];
+
+		//クォータニオンで回転した結果と回転行列で変換した結果が一致する
+		Vector3 rotated = Mathf::RotateVector(v, q0);
+		Vector3 transformed = Mathf::TransformNormal(v, Mathf::MakeRotateMatrix(q0));
+		isRotationMatched &= IsNear(rotated.x, transformed.x, 1.0e-5) && IsNear(rotated.y, transformed.y, 1.0e-5) && IsNear(rotated.z, transformed.z, 1.0e-5);
+
+		//拡縮*回転*平行移動の積と同じ行列になる
+		Matrix4x4 product = Mathf::MakeScaleMatrix(inputs.scales[i]) * Mathf::MakeRotateMatrix(q0) * Mathf::MakeTranslateMatrix(inputs.translations[i]);
+		isRotationMatched &= IsNear(inputs.affineMatrices[i], product, 1.0e-5);
+
+		//補間の両端は元のクォータニオン(同じ向きを表す符号の反転は許す)、中間はSlerpとNlerpが一致する
+		Quaternion start = Mathf::Slerp(q0, q1, 0.0f);
+		Quaternion end = Mathf::Slerp(q0, q1, 1.0f);
+		isInterpolationAccurate &= IsNear(start, q0, 1.0e-5) || IsNear(start, Quaternion(-q0.x, -q0.y, -q0.z, -q0.w), 1.0e-5);
+		isInterpolationAccurate &= IsNear(end, q1, 1.0e-5);
+		isInterpolationAccurate &= IsNear(Mathf::Slerp(q0, q1, 0.5f), Mathf::Nlerp(q0, q1, 0.5f), 1.0e-5);
+		isInterpolationAccurate &= IsNear(Mathf::Norm(Mathf::Slerp(q0, q1, 0.3f)), 1.0, 1.0e-5);
+		isInterpolationAccurate &= IsNear(Mathf::Norm(Mathf::Nlerp(q0, q1, 0.3f)), 1.0, 1.0e-5);
+	}
+	TEST_CHECK(isRotationMatched);
+	TEST_CHECK(isInterpolationAccurate);
+
+	//オイラー角から作ったクォータニオンはオイラー角から作った行列と同じ回転になる
+	Vector3 rotate = { 0.4f,-1.1f,2.3f };
+	Matrix4x4 eulerMatrix = Mathf::MakeAffineMatrix(Vector3{ 1.0f,1.0f,1.0f }, rotate, Vector3{ 0.0f,0.0f,0.0f });
+	Matrix4x4 axisMatrix = Mathf::MakeRotateXMatrix(rotate.x) * Mathf::MakeRotateYMatrix(rotate.y) * Mathf::MakeRotateZMatrix(rotate.z);
+	TEST_CHECK(IsNear(eulerMatrix, axisMatrix, 1.0e-5));
+	TEST_CHECK(IsNear(Mathf::MakeRotateMatrix(Mathf::MakeRotateQuaternion(rotate)), axisMatrix, 1.0e-5));
+}
+
+TEST_CASE(MathViewMatrixMatchesInverseWorld)
+{
+	//Cameraのオイラー角から作るビュー行列(変更前のInverse(T)*Inverse(R)とアフィン行列の逆行列)とMakeViewMatrixを比べる
+	std::mt19937 randomEngine(7);
+	std::uniform_real_distribution<float> angleDistribution(-3.14159f, 3.14159f);
+	std::uniform_real_distribution<float> translationDistribution(-100.0f, 100.0f);
+	bool isInverseMatched = true;
+	bool isLegacyMatched = true;
+	for (uint32_t i = 0; i < 1000; ++i)
+	{
+		Vector3 rotation = { angleDistribution(randomEngine),angleDistribution(randomEngine),angleDistribution(randomEngine) };
+		Vector3 translation = { translationDistribution(randomEngine),translationDistribution(randomEngine),translationDistribution(randomEngine) };
+		Matrix4x4 viewMatrix = Mathf::MakeViewMatrix(Mathf::MakeRotateQuaternion(rotation), translation);
+
+		Matrix4x4 inverseWorldMatrix = Mathf::InverseAffine(Mathf::MakeAffineMatrix(Vector3{ 1.0f,1.0f,1.0f }, rotation, translation));
+		isInverseMatched &= IsNear(viewMatrix, inverseWorldMatrix, 1.0e-5);
+
+		//一般の逆行列は行列式で割るので誤差が大きい(最大で2e-5程度)
+		Matrix4x4 rotateMatrix = Mathf::MakeRotateXMatrix(rotation.x) * Mathf::MakeRotateYMatrix(rotation.y) * Mathf::MakeRotateZMatrix(rotation.z);
+		Matrix4x4 legacyMatrix = Mathf::Inverse(Mathf::MakeTranslateMatrix(translation)) * Mathf::Inverse(rotateMatrix);
+		isLegacyMatched &= IsNear(viewMatrix, legacyMatrix, 5.0e-5);
+	}
+	TEST_CHECK(isInverseMatched);
+	TEST_CHECK(isLegacyMatched);
+}
+
+TEST_CASE(MathBatchFunctionsMatchSingle)
+{
+	//4の倍数とそうでない数の両方で、1つずつ呼んだ場合とビット単位で一致する
+	const uint32_t kCounts[] = { 0,1,3,4,5,19,64 };
+	for (uint32_t count : kCounts)
+	{
+		RandomInputs inputs = MakeRandomInputs(count, 100 + count);
+		RandomInputs otherInputs = MakeRandomInputs(count, 200 + count);
+		const Matrix4x4 m = Mathf::MakeAffineMatrix(Vector3{ 2.0f,0.5f,1.5f }, Quaternion(0.1f, 0.7f, -0.3f, 0.64f), Vector3{ 3.0f,-4.0f,5.0f });
+		const Matrix4x4 projection = m * Mathf::MakePerspectiveFovMatrix(0.8f, 16.0f / 9.0f, 0.1f, 1000.0f);
+
+		std::vector<Vector3> points(count);
+		std::vector<Vector3> normals(count);
+		std::vector<float> x(count), y(count), z(count);
+		std::vector<float> outputX(count), outputY(count), outputZ(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			x[i] = inputs.vectors[i].x;
+			y[i] = inputs.vectors[i].y;
+			z[i] = inputs.vectors[i].z;
+		}
+		Mathf::TransformPoints(inputs.vectors, projection, points);
+		Mathf::TransformPoints(x, y, z, projection, outputX, outputY, outputZ);
+		Mathf::TransformNormals(inputs.vectors, m, normals);
+
+		std::vector<Matrix4x4> products(count);
+		std::vector<Matrix4x4> pairProducts(count);
+		std::vector<Matrix4x4> affineMatrices(count);
+		Mathf::MultiplyMatrices(inputs.matrices, m, products);
+		Mathf::MultiplyMatrices(inputs.matrices, otherInputs.matrices, pairProducts);
+		Mathf::MakeAffineMatrices(inputs.scales, inputs.quaternions, inputs.translations, affineMatrices);
+
+		//補間はノルムが0になる組み合わせも混ぜる
+		std::vector<Quaternion> q0 = inputs.quaternions;
+		std::vector<Quaternion> q1 = otherInputs.quaternions;
+		if (count > 2)
+		{
+			q0[2] = Quaternion(0.0f, 0.0f, 0.0f, 0.0f);
+			q1[2] = Quaternion(0.0f, 0.0f, 0.0f, 0.0f);
+		}
+		std::vector<Quaternion> slerps(count);
+		std::vector<Quaternion> nlerps(count);
+		Mathf::Slerp(q0, q1, 0.3f, slerps);
+		Mathf::Nlerp(q0, q1, 0.3f, nlerps);
+
+		bool isMatched = true;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			Vector3 point = Mathf::Transform(inputs.vectors[i], projection);
+			isMatched &= IsBitwiseEqual(points[i], point);
+			isMatched &= IsBitwiseEqual(Vector3{ outputX[i],outputY[i],outputZ[i] }, point);
+			isMatched &= IsBitwiseEqual(normals[i], Mathf::TransformNormal(inputs.vectors[i], m));
+			isMatched &= IsBitwiseEqual(products[i], inputs.matrices[i] * m);
+			isMatched &= IsBitwiseEqual(pairProducts[i], inputs.matrices[i] * otherInputs.matrices[i]);
+			isMatched &= IsBitwiseEqual(affineMatrices[i], Mathf::MakeAffineMatrix(inputs.scales[i], inputs.quaternions[i], inputs.translations[i]));
+			isMatched &= IsBitwiseEqual(slerps[i], Mathf::Slerp(q0[i], q1[i], 0.3f));
+			isMatched &= IsBitwiseEqual(nlerps[i], Mathf::Nlerp(q0[i], q1[i], 0.3f));
+		}
+		TEST_CHECK(isMatched);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,351 @@
+#include "TestFramework.h"
+#include "Engine/Components/Particle/ParticleEmitter.h"
+#include "Engine/Components/Particle/ParticleLod.h"
+#include "Engine/Math/MathFunction.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace
+{
+	//同じ乱数の種から同じパーティクルを作る
+	void AddRandomParticles(ParticlePool& pool, uint32_t count, uint32_t seed)
+	{
+		std::mt19937 randomEngine(seed);
+		std::uniform_real_distribution<float> positionDistribution(-10.0f, 10.0f);
+		std::uniform_real_distribution<float> velocityDistribution(-0.5f, 0.5f);
+		std::uniform_real_distribution<float> colorDistribution(0.0f, 1.0f);
+		std::uniform_real_distribution<float> lifeTimeDistribution(0.05f, 2.0f);
+
+		pool.Reserve(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			Vector3 translation = { positionDistribution(randomEngine),positionDistribution(randomEngine),positionDistribution(randomEngine) };
+			Vector3 velocity = { velocityDistribution(randomEngine),velocityDistribution(randomEngine),velocityDistribution(randomEngine) };
+			Vector4 color = { colorDistribution(randomEngine),colorDistribution(randomEngine),colorDistribution(randomEngine),colorDistribution(randomEngine) };
+			Vector3 scale = { colorDistribution(randomEngine) + 0.5f,colorDistribution(randomEngine) + 0.5f,colorDistribution(randomEngine) + 0.5f };
+			pool.Add(translation, { 0.0f,0.0f,0.0f }, { 0.0f,0.0f,0.0f,1.0f }, scale, velocity, color, lifeTimeDistribution(randomEngine));
+		}
+	}
+
+	//浮動小数点の値がビット単位で一致するか調べる
+	template <typename T>
+	bool IsBitwiseEqual(const T& lhs, const T& rhs)
+	{
+		return std::memcmp(&lhs, &rhs, sizeof(T)) == 0;
+	}
+}
+
+TEST_CASE(ParticleSimulateMatchesScalarUpdate)
+{
+	//加速フィールドは半分の範囲、重力フィールドは中心付近で止まるようにする
+	AccelerationField accelerationField = { .acceleration{0.01f,-0.02f,0.005f},.area{{-10.0f,-10.0f,-10.0f},{0.0f,10.0f,10.0f}},.isEnable{true} };
+	GravityField gravityField = { .center{1.0f,2.0f,-1.0f},.area{{-5.0f,-10.0f,-10.0f},{10.0f,5.0f,10.0f}},.strength{0.003f},.stopDistance{1.5f},.isEnable{true} };
+
+	//8の倍数とそうでない数の両方で確認する
+	const uint32_t kCounts[] = { 1,7,8,37,64,203 };
+	for (uint32_t count : kCounts)
+	{
+		ParticlePool simdPool{};
+		ParticlePool scalarPool{};
+		AddRandomParticles(simdPool, count, count);
+		AddRandomParticles(scalarPool, count, count);
+
+		//ちょうど重力の中心にいるパーティクルも混ぜる
+		simdPool.Reserve(count + 1);
+		scalarPool.Reserve(count + 1);
+		simdPool.Add(gravityField.center, { 0.0f,0.0f,0.0f }, { 0.0f,0.0f,0.0f,1.0f }, { 1.0f,1.0f,1.0f }, { 0.1f,0.0f,0.0f }, { 1.0f,1.0f,1.0f,1.0f }, 1.0f);
+		scalarPool.Add(gravityField.center, { 0.0f,0.0f,0.0f }, { 0.0f,0.0f,0.0f,1.0f }, { 1.0f,1.0f,1.0f }, { 0.1f,0.0f,0.0f }, { 1.0f,1.0f,1.0f,1.0f }, 1.0f);
+		TEST_CHECK(simdPool.GetCount() == scalarPool.GetCount());
+
+		//数フレーム進めて毎フレーム比べる
+		for (uint32_t frame = 0; frame < 30; ++frame)
+		{
+			const float kDeltaTime = 1.0f / 60.0f;
+			AABB bounds = simdPool.Simulate(0, simdPool.GetCount(), accelerationField, gravityField, kDeltaTime);
+			for (uint32_t i = 0; i < scalarPool.GetCount(); ++i)
+			{
+				scalarPool.UpdateParticle(i, accelerationField, gravityField, kDeltaTime);
+			}
+
+			bool isMatched = true;
+			AABB expectedBounds = { scalarPool.GetTranslation(0),scalarPool.GetTranslation(0) };
+			for (uint32_t i = 0; i < scalarPool.GetCount(); ++i)
+			{
+				isMatched &= IsBitwiseEqual(simdPool.GetTranslation(i), scalarPool.GetTranslation(i));
+				isMatched &= IsBitwiseEqual(simdPool.GetVelocity(i), scalarPool.GetVelocity(i));
+				isMatched &= IsBitwiseEqual(simdPool.GetColor(i), scalarPool.GetColor(i));
+				isMatched &= simdPool.GetIsDead(i) == scalarPool.GetIsDead(i);
+				Vector3 translation = scalarPool.GetTranslation(i);
+				expectedBounds.min = { (std::min)(expectedBounds.min.x,translation.x),(std::min)(expectedBounds.min.y,translation.y),(std::min)(expectedBounds.min.z,translation.z) };
+				expectedBounds.max = { (std::max)(expectedBounds.max.x,translation.x),(std::max)(expectedBounds.max.y,translation.y),(std::max)(expectedBounds.max.z,translation.z) };
+			}
+			TEST_CHECK(isMatched);
+			TEST_CHECK(IsBitwiseEqual(bounds.min, expectedBounds.min));
+			TEST_CHECK(IsBitwiseEqual(bounds.max, expectedBounds.max));
+
+			//死んだパーティクルの削除も同じ結果になる
+			simdPool.RemoveDeadParticles();
+			scalarPool.RemoveDeadParticles();
+			TEST_CHECK(simdPool.GetCount() == scalarPool.GetCount());
+		}
+	}
+}
+
+TEST_CASE(ParticleSimulateRangesMatchWholeRange)
+{
+	AccelerationField accelerationField = { .acceleration{0.0f,-0.01f,0.0f},.area{{-10.0f,-10.0f,-10.0f},{10.0f,10.0f,10.0f}},.isEnable{true} };
+	GravityField gravityField = { .center{0.0f,0.0f,0.0f},.area{{-10.0f,-10.0f,-10.0f},{10.0f,10.0f,10.0f}},.strength{0.002f},.stopDistance{0.5f},.isEnable{true} };
+
+	//スレッドごとに分けた範囲で更新しても全体を一度に更新した場合と同じになる
+	ParticlePool wholePool{};
+	ParticlePool rangePool{};
+	AddRandomParticles(wholePool, 101, 5);
+	AddRandomParticles(rangePool, 101, 5);
+	const float kDeltaTime = 1.0f / 30.0f;
+	AABB wholeBounds = wholePool.Simulate(0, wholePool.GetCount(), accelerationField, gravityField, kDeltaTime);
+	AABB rangeBounds = { {FLT_MAX,FLT_MAX,FLT_MAX},{-FLT_MAX,-FLT_MAX,-FLT_MAX} };
+	const uint32_t kRanges[][2] = { {0,13},{13,40},{40,41},{41,41},{41,101},{101,200} };
+	for (const uint32_t (&range)[2] : kRanges)
+	{
+		AABB bounds = rangePool.Simulate(range[0], range[1], accelerationField, gravityField, kDeltaTime);
+		rangeBounds.min = { (std::min)(rangeBounds.min.x,bounds.min.x),(std::min)(rangeBounds.min.y,bounds.min.y),(std::min)(rangeBounds.min.z,bounds.min.z) };
+		rangeBounds.max = { (std::max)(rangeBounds.max.x,bounds.max.x),(std::max)(rangeBounds.max.y,bounds.max.y),(std::max)(rangeBounds.max.z,bounds.max.z) };
+	}
+
+	bool isMatched = true;
+	for (uint32_t i = 0; i < wholePool.GetCount(); ++i)
+	{
+		isMatched &= IsBitwiseEqual(wholePool.GetTranslation(i), rangePool.GetTranslation(i));
+		isMatched &= IsBitwiseEqual(wholePool.GetVelocity(i), rangePool.GetVelocity(i));
+		isMatched &= IsBitwiseEqual(wholePool.GetColor(i), rangePool.GetColor(i));
+	}
+	TEST_CHECK(isMatched);
+	TEST_CHECK(IsBitwiseEqual(wholeBounds.min, rangeBounds.min));
+	TEST_CHECK(IsBitwiseEqual(wholeBounds.max, rangeBounds.max));
+}
+
+TEST_CASE(ParticleEmitterSameSeedReproducesBurst)
+{
+	//シード値以外は同じ設定のエミッターを作る
+	auto setupEmitter = [](ParticleEmitter& emitter, uint32_t seed)
+		{
+			emitter.SetSeed(seed);
+			emitter.SetTranslation({ 1.0f,2.0f,3.0f });
+			emitter.SetPopArea({ -2.0f,-1.0f,-2.0f }, { 2.0f,1.0f,2.0f });
+			emitter.SetPopRotation({ -1.0f,-1.0f,-1.0f }, { 1.0f,1.0f,1.0f });
+			emitter.SetPopScale({ 0.5f,0.5f,0.5f }, { 1.5f,1.5f,1.5f });
+			emitter.SetPopColor({ 0.0f,0.0f,0.0f,0.5f }, { 1.0f,1.0f,1.0f,1.0f });
+			emitter.SetPopLifeTime(0.2f, 0.8f);
+			emitter.SetPopCount(50);
+			emitter.SetPopFrequency(0.05f);
+		};
+
+	ParticleEmitter emitter{};
+	ParticleEmitter sameEmitter{};
+	ParticleEmitter otherEmitter{};
+	setupEmitter(emitter, 2024);
+	setupEmitter(sameEmitter, 2024);
+	setupEmitter(otherEmitter, 2025);
+
+	//生成と削除を繰り返しても毎フレーム同じパーティクルになる
+	bool isMatched = true;
+	bool isDifferent = false;
+	for (uint32_t frame = 0; frame < 60; ++frame)
+	{
+		const float kDeltaTime = 1.0f / 60.0f;
+		emitter.Update(kDeltaTime);
+		sameEmitter.Update(kDeltaTime);
+		otherEmitter.Update(kDeltaTime);
+
+		ParticlePool& particles = emitter.GetParticles();
+		ParticlePool& sameParticles = sameEmitter.GetParticles();
+		ParticlePool& otherParticles = otherEmitter.GetParticles();
+		TEST_CHECK(particles.GetCount() == sameParticles.GetCount());
+		for (uint32_t i = 0; i < (std::min)(particles.GetCount(), sameParticles.GetCount()); ++i)
+		{
+			isMatched &= IsBitwiseEqual(particles.GetTranslation(i), sameParticles.GetTranslation(i));
+			isMatched &= IsBitwiseEqual(particles.GetQuaternion(i), sameParticles.GetQuaternion(i));
+			isMatched &= IsBitwiseEqual(particles.GetScale(i), sameParticles.GetScale(i));
+			isMatched &= IsBitwiseEqual(particles.GetVelocity(i), sameParticles.GetVelocity(i));
+			isMatched &= IsBitwiseEqual(particles.GetColor(i), sameParticles.GetColor(i));
+		}
+		for (uint32_t i = 0; i < (std::min)(particles.GetCount(), otherParticles.GetCount()); ++i)
+		{
+			isDifferent |= !IsBitwiseEqual(particles.GetTranslation(i), otherParticles.GetTranslation(i));
+		}
+	}
+	TEST_CHECK(isMatched);
+	TEST_CHECK(isDifferent);
+	TEST_CHECK(emitter.GetParticles().GetCount() > 0);
+
+	//GPUに渡すシード値も同じ順番で作られる
+	ConstBuffDataGPUParticleEmitter emitterData{};
+	ConstBuffDataGPUParticleEmitter sameEmitterData{};
+	for (uint32_t frame = 0; frame < 10; ++frame)
+	{
+		emitter.EmitGPU(1.0f / 60.0f, emitterData);
+		sameEmitter.EmitGPU(1.0f / 60.0f, sameEmitterData);
+		TEST_CHECK(emitterData.seed == sameEmitterData.seed);
+		TEST_CHECK(emitterData.popCount == sameEmitterData.popCount);
+	}
+}
+
+TEST_CASE(ParticleWriteInstancesMatchesPool)
+{
+	//シェーダーのStructuredBufferと同じ56バイトで詰める
+	static_assert(sizeof(ParticleForGPU) == 56);
+
+	ParticlePool pool{};
+	AddRandomParticles(pool, 50, 11);
+
+	//角度を指定したパーティクルはクォータニオンに変換されて書き込まれる
+	pool.Reserve(51);
+	Vector3 rotation = { 0.3f,-1.2f,2.0f };
+	pool.Add({ 1.0f,2.0f,3.0f }, rotation, { 0.0f,0.0f,0.0f,1.0f }, { 2.0f,2.0f,2.0f }, { 0.0f,0.0f,0.0f }, { 1.0f,0.5f,0.25f,1.0f }, 1.0f);
+
+	std::vector<ParticleForGPU> instances(64);
+	uint32_t count = pool.WriteInstances(instances.data(), uint32_t(instances.size()));
+	TEST_CHECK(count == pool.GetCount());
+
+	bool isMatched = true;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		isMatched &= IsBitwiseEqual(instances[i].translation, pool.GetTranslation(i));
+		isMatched &= IsBitwiseEqual(instances[i].scale, pool.GetScale(i));
+		isMatched &= IsBitwiseEqual(instances[i].rotation, pool.GetQuaternion(i));
+		isMatched &= IsBitwiseEqual(instances[i].color, pool.GetColor(i));
+	}
+	TEST_CHECK(isMatched);
+	TEST_CHECK(IsBitwiseEqual(instances[50].rotation, Mathf::MakeRotateQuaternion(rotation)));
+
+	//最大数を超えた分は書き込まない
+	ParticleForGPU sentinel = { .translation{-1.0f,-1.0f,-1.0f} };
+	std::fill(instances.begin(), instances.end(), sentinel);
+	count = pool.WriteInstances(instances.data(), 20);
+	TEST_CHECK(count == 20);
+	TEST_CHECK(IsBitwiseEqual(instances[19].translation, pool.GetTranslation(19)));
+	TEST_CHECK(IsBitwiseEqual(instances[20].translation, sentinel.translation));
+	TEST_CHECK(pool.WriteInstances(instances.data(), 0) == 0);
+}
+
+TEST_CASE(ParticleWriteVisibleInstancesCullsOutsideFrustum)
+{
+	//[-5,5]の立方体を視錐台の代わりにする
+	Frustum frustum = { {
+		{1.0f,0.0f,0.0f,5.0f},{-1.0f,0.0f,0.0f,5.0f},
+		{0.0f,1.0f,0.0f,5.0f},{0.0f,-1.0f,0.0f,5.0f},
+		{0.0f,0.0f,1.0f,5.0f},{0.0f,0.0f,-1.0f,5.0f},
+	} };
+	const float kRadius = 0.5f;
+
+	ParticlePool pool{};
+	AddRandomParticles(pool, 300, 21);
+
+	//半径とスケールの一番大きい成分で判定した結果と比べる
+	std::vector<uint32_t> visibleIndices{};
+	for (uint32_t i = 0; i < pool.GetCount(); ++i)
+	{
+		Vector3 translation = pool.GetTranslation(i);
+		const Vector3& scale = pool.GetScale(i);
+		float radius = kRadius * (std::max)((std::max)(std::abs(scale.x), std::abs(scale.y)), std::abs(scale.z));
+		if (std::abs(translation.x) <= 5.0f + radius && std::abs(translation.y) <= 5.0f + radius && std::abs(translation.z) <= 5.0f + radius)
+		{
+			visibleIndices.push_back(i);
+		}
+	}
+	TEST_CHECK(!visibleIndices.empty());
+	TEST_CHECK(visibleIndices.size() < pool.GetCount());
+
+	//見えるものだけを元の順番で詰める
+	std::vector<ParticleForGPU> instances(pool.GetCount());
+	uint32_t culledCount = 0;
+	uint32_t count = pool.WriteVisibleInstances(instances.data(), uint32_t(instances.size()), frustum, kRadius, culledCount);
+	TEST_CHECK(count == visibleIndices.size());
+	TEST_CHECK(culledCount == pool.GetCount() - count);
+	bool isMatched = count == visibleIndices.size();
+	for (uint32_t i = 0; isMatched && i < count; ++i)
+	{
+		uint32_t index = visibleIndices[i];
+		isMatched &= IsBitwiseEqual(instances[i].translation, pool.GetTranslation(index));
+		isMatched &= IsBitwiseEqual(instances[i].scale, pool.GetScale(index));
+		isMatched &= IsBitwiseEqual(instances[i].rotation, pool.GetQuaternion(index));
+		isMatched &= IsBitwiseEqual(instances[i].color, pool.GetColor(index));
+	}
+	TEST_CHECK(isMatched);
+
+	//最大数で打ち切っても視錐台の外にあった数は全て数える
+	uint32_t maxCount = uint32_t(visibleIndices.size() / 2);
+	uint32_t truncatedCulledCount = 0;
+	TEST_CHECK(pool.WriteVisibleInstances(instances.data(), maxCount, frustum, kRadius, truncatedCulledCount) == maxCount);
+	TEST_CHECK(truncatedCulledCount == culledCount);
+}
+
+TEST_CASE(ParticleLodKeepsBurstEmittersWithinBudget)
+{
+	//1秒ごとに500個生成して0.5秒で消えるエミッター(長いフレームの後の最大数は500*8個になる)
+	auto setupEmitter = [](ParticleEmitter& emitter, uint32_t index)
+		{
+			emitter.SetSeed(index);
+			emitter.SetTranslation({ float(index) * 10.0f,0.0f,10.0f });
+			emitter.SetPriority(int32_t(index));
+			emitter.SetPopLifeTime(0.25f, 0.5f);
+			emitter.SetPopCount(500);
+			emitter.SetPopFrequency(1.0f);
+		};
+	const uint32_t kMaxParticleCount = 2000;
+	const uint32_t kMaxSpawnCountPerFrame = 1 << 16;
+	const float kDeltaTime = 1.0f / 60.0f;
+
+	//ParticleManager::Updateと同じ順番でLODを決めてから進め、エミッターごとの最小の倍率を返す
+	auto runFrames = [&](std::vector<ParticleEmitter>& emitters, uint32_t frameCount, uint32_t& maxLiveCount)
+		{
+			std::vector<float> minLodScales(emitters.size(), 1.0f);
+			std::vector<ParticleLod::EmitterLod> emitterLods;
+			for (uint32_t frame = 0; frame < frameCount; ++frame)
+			{
+				emitterLods.clear();
+				uint32_t particleCount = 0;
+				for (ParticleEmitter& emitter : emitters)
+				{
+					particleCount += emitter.GetParticles().GetCount();
+					emitterLods.push_back(ParticleLod::MakeEmitterLod(&emitter, kDeltaTime, { 0.0f,0.0f,0.0f }, 1.0f));
+				}
+				maxLiveCount = (std::max)(maxLiveCount, particleCount);
+				ParticleLod::AssignLodScales(emitterLods, particleCount, kMaxParticleCount, kMaxSpawnCountPerFrame);
+				for (uint32_t i = 0; i < emitters.size(); ++i)
+				{
+					minLodScales[i] = (std::min)(minLodScales[i], emitters[i].GetLodScale());
+					emitters[i].Update(kDeltaTime);
+				}
+			}
+			return minLodScales;
+		};
+
+	//3つ合わせて1500個なので上限に収まり、最大密度のまま生成する
+	std::vector<ParticleEmitter> emitters(3);
+	for (uint32_t i = 0; i < emitters.size(); ++i)
+	{
+		setupEmitter(emitters[i], i);
+	}
+	TEST_CHECK(emitters[0].ComputeSteadyParticleCount() == 500);
+	TEST_CHECK(emitters[0].ComputeMaxParticleCount() > kMaxParticleCount);
+	uint32_t maxLiveCount = 0;
+	std::vector<float> minLodScales = runFrames(emitters, 240, maxLiveCount);
+	TEST_CHECK(std::all_of(minLodScales.begin(), minLodScales.end(), [](float lodScale) { return lodScale == 1.0f; }));
+	TEST_CHECK(maxLiveCount == 1500);
+
+	//5つでは上限を超えるので優先度が低いエミッターから減らす
+	std::vector<ParticleEmitter> manyEmitters(5);
+	for (uint32_t i = 0; i < manyEmitters.size(); ++i)
+	{
+		setupEmitter(manyEmitters[i], i);
+	}
+	maxLiveCount = 0;
+	minLodScales = runFrames(manyEmitters, 120, maxLiveCount);
+	TEST_CHECK(maxLiveCount <= kMaxParticleCount);
+	TEST_CHECK(minLodScales[4] == 1.0f);
+	TEST_CHECK(minLodScales[0] < 1.0f);
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "TestFramework.h"
+#include "Engine/Utilities/RandomGenerator.h"
+#include <cstring>
+#include <vector>
+
+TEST_CASE(RandomStreamSameSeedRepeats)
+{
+	//シード値が同じなら何度作り直しても同じ系列になる
+	RandomStream stream(12345);
+	RandomStream sameStream{};
+	sameStream.SetSeed(12345);
+	bool isMatched = true;
+	for (uint32_t i = 0; i < 10000; ++i)
+	{
+		isMatched &= stream.NextUInt() == sameStream.NextUInt();
+	}
+	TEST_CHECK(isMatched);
+
+	//実装を変えて系列が変わったら気付けるように最初の値を固定しておく
+	const uint32_t kExpected[] = { 0xDE3FEE85u,0xBAA437D0u,0x6DA600ECu,0xE57A2A24u };
+	stream.SetSeed(12345);
+	for (uint32_t expected : kExpected)
+	{
+		TEST_CHECK(stream.NextUInt() == expected);
+	}
+}
+
+TEST_CASE(RandomStreamDifferentSeedsDiffer)
+{
+	RandomStream stream(1);
+	RandomStream otherStream(2);
+	uint32_t sameCount = 0;
+	for (uint32_t i = 0; i < 1000; ++i)
+	{
+		sameCount += stream.NextUInt() == otherStream.NextUInt() ? 1 : 0;
+	}
+	TEST_CHECK(sameCount < 4);
+
+	//シード値0でも内部状態が全て0にならない
+	RandomStream zeroStream(0);
+	uint32_t value = zeroStream.NextUInt();
+	TEST_CHECK(value != 0 || zeroStream.NextUInt() != 0);
+}
+
+TEST_CASE(RandomStreamFillUniformMatchesNextFloat)
+{
+	//まとめて作った乱数は1つずつ作った場合と同じ値になり、[min,max)に収まる
+	const float kMin = -3.0f;
+	const float kMax = 5.0f;
+	RandomStream stream(99);
+	RandomStream sameStream(99);
+	std::vector<float> values(1001);
+	stream.FillUniform(values.data(), values.size(), kMin, kMax);
+	bool isMatched = true;
+	bool isInRange = true;
+	for (float value : values)
+	{
+		float expected = sameStream.NextFloat(kMin, kMax);
+		isMatched &= std::memcmp(&value, &expected, sizeof(float)) == 0;
+		isInRange &= kMin <= value && value < kMax;
+	}
+	TEST_CHECK(isMatched);
+	TEST_CHECK(isInRange);
+
+	//続きの系列もずれていない
+	TEST_CHECK(stream.NextUInt() == sameStream.NextUInt());
+
+	float unitValue = stream.NextFloat();
+	TEST_CHECK(0.0f <= unitValue && unitValue < 1.0f);
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#include "TestFramework.h"
+#include <cstdio>
+
+namespace Test
+{
+	namespace
+	{
+		uint32_t failureCount = 0;
+	}
+
+	std::vector<TestCase>& GetTestCases()
+	{
+		//他の翻訳単位の静的変数から登録されるので関数内の静的変数にする
+		static std::vector<TestCase> testCases{};
+		return testCases;
+	}
+
+	Registrar::Registrar(const char* name, void (*function)())
+	{
+		GetTestCases().push_back({ name,function });
+	}
+
+	void ReportFailure(const char* file, int32_t line, const char* expression)
+	{
+		std::printf("  %s(%d): TEST_CHECK(%s) failed\n", file, line, expression);
+		++failureCount;
+	}
+
+	uint32_t GetFailureCount()
+	{
+		return failureCount;
+	}
+
+	void ResetFailureCount()
+	{
+		failureCount = 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+//ウィンドウやGPUを使わずにエンジンの処理を確認するための最小限のテストの仕組み
+namespace Test
+{
+	struct TestCase
+	{
+		const char* name;
+		void (*function)();
+	};
+
+	//登録されている全てのテスト
+	std::vector<TestCase>& GetTestCases();
+
+	//静的変数の初期化でテストを登録する
+	struct Registrar
+	{
+		Registrar(const char* name, void (*function)());
+	};
+
+	void ReportFailure(const char* file, int32_t line, const char* expression);
+
+	//実行中のテストで失敗した数
+	uint32_t GetFailureCount();
+
+	void ResetFailureCount();
+}
+
+#define TEST_CASE(name) \
+	static void name(); \
+	static Test::Registrar name##Registrar(#name, name); \
+	static void name()
+
+#define TEST_CHECK(expression) \
+	do \
+	{ \
+		if (!(expression)) \
+		{ \
+			Test::ReportFailure(__FILE__, __LINE__, #expression); \
+		} \
+	} while (false)
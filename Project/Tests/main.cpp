@@ -0,0 +1,36 @@
+#include "TestFramework.h"
+#include <cstdio>
+#include <cstring>
+
+//引数を渡すと名前にその文字列を含むテストだけ実行する
+int main(int argc, char* argv[])
+{
+	const char* filter = argc > 1 ? argv[1] : nullptr;
+	uint32_t passedCount = 0;
+	uint32_t failedCount = 0;
+
+	for (const Test::TestCase& testCase : Test::GetTestCases())
+	{
+		if (filter && std::strstr(testCase.name, filter) == nullptr)
+		{
+			continue;
+		}
+
+		std::printf("[ RUN  ] %s\n", testCase.name);
+		Test::ResetFailureCount();
+		testCase.function();
+		if (Test::GetFailureCount() == 0)
+		{
+			std::printf("[  OK  ] %s\n", testCase.name);
+			++passedCount;
+		}
+		else
+		{
+			std::printf("[FAILED] %s\n", testCase.name);
+			++failedCount;
+		}
+	}
+
+	std::printf("%u passed, %u failed\n", passedCount, failedCount);
+	return failedCount == 0 ? 0 : 1;
+}
\ No newline at end of file